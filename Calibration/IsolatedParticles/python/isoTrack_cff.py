@@ -231,6 +231,7 @@ hltHITCkfTrackCandidatesHE = cms.EDProducer("CkfTrackCandidateMaker",
                                             RedundantSeedCleaner = cms.string( "CachingSeedCleanerBySharedInput" ),
                                             doSeedingRegionRebuilding = cms.bool( False ),
                                             maxNSeeds = cms.uint32( 100000 ),
+                                            seedsPerParallelChunk = cms.uint32( 0 ),
                                             NavigationSchool = cms.string( "SimpleNavigationSchool" ),
                                             TrajectoryBuilder = cms.string( "hltESPCkfTrajectoryBuilder" ),
                                             )
@@ -390,6 +391,7 @@ hltHITCkfTrackCandidatesHB = cms.EDProducer("CkfTrackCandidateMaker",
                                             RedundantSeedCleaner = cms.string( "CachingSeedCleanerBySharedInput" ),
                                             doSeedingRegionRebuilding = cms.bool( False ),
                                             maxNSeeds = cms.uint32( 100000 ),
+                                            seedsPerParallelChunk = cms.uint32( 0 ),
                                             NavigationSchool = cms.string( "SimpleNavigationSchool" ),
                                             TrajectoryBuilder = cms.string( "hltESPCkfTrajectoryBuilder" ),
                                             )
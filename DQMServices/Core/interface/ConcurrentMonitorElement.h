@@ -6,8 +6,11 @@
  * ...
  */
 
+#include <memory>
 #include <mutex>
+#include <vector>
 #include <tbb/spin_mutex.h>
+#include <tbb/task_arena.h>
 
 #include "DQMServices/Core/interface/MonitorElement.h"
 
@@ -15,15 +18,96 @@ class ConcurrentMonitorElement {
 public:
   typedef dqm::impl::MonitorElement MonitorElement;
 
+  // Per-thread copies of a histogram MonitorElement, used when the DQMStore
+  // is configured with shardConcurrentMonitorElements and the module asked for
+  // them with fillPerThread(): each TBB thread fills its own copy, and the
+  // copies are added into the MonitorElement by DQMStore::mergeConcurrentShards
+  // at the end of each lumisection and of the run.
+  class Shards {
+  public:
+    explicit Shards(MonitorElement* me) : me_(me) {}
+
+    void request() { requested_ = true; }
+    bool requested() const { return requested_; }
+    MonitorElement const* me() const { return me_; }
+
+    // create the copies; called by the DQMStore once the booking transaction
+    // is over, so that they inherit the titles, labels and options set in it
+    void book(unsigned int threads) {
+      if (me_->kind() < MonitorElement::Kind::TH1F)
+        return;
+      shards_.reserve(threads);
+      for (unsigned int i = 0; i < threads; ++i) {
+        shards_.emplace_back(std::make_unique<Shard>(*me_));
+        shards_.back()->me.Reset();
+      }
+    }
+
+    template <typename... Args>
+    void fill(Args&&... args) {
+      int index = tbb::this_task_arena::current_thread_index();
+      if (index >= 0 and static_cast<unsigned int>(index) < shards_.size()) {
+        // only taken by the merge otherwise, so this is not contended
+        Shard& shard = *shards_[index];
+        std::lock_guard<tbb::spin_mutex> guard(shard.lock);
+        shard.me.Fill(std::forward<Args>(args)...);
+      } else {
+        std::lock_guard<tbb::spin_mutex> guard(lock_);
+        me_->Fill(std::forward<Args>(args)...);
+      }
+    }
+
+    // add the copies into the MonitorElement and clear them; can run
+    // concurrently with fill()
+    void merge() {
+      bool filled = false;
+      for (auto& shard : shards_) {
+        std::lock_guard<tbb::spin_mutex> shardGuard(shard->lock);
+        TH1* h = shard->me.getTH1();
+        if (h->GetEntries() == 0)
+          continue;
+        {
+          std::lock_guard<tbb::spin_mutex> guard(lock_);
+          me_->getTH1()->Add(h);
+        }
+        shard->me.Reset();
+        filled = true;
+      }
+      if (filled) {
+        std::lock_guard<tbb::spin_mutex> guard(lock_);
+        me_->update();
+      }
+    }
+
+    // protects the MonitorElement itself
+    tbb::spin_mutex& lock() const { return lock_; }
+
+  private:
+    struct Shard {
+      explicit Shard(MonitorElement const& me) : me(me) {}
+      tbb::spin_mutex lock;
+      MonitorElement me;
+    };
+
+    MonitorElement* me_;
+    mutable tbb::spin_mutex lock_;
+    bool requested_ = false;
+    std::vector<std::unique_ptr<Shard>> shards_;
+  };
+
 private:
   mutable MonitorElement* me_;
   mutable tbb::spin_mutex lock_;
+  std::shared_ptr<Shards> shards_;
 
 public:
   ConcurrentMonitorElement(void) : me_(nullptr) {}
 
   explicit ConcurrentMonitorElement(MonitorElement* me) : me_(me) {}
 
+  ConcurrentMonitorElement(MonitorElement* me, std::shared_ptr<Shards> shards)
+      : me_(me), shards_(std::move(shards)) {}
+
   // non-copiable
   ConcurrentMonitorElement(ConcurrentMonitorElement const&) = delete;
 
@@ -32,6 +116,7 @@ public:
     std::lock_guard<tbb::spin_mutex> guard(other.lock_);
     me_ = other.me_;
     other.me_ = nullptr;
+    shards_ = std::move(other.shards_);
   }
 
   // not copy-assignable
@@ -45,6 +130,7 @@ public:
     std::lock_guard<tbb::spin_mutex> others(other.lock_, std::adopt_lock);
     me_ = other.me_;
     other.me_ = nullptr;
+    shards_ = std::move(other.shards_);
     return *this;
   }
 
@@ -54,20 +140,36 @@ public:
   // expose as a const method to mean that it is concurrent-safe
   template <typename... Args>
   void fill(Args&&... args) const {
+    if (shards_) {
+      shards_->fill(std::forward<Args>(args)...);
+      return;
+    }
     std::lock_guard<tbb::spin_mutex> guard(lock_);
     me_->Fill(std::forward<Args>(args)...);
   }
 
   // expose as a const method to mean that it is concurrent-safe
   void shiftFillLast(double y, double ye = 0., int32_t xscale = 1) const {
-    std::lock_guard<tbb::spin_mutex> guard(lock_);
+    std::lock_guard<tbb::spin_mutex> guard(shards_ ? shards_->lock() : lock_);
     me_->ShiftFillLast(y, ye, xscale);
   }
 
+  // Fill per-thread copies of this histogram instead of taking a lock for each
+  // fill, if the DQMStore is configured with shardConcurrentMonitorElements.
+  // This costs one copy of the histogram per thread, so it is meant for the
+  // most frequently filled histograms of a module. Per-lumisection
+  // MonitorElements are always filled directly. Can only be called when the
+  // MonitorElement is being booked.
+  void fillPerThread() {
+    if (shards_)
+      shards_->request();
+  }
+
   // reset the internal pointer
   void reset() {
     std::lock_guard<tbb::spin_mutex> guard(lock_);
     me_ = nullptr;
+    shards_.reset();
   }
 
   operator bool() const {
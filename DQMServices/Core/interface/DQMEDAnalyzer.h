@@ -12,6 +12,9 @@
 /**
  * The standard DQM module base. For now, this is the same as DQMOneLumiEDAnalyzer,
  * but they can (and will) diverge in the future.
+ * As a one module it sees one event at a time and fills plain MonitorElements,
+ * so the per-thread filling of the DQMStore (shardConcurrentMonitorElements)
+ * only applies to DQMGlobalEDAnalyzer.
  */
 class DQMEDAnalyzer : public edm::one::EDProducer<edm::EndRunProducer,
                                                   edm::one::WatchRuns,
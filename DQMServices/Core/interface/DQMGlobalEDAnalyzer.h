@@ -39,12 +39,17 @@ std::shared_ptr<H> DQMGlobalEDAnalyzer<H, Args...>::globalBeginRun(edm::Run cons
         b.cd();
         bookHistograms(b, run, setup, *h);
       },
-      run.run());
+      run.run(),
+      true);
   return h;
 }
 
 template <typename H, typename... Args>
-void DQMGlobalEDAnalyzer<H, Args...>::globalEndRun(edm::Run const&, edm::EventSetup const&) const {}
+void DQMGlobalEDAnalyzer<H, Args...>::globalEndRun(edm::Run const& run, edm::EventSetup const&) const {
+  // all the events of the run have been processed, so the per-thread copies
+  // of the ConcurrentMonitorElements (if any) can be merged
+  edm::Service<DQMStore>()->mergeConcurrentShards(run.run());
+}
 
 template <typename H, typename... Args>
 void DQMGlobalEDAnalyzer<H, Args...>::analyze(edm::StreamID,
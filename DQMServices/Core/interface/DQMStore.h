@@ -355,9 +355,15 @@ namespace dqm::impl {
       ConcurrentBooker& operator=(ConcurrentBooker&&) = delete;
 
     private:
-      explicit ConcurrentBooker(DQMStore* store) noexcept : IBooker{store} {}
+      explicit ConcurrentBooker(DQMStore* store) noexcept : IBooker{store}, store_{store} {}
 
       ~ConcurrentBooker() = default;
+
+      // wrap a newly booked MonitorElement, with per-thread copies if enabled
+      ConcurrentMonitorElement concurrentME(MonitorElement* me);
+
+      // IBooker::owner_ is private
+      DQMStore* store_;
     };
 
     class IGetter {
@@ -430,16 +436,36 @@ namespace dqm::impl {
     }
 
     // Similar function used to book "global" histograms via the
-    // ConcurrentMonitorElement interface.
+    // ConcurrentMonitorElement interface. If canShard is set, the caller
+    // guarantees to call mergeConcurrentShards at the end of the run, after
+    // the last fill, so the MonitorElements that ask for it with
+    // ConcurrentMonitorElement::fillPerThread may be filled per-thread.
     template <typename iFunc>
-    void bookConcurrentTransaction(iFunc f, uint32_t run) {
+    void bookConcurrentTransaction(iFunc f, uint32_t run, bool canShard = false) {
       std::lock_guard<std::mutex> guard(book_mutex_);
       /* Set the run_ member only if enableMultiThread is enabled */
       if (enableMultiThread_) {
         run_ = run;
       }
+      canShard_ = canShard;
       ConcurrentBooker booker(this);
       f(booker);
+      canShard_ = false;
+
+      /* The per-thread copies are made only once the booking is complete, so
+         that they pick up the titles, labels, options and flags set by the
+         module. Only the MonitorElements the module asked for get them, and
+         not the per-lumisection ones, which are reset at each lumisection. */
+      if (not pendingShards_.empty()) {
+        unsigned int threads = tbb::this_task_arena::max_concurrency();
+        for (auto& pending : pendingShards_) {
+          if (not pending->requested() or LSbasedMode_ or pending->me()->getLumiFlag())
+            continue;
+          pending->book(threads);
+          concurrentShards_[run].push_back(std::move(pending));
+        }
+        pendingShards_.clear();
+      }
 
       /* Reset the run_ member only if enableMultiThread is enabled */
       if (enableMultiThread_) {
@@ -447,6 +473,13 @@ namespace dqm::impl {
       }
     }
 
+    // Add the per-thread copies of the ConcurrentMonitorElements booked for
+    // the given run into the corresponding MonitorElements. This is done at the
+    // end of each lumisection, so that the MonitorElements saved or sent during
+    // the run are up to date, and must be done with endOfRun set once all the
+    // events of the run have been processed.
+    void mergeConcurrentShards(uint32_t run, bool endOfRun = true);
+
     // Signature needed in the harvesting where the booking is done in
     // the endJob. No handles to the run there. Two arguments ensure the
     // capability of booking and getting. The method relies on the
@@ -730,6 +763,7 @@ namespace dqm::impl {
     void reset();
     void forceReset();
     void postGlobalBeginLumi(const edm::GlobalContext&);
+    void preGlobalEndLumi(const edm::GlobalContext&);
 
     bool extract(TObject* obj, std::string const& dir, bool overwrite, bool collateHistograms);
     TObject* extractNextObject(TBufferFile&) const;
@@ -810,6 +844,9 @@ namespace dqm::impl {
     bool enableMultiThread_{false};
     bool LSbasedMode_;
     bool forceResetOnBeginLumi_{false};
+    bool shardConcurrentMEs_{false};
+    // set to true in the transaction if the caller merges the per-thread copies.
+    bool canShard_{false};
     std::string readSelectedDirectory_{};
     uint32_t run_{};
     uint32_t moduleId_{};
@@ -829,6 +866,11 @@ namespace dqm::impl {
 
     std::mutex book_mutex_;
 
+    // per-thread copies of the ConcurrentMonitorElements, pending the end of
+    // the current booking transaction, and waiting to be merged for each run
+    std::vector<std::shared_ptr<ConcurrentMonitorElement::Shards>> pendingShards_;
+    std::map<uint32_t, std::vector<std::shared_ptr<ConcurrentMonitorElement::Shards>>> concurrentShards_;
+
     friend DQMService;
     friend DQMNet;
     friend DQMArchiver;
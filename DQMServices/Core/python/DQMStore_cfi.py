@@ -14,4 +14,7 @@ DQMStore = cms.Service("DQMStore",
     # similar to LSBasedMode but for offline. Explicitly sets LumiFLag on all
     # MEs/modules that allow it (canSaveByLumi)
     saveByLumi = cms.untracked.bool(False),
+    # fill the histograms booked by DQMGlobalEDAnalyzers that ask for it with
+    # fillPerThread() in per-thread copies, merged at the end of each lumisection
+    shardConcurrentMonitorElements = cms.untracked.bool(False),
 )
@@ -463,23 +463,23 @@ namespace dqm::impl {
   // ConcurrentBooker methods
   ConcurrentMonitorElement DQMStore::ConcurrentBooker::bookInt(TString const& name) {
     MonitorElement* me = IBooker::bookInt(name);
-    return ConcurrentMonitorElement(me);
+    return concurrentME(me);
   }
 
   ConcurrentMonitorElement DQMStore::ConcurrentBooker::bookFloat(TString const& name) {
     MonitorElement* me = IBooker::bookFloat(name);
-    return ConcurrentMonitorElement(me);
+    return concurrentME(me);
   }
 
   ConcurrentMonitorElement DQMStore::ConcurrentBooker::bookString(TString const& name, TString const& value) {
     MonitorElement* me = IBooker::bookString(name, value);
-    return ConcurrentMonitorElement(me);
+    return concurrentME(me);
   }
 
   ConcurrentMonitorElement DQMStore::ConcurrentBooker::book1D(
       TString const& name, TString const& title, int const nchX, double const lowX, double const highX) {
     MonitorElement* me = IBooker::book1D(name, title, nchX, lowX, highX);
-    return ConcurrentMonitorElement(me);
+    return concurrentME(me);
   }
 
   ConcurrentMonitorElement DQMStore::ConcurrentBooker::book1D(TString const& name,
@@ -487,34 +487,34 @@ namespace dqm::impl {
                                                               int nchX,
                                                               float const* xbinsize) {
     MonitorElement* me = IBooker::book1D(name, title, nchX, xbinsize);
-    return ConcurrentMonitorElement(me);
+    return concurrentME(me);
   };
 
   ConcurrentMonitorElement DQMStore::ConcurrentBooker::book1D(TString const& name, TH1F* object) {
     MonitorElement* me = IBooker::book1D(name, object);
-    return ConcurrentMonitorElement(me);
+    return concurrentME(me);
   }
 
   ConcurrentMonitorElement DQMStore::ConcurrentBooker::book1S(
       TString const& name, TString const& title, int nchX, double lowX, double highX) {
     MonitorElement* me = IBooker::book1S(name, title, nchX, lowX, highX);
-    return ConcurrentMonitorElement(me);
+    return concurrentME(me);
   }
 
   ConcurrentMonitorElement DQMStore::ConcurrentBooker::book1S(TString const& name, TH1S* object) {
     MonitorElement* me = IBooker::book1S(name, object);
-    return ConcurrentMonitorElement(me);
+    return concurrentME(me);
   }
 
   ConcurrentMonitorElement DQMStore::ConcurrentBooker::book1DD(
       TString const& name, TString const& title, int nchX, double lowX, double highX) {
     MonitorElement* me = IBooker::book1DD(name, title, nchX, lowX, highX);
-    return ConcurrentMonitorElement(me);
+    return concurrentME(me);
   }
 
   ConcurrentMonitorElement DQMStore::ConcurrentBooker::book1DD(TString const& name, TH1D* object) {
     MonitorElement* me = IBooker::book1DD(name, object);
-    return ConcurrentMonitorElement(me);
+    return concurrentME(me);
   }
 
   ConcurrentMonitorElement DQMStore::ConcurrentBooker::book2D(TString const& name,
@@ -526,18 +526,18 @@ namespace dqm::impl {
                                                               double lowY,
                                                               double highY) {
     MonitorElement* me = IBooker::book2D(name, title, nchX, lowX, highX, nchY, lowY, highY);
-    return ConcurrentMonitorElement(me);
+    return concurrentME(me);
   }
 
   ConcurrentMonitorElement DQMStore::ConcurrentBooker::book2D(
       TString const& name, TString const& title, int nchX, float const* xbinsize, int nchY, float const* ybinsize) {
     MonitorElement* me = IBooker::book2D(name, title, nchX, xbinsize, nchY, ybinsize);
-    return ConcurrentMonitorElement(me);
+    return concurrentME(me);
   }
 
   ConcurrentMonitorElement DQMStore::ConcurrentBooker::book2D(TString const& name, TH2F* object) {
     MonitorElement* me = IBooker::book2D(name, object);
-    return ConcurrentMonitorElement(me);
+    return concurrentME(me);
   }
 
   ConcurrentMonitorElement DQMStore::ConcurrentBooker::book2S(TString const& name,
@@ -549,18 +549,18 @@ namespace dqm::impl {
                                                               double lowY,
                                                               double highY) {
     MonitorElement* me = IBooker::book2S(name, title, nchX, lowX, highX, nchY, lowY, highY);
-    return ConcurrentMonitorElement(me);
+    return concurrentME(me);
   }
 
   ConcurrentMonitorElement DQMStore::ConcurrentBooker::book2S(
       TString const& name, TString const& title, int nchX, float const* xbinsize, int nchY, float const* ybinsize) {
     MonitorElement* me = IBooker::book2S(name, title, nchX, xbinsize, nchY, ybinsize);
-    return ConcurrentMonitorElement(me);
+    return concurrentME(me);
   }
 
   ConcurrentMonitorElement DQMStore::ConcurrentBooker::book2S(TString const& name, TH2S* object) {
     MonitorElement* me = IBooker::book2S(name, object);
-    return ConcurrentMonitorElement(me);
+    return concurrentME(me);
   }
 
   ConcurrentMonitorElement DQMStore::ConcurrentBooker::book2DD(TString const& name,
@@ -572,12 +572,12 @@ namespace dqm::impl {
                                                                double lowY,
                                                                double highY) {
     MonitorElement* me = IBooker::book2DD(name, title, nchX, lowX, highX, nchY, lowY, highY);
-    return ConcurrentMonitorElement(me);
+    return concurrentME(me);
   }
 
   ConcurrentMonitorElement DQMStore::ConcurrentBooker::book2DD(TString const& name, TH2D* object) {
     MonitorElement* me = IBooker::book2DD(name, object);
-    return ConcurrentMonitorElement(me);
+    return concurrentME(me);
   }
 
   ConcurrentMonitorElement DQMStore::ConcurrentBooker::book3D(TString const& name,
@@ -592,12 +592,12 @@ namespace dqm::impl {
                                                               double lowZ,
                                                               double highZ) {
     MonitorElement* me = IBooker::book3D(name, title, nchX, lowX, highX, nchY, lowY, highY, nchZ, lowZ, highZ);
-    return ConcurrentMonitorElement(me);
+    return concurrentME(me);
   }
 
   ConcurrentMonitorElement DQMStore::ConcurrentBooker::book3D(TString const& name, TH3F* object) {
     MonitorElement* me = IBooker::book3D(name, object);
-    return ConcurrentMonitorElement(me);
+    return concurrentME(me);
   }
 
   ConcurrentMonitorElement DQMStore::ConcurrentBooker::bookProfile(TString const& name,
@@ -610,7 +610,7 @@ namespace dqm::impl {
                                                                    double highY,
                                                                    char const* option) {
     MonitorElement* me = IBooker::bookProfile(name, title, nchX, lowX, highX, nchY, lowY, highY, option);
-    return ConcurrentMonitorElement(me);
+    return concurrentME(me);
   }
 
   ConcurrentMonitorElement DQMStore::ConcurrentBooker::bookProfile(TString const& name,
@@ -622,7 +622,7 @@ namespace dqm::impl {
                                                                    double highY,
                                                                    char const* option) {
     MonitorElement* me = IBooker::bookProfile(name, title, nchX, (double)lowX, highX, lowY, highY, option);
-    return ConcurrentMonitorElement(me);
+    return concurrentME(me);
   }
 
   ConcurrentMonitorElement DQMStore::ConcurrentBooker::bookProfile(TString const& name,
@@ -634,7 +634,7 @@ namespace dqm::impl {
                                                                    double highY,
                                                                    char const* option) {
     MonitorElement* me = IBooker::bookProfile(name, title, nchX, xbinsize, nchY, lowY, highY, option);
-    return ConcurrentMonitorElement(me);
+    return concurrentME(me);
   }
 
   ConcurrentMonitorElement DQMStore::ConcurrentBooker::bookProfile(TString const& name,
@@ -645,12 +645,12 @@ namespace dqm::impl {
                                                                    double highY,
                                                                    char const* option) {
     MonitorElement* me = IBooker::bookProfile(name, title, nchX, xbinsize, lowY, highY, option);
-    return ConcurrentMonitorElement(me);
+    return concurrentME(me);
   }
 
   ConcurrentMonitorElement DQMStore::ConcurrentBooker::bookProfile(TString const& name, TProfile* object) {
     MonitorElement* me = IBooker::bookProfile(name, object);
-    return ConcurrentMonitorElement(me);
+    return concurrentME(me);
   }
 
   ConcurrentMonitorElement DQMStore::ConcurrentBooker::bookProfile2D(TString const& name,
@@ -665,7 +665,7 @@ namespace dqm::impl {
                                                                      double highZ,
                                                                      char const* option) {
     MonitorElement* me = IBooker::bookProfile2D(name, title, nchX, lowX, highX, nchY, lowY, highY, lowZ, highZ, option);
-    return ConcurrentMonitorElement(me);
+    return concurrentME(me);
   }
 
   ConcurrentMonitorElement DQMStore::ConcurrentBooker::bookProfile2D(TString const& name,
@@ -682,7 +682,26 @@ namespace dqm::impl {
                                                                      char const* option) {
     MonitorElement* me =
         IBooker::bookProfile2D(name, title, nchX, lowX, highX, nchY, lowY, highY, nchZ, lowZ, highZ, option);
-    return ConcurrentMonitorElement(me);
+    return concurrentME(me);
+  }
+
+  ConcurrentMonitorElement DQMStore::ConcurrentBooker::concurrentME(MonitorElement* me) {
+    if (not store_->shardConcurrentMEs_ or not store_->canShard_ or me->kind() < MonitorElement::Kind::TH1F)
+      return ConcurrentMonitorElement(me);
+    auto shards = std::make_shared<ConcurrentMonitorElement::Shards>(me);
+    store_->pendingShards_.push_back(shards);
+    return ConcurrentMonitorElement(me, std::move(shards));
+  }
+
+  void DQMStore::mergeConcurrentShards(uint32_t run, bool endOfRun) {
+    std::lock_guard<std::mutex> guard(book_mutex_);
+    auto found = concurrentShards_.find(run);
+    if (found == concurrentShards_.end())
+      return;
+    for (auto& shards : found->second)
+      shards->merge();
+    if (endOfRun)
+      concurrentShards_.erase(found);
   }
 
   //////////////////////////////////////////////////////////////////////
@@ -702,6 +721,7 @@ namespace dqm::impl {
 #endif
     }
     ar.watchPostGlobalBeginLumi(this, &DQMStore::postGlobalBeginLumi);
+    ar.watchPreGlobalEndLumi(this, &DQMStore::preGlobalEndLumi);
   }
 
   DQMStore::DQMStore(edm::ParameterSet const& pset) { initializeFrom(pset); }
@@ -735,6 +755,10 @@ namespace dqm::impl {
     if (enableMultiThread_)
       std::cout << "DQMStore: MultiThread option is enabled\n";
 
+    shardConcurrentMEs_ = pset.getUntrackedParameter<bool>("shardConcurrentMonitorElements", false);
+    if (shardConcurrentMEs_)
+      std::cout << "DQMStore: per-thread ConcurrentMonitorElement filling is enabled\n";
+
     LSbasedMode_ = pset.getUntrackedParameter<bool>("LSbasedMode", false);
     if (LSbasedMode_)
       std::cout << "DQMStore: LSbasedMode option is enabled\n";
@@ -1967,6 +1991,13 @@ namespace dqm::impl {
     }
   }
 
+  void DQMStore::preGlobalEndLumi(edm::GlobalContext const& gc) {
+    // bring the MonitorElements filled per-thread up to date before the
+    // modules save or send them at the end of the lumisection
+    if (shardConcurrentMEs_)
+      mergeConcurrentShards(gc.luminosityBlockID().run(), false);
+  }
+
   //////////////////////////////////////////////////////////////////////
   //////////////////////////////////////////////////////////////////////
   //////////////////////////////////////////////////////////////////////
@@ -0,0 +1,81 @@
+#include <iostream>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include "DQMServices/Core/interface/DQMStore.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+/*
+ * Test case for the per-thread filling of the ConcurrentMonitorElements:
+ * the histograms filled in parallel and merged must have the same contents
+ * as the ones filled serially, also when merged in the middle of the run.
+ */
+using namespace dqm::impl;
+
+namespace {
+  bool sameContents(MonitorElement* me, MonitorElement* ref) {
+    if (me->getEntries() != ref->getEntries()) {
+      std::cout << me->getName() << ": " << me->getEntries() << " entries, expected " << ref->getEntries()
+                << std::endl;
+      return false;
+    }
+    for (int bin = 0; bin <= me->getNbinsX() + 1; ++bin) {
+      if (me->getBinContent(bin) != ref->getBinContent(bin)) {
+        std::cout << me->getName() << ": bin " << bin << " has " << me->getBinContent(bin) << ", expected "
+                  << ref->getBinContent(bin) << std::endl;
+        return false;
+      }
+    }
+    return true;
+  }
+}  // namespace
+
+int main(int argc, char** argv) {
+  const uint32_t run = 1;
+  const unsigned int nValues = 100000;
+
+  edm::ParameterSet pset;
+  pset.addUntrackedParameter<bool>("shardConcurrentMonitorElements", true);
+  DQMStore store(pset);
+
+  ConcurrentMonitorElement sharded, plain;
+  store.bookConcurrentTransaction(
+      [&](DQMStore::ConcurrentBooker& booker) {
+        booker.setCurrentFolder("Test");
+        sharded = booker.book1D("sharded", "sharded", 100, 0., 100.);
+        sharded.fillPerThread();
+        plain = booker.book1D("plain", "plain", 100, 0., 100.);
+      },
+      run,
+      true);
+  MonitorElement* reference = store.book1D("reference", "reference", 100, 0., 100.);
+
+  auto fill = [&](unsigned int begin, unsigned int end) {
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(begin, end), [&](tbb::blocked_range<unsigned int> const& range) {
+      for (unsigned int i = range.begin(); i != range.end(); ++i) {
+        sharded.fill(i % 101);
+        plain.fill(i % 101);
+      }
+    });
+    for (unsigned int i = begin; i != end; ++i)
+      reference->Fill(i % 101);
+  };
+
+  bool ok = true;
+
+  // merged at the end of a lumisection
+  fill(0, nValues / 2);
+  store.mergeConcurrentShards(run, false);
+  ok &= sameContents(store.get("Test/sharded"), reference);
+  ok &= sameContents(store.get("Test/plain"), reference);
+
+  // merged at the end of the run
+  fill(nValues / 2, nValues);
+  store.mergeConcurrentShards(run);
+  ok &= sameContents(store.get("Test/sharded"), reference);
+  ok &= sameContents(store.get("Test/plain"), reference);
+
+  std::cout << (ok ? "per-thread filling OK" : "per-thread filling FAILED") << std::endl;
+  return ok ? 0 : 1;
+}
@@ -21,6 +21,7 @@
 
 // system include files
 #include <atomic>
+#include <exception>
 
 // user include files
 #include "FWCore/Utilities/interface/thread_safety_macros.h"
@@ -45,6 +46,9 @@ namespace edm {
       // ---------- const member functions ---------------------
       bool cacheIsValid() const { return cacheIsValid_.load(std::memory_order_acquire); }
 
+      ///true if the data has been requested in any of the IOVs this Proxy was used for
+      bool requestedInAnyIOV() const { return requestedInAnyIOV_.load(std::memory_order_acquire); }
+
       void doGet(EventSetupRecordImpl const&,
                  DataKey const&,
                  bool iTransiently,
@@ -56,6 +60,12 @@ namespace edm {
                       ActivityRegistry const*,
                       EventSetupImpl const*) const;
 
+      /**makes the data ahead of the first request of the IOV, with the same transient access as
+          the earlier requests. An exception thrown while making it is kept and rethrown by the
+          next request, so the data is not made a second time.
+          */
+      void prefetch(EventSetupRecordImpl const&, DataKey const&, ActivityRegistry const*, EventSetupImpl const*) const;
+
       ///returns the description of the DataProxyProvider which owns this Proxy
       ComponentDescription const* providerDescription() const { return description_; }
 
@@ -95,10 +105,20 @@ namespace edm {
       void clearCacheIsValid();
 
     private:
+      void const* getOrPrefetch(EventSetupRecordImpl const&,
+                                DataKey const&,
+                                bool iTransiently,
+                                ActivityRegistry const*,
+                                EventSetupImpl const*,
+                                bool iPrefetching) const;
+
       // ---------- member data --------------------------------
       ComponentDescription const* description_;
       CMS_THREAD_SAFE mutable void const* cache_;  //protected by a global mutex
       mutable std::atomic<bool> cacheIsValid_;
+      mutable std::atomic<bool> requestedInAnyIOV_;
+      mutable std::atomic<bool> nonTransientAccessRequestedInAnyIOV_;
+      CMS_THREAD_SAFE mutable std::exception_ptr prefetchException_;  //protected by a global mutex
 
       // While implementing the set of code changes that enabled support
       // for concurrent IOVs, I have gone to some effort to maintain
@@ -54,6 +54,7 @@ class testEvent;
 namespace edm {
 
   class BranchDescription;
+  class EventArena;
   class ModuleCallingContext;
   class TriggerResultsByName;
   class TriggerResults;
@@ -94,6 +95,10 @@ namespace edm {
     ///\return The id for the particular Stream processing the Event
     StreamID streamID() const { return streamID_; }
 
+    ///Memory which is released all at once after this Event has been processed.
+    /// Use it with EventArenaAllocator for transient data whose lifetime ends with the Event.
+    EventArena& arena() const;
+
     LuminosityBlock const& getLuminosityBlock() const { return *luminosityBlock_; }
 
     Run const& getRun() const;
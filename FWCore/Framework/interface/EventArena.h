@@ -0,0 +1,116 @@
+#ifndef FWCore_Framework_EventArena_h
+#define FWCore_Framework_EventArena_h
+// -*- C++ -*-
+//
+// Package:     FWCore/Framework
+// Class  :     edm::EventArena
+//
+/**\class edm::EventArena
+
+ Description: Monotonic memory arena whose contents live as long as the
+    Event currently held by an EventPrincipal.
+
+ Usage:
+    Each EventPrincipal owns one EventArena. Modules obtain it through
+    Event::arena() and allocate from it either directly or through
+    EventArenaAllocator<T>, e.g.
+
+      std::vector<Hit, edm::EventArenaAllocator<Hit>> hits{edm::EventArenaAllocator<Hit>(iEvent.arena())};
+
+    Individual deallocations are no-ops. All memory is released in one shot
+    when the EventPrincipal is cleared at the end of the Event, after all
+    products of that Event have been destroyed. The underlying blocks are kept
+    and reused for the next Event processed by the same EventPrincipal, so a
+    stream reaches a steady state without returning to malloc.
+
+    Anything allocated from the arena must therefore not outlive the Event.
+    Persistent product types should not use the allocator since ROOT I/O
+    does not know about it; it is meant for transient products and for
+    scratch memory used while producing.
+
+    allocate() may be called concurrently from modules running on different
+    threads for the same Event. clear() must only be called when no module
+    is running for the Event.
+*/
+//
+// Created:  Oct 2026
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace edm {
+
+  class EventArena {
+  public:
+    static constexpr std::size_t kDefaultBlockSize = 1 << 20;
+
+    explicit EventArena(std::size_t blockSize = kDefaultBlockSize);
+    EventArena(EventArena const&) = delete;
+    EventArena& operator=(EventArena const&) = delete;
+
+    ///Thread safe. Returns memory aligned to alignment which is valid until clear() is called.
+    void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t));
+
+    ///Not thread safe. Releases all allocations but keeps the blocks for reuse.
+    void clear();
+
+    ///Bytes handed out since the last clear()
+    std::size_t bytesAllocated() const { return bytesAllocated_.load(std::memory_order_relaxed); }
+    ///Bytes currently held in blocks, including those retained for reuse
+    std::size_t bytesReserved() const;
+
+  private:
+    struct Block {
+      explicit Block(std::size_t iSize) : data_(new char[iSize]), size_(iSize), used_(0) {}
+      void* tryAllocate(std::size_t bytes, std::size_t alignment);
+
+      std::unique_ptr<char[]> data_;
+      std::size_t const size_;
+      std::atomic<std::size_t> used_;
+    };
+
+    void* allocateSlow(Block* iFull, std::size_t bytes, std::size_t alignment);
+
+    std::size_t const blockSize_;
+    std::atomic<Block*> current_;
+    std::atomic<std::size_t> bytesAllocated_;
+    //blocks_[0, nextBlock_) have been used since the last clear
+    std::vector<std::unique_ptr<Block>> blocks_;
+    std::size_t nextBlock_;
+    std::mutex mutex_;
+  };
+
+  template <typename T>
+  class EventArenaAllocator {
+  public:
+    using value_type = T;
+
+    explicit EventArenaAllocator(EventArena& iArena) noexcept : arena_(&iArena) {}
+    template <typename U>
+    EventArenaAllocator(EventArenaAllocator<U> const& iOther) noexcept : arena_(iOther.arena_) {}
+
+    T* allocate(std::size_t n) { return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T*, std::size_t) noexcept {}
+
+    EventArena& arena() const noexcept { return *arena_; }
+
+  private:
+    template <typename U>
+    friend class EventArenaAllocator;
+
+    EventArena* arena_;
+  };
+
+  template <typename T, typename U>
+  bool operator==(EventArenaAllocator<T> const& a, EventArenaAllocator<U> const& b) noexcept {
+    return &a.arena() == &b.arena();
+  }
+  template <typename T, typename U>
+  bool operator!=(EventArenaAllocator<T> const& a, EventArenaAllocator<U> const& b) noexcept {
+    return not(a == b);
+  }
+}  // namespace edm
+#endif
@@ -20,6 +20,7 @@ is the DataBlock.
 #include "FWCore/Utilities/interface/StreamID.h"
 #include "FWCore/Utilities/interface/Signal.h"
 #include "FWCore/Utilities/interface/get_underlying_safe.h"
+#include "FWCore/Framework/interface/EventArena.h"
 #include "FWCore/Framework/interface/Principal.h"
 
 #include <map>
@@ -105,6 +106,9 @@ namespace edm {
 
     StreamID streamID() const { return streamID_; }
 
+    ///Memory released when clearEventPrincipal is called. EventArena::allocate is thread safe.
+    EventArena& arena() const { return *arena_; }
+
     LuminosityBlockNumber_t luminosityBlock() const { return id().luminosityBlock(); }
 
     RunNumber_t run() const { return id().run(); }
@@ -175,6 +179,9 @@ namespace edm {
     std::map<BranchListIndex, ProcessIndex> branchListIndexToProcessIndex_;
 
     StreamID streamID_;
+
+    // Reused across events, the memory is released in clearEventPrincipal
+    std::unique_ptr<EventArena> arena_;
   };
 
   inline bool isSameEvent(EventPrincipal const& a, EventPrincipal const& b) { return isSameEvent(a.aux(), b.aux()); }
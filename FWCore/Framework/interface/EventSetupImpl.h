@@ -64,6 +64,9 @@ namespace edm {
 
     bool validRecord(eventsetup::EventSetupRecordKey const& iKey) const;
 
+    ///produces, for all records, the data that was requested in an earlier IOV and is not cached yet
+    void prefetchPreviouslyRequestedData() const;
+
     ///Only EventSetupProvider allowed to create an EventSetupImpl
     friend class eventsetup::EventSetupProvider;
     friend class eventsetup::EventSetupRecordProvider;
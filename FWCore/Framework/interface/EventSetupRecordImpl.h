@@ -90,6 +90,9 @@ namespace edm {
           */
       bool wasGotten(DataKey const& aKey) const;
 
+      ///produces the data that was requested in an earlier IOV and is not cached yet
+      void prefetchPreviouslyRequestedData(EventSetupImpl const*) const;
+
       /**returns the ComponentDescription for the module which creates the data or 0
           if no module has been registered for the data. This does not cause the data to
           actually be constructed.
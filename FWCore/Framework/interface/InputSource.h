@@ -57,9 +57,11 @@ Some examples of InputSource subclasses may be:
 #include <string>
 #include <chrono>
 #include <mutex>
+#include <vector>
 
 namespace edm {
   class ActivityRegistry;
+  class BranchID;
   class BranchIDListHelper;
   class ConfigurationDescriptions;
   class HistoryAppender;
@@ -209,6 +211,10 @@ namespace edm {
     /// Called by framework at end of job
     void doEndJob();
 
+    /// Called by framework before beginJob with the event products of earlier processes
+    /// which are consumed by modules of this process
+    void setConsumedEventProducts(std::vector<BranchID> const& branchIDs) { setConsumedEventProducts_(branchIDs); }
+
     /// Called by framework at beginning of lumi block
     virtual void doBeginLumi(LuminosityBlockPrincipal& lbp, ProcessContext const*);
 
@@ -395,6 +401,7 @@ namespace edm {
     virtual void rewind_();
     virtual void beginJob();
     virtual void endJob();
+    virtual void setConsumedEventProducts_(std::vector<BranchID> const& branchIDs);
     virtual std::pair<SharedResourcesAcquirer*, std::recursive_mutex*> resourceSharedWithDelayedReader_();
 
     virtual bool randomAccess_() const;
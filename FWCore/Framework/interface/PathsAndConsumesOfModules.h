@@ -22,6 +22,7 @@
 
 namespace edm {
 
+  class BranchID;
   class ModuleDescription;
   class ProductRegistry;
   class Schedule;
@@ -69,5 +70,9 @@ namespace edm {
   };
 
   void checkForModuleDependencyCorrectness(edm::PathsAndConsumesOfModulesBase const& iPnC, bool iPrintDependencies);
+
+  // Returns the BranchIDs of the Event products from earlier processes which match what any module consumes
+  std::vector<BranchID> consumedEventProductsFromEarlierProcesses(edm::PathsAndConsumesOfModulesBase const& iPnC,
+                                                                   ProductRegistry const& iRegistry);
 }  // namespace edm
 #endif
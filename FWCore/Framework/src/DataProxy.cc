@@ -33,6 +33,8 @@ namespace edm {
         : description_(dummyDescription()),
           cache_(nullptr),
           cacheIsValid_(false),
+          requestedInAnyIOV_(false),
+          nonTransientAccessRequestedInAnyIOV_(false),
           nonTransientAccessRequested_(false) {}
 
     DataProxy::~DataProxy() {}
@@ -41,6 +43,7 @@ namespace edm {
       cacheIsValid_.store(false, std::memory_order_release);
       nonTransientAccessRequested_.store(false, std::memory_order_release);
       cache_ = nullptr;
+      prefetchException_ = nullptr;
     }
 
     void DataProxy::resetIfTransient() {
@@ -95,12 +98,58 @@ namespace edm {
                                bool iTransiently,
                                ActivityRegistry const* activityRegistry,
                                EventSetupImpl const* iEventSetupImpl) const {
+      return getOrPrefetch(iRecord, iKey, iTransiently, activityRegistry, iEventSetupImpl, false);
+    }
+
+    void DataProxy::prefetch(const EventSetupRecordImpl& iRecord,
+                             const DataKey& iKey,
+                             ActivityRegistry const* activityRegistry,
+                             EventSetupImpl const* iEventSetupImpl) const {
+      bool const transiently = !nonTransientAccessRequestedInAnyIOV_.load(std::memory_order_acquire);
+      try {
+        getOrPrefetch(iRecord, iKey, transiently, activityRegistry, iEventSetupImpl, true);
+      } catch (...) {
+        // The exception has been kept by getOrPrefetch and will be thrown,
+        // with the proper context, when the data is actually requested.
+      }
+    }
+
+    const void* DataProxy::getOrPrefetch(const EventSetupRecordImpl& iRecord,
+                                         const DataKey& iKey,
+                                         bool iTransiently,
+                                         ActivityRegistry const* activityRegistry,
+                                         EventSetupImpl const* iEventSetupImpl,
+                                         bool iPrefetching) const {
+      if (!iPrefetching) {
+        if (!requestedInAnyIOV_.load(std::memory_order_relaxed)) {
+          requestedInAnyIOV_.store(true, std::memory_order_release);
+        }
+        if (!iTransiently && !nonTransientAccessRequestedInAnyIOV_.load(std::memory_order_relaxed)) {
+          nonTransientAccessRequestedInAnyIOV_.store(true, std::memory_order_release);
+        }
+      }
       if (!cacheIsValid()) {
         ESSignalSentry signalSentry(iRecord, iKey, providerDescription(), activityRegistry);
         std::lock_guard<std::recursive_mutex> guard(esGlobalMutex());
         signalSentry.sendPostLockSignal();
+        if (prefetchException_) {
+          // the prefetch failed: report it to the first request instead of making the data again
+          if (iPrefetching) {
+            return nullptr;
+          }
+          std::exception_ptr exception = prefetchException_;
+          prefetchException_ = nullptr;
+          std::rethrow_exception(exception);
+        }
         if (!cacheIsValid()) {
-          cache_ = const_cast<DataProxy*>(this)->getImpl(iRecord, iKey, iEventSetupImpl);
+          try {
+            cache_ = const_cast<DataProxy*>(this)->getImpl(iRecord, iKey, iEventSetupImpl);
+          } catch (...) {
+            if (iPrefetching) {
+              prefetchException_ = std::current_exception();
+            }
+            throw;
+          }
           cacheIsValid_.store(true, std::memory_order_release);
         }
       }
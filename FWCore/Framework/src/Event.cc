@@ -34,6 +34,8 @@ namespace edm {
 
   Event::CacheIdentifier_t Event::cacheIdentifier() const { return eventPrincipal().cacheIdentifier(); }
 
+  EventArena& Event::arena() const { return eventPrincipal().arena(); }
+
   void Event::setConsumer(EDConsumerBase const* iConsumer) {
     provRecorder_.setConsumer(iConsumer);
     gotBranchIDs_.reserve(provRecorder_.numberOfProductsConsumed());
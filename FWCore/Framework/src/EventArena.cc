@@ -0,0 +1,100 @@
+// -*- C++ -*-
+//
+// Package:     FWCore/Framework
+// Class  :     EventArena
+//
+
+#include "FWCore/Framework/interface/EventArena.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <new>
+
+namespace edm {
+
+  void* EventArena::Block::tryAllocate(std::size_t bytes, std::size_t alignment) {
+    auto base = reinterpret_cast<std::uintptr_t>(data_.get());
+    std::size_t used = used_.load(std::memory_order_relaxed);
+    while (true) {
+      std::size_t start = ((base + used + alignment - 1) & ~(alignment - 1)) - base;
+      std::size_t end = start + bytes;
+      if (end > size_) {
+        return nullptr;
+      }
+      if (used_.compare_exchange_weak(used, end, std::memory_order_relaxed)) {
+        return data_.get() + start;
+      }
+    }
+  }
+
+  EventArena::EventArena(std::size_t blockSize)
+      : blockSize_(std::max(blockSize, sizeof(std::max_align_t))),
+        current_(nullptr),
+        bytesAllocated_(0),
+        nextBlock_(0) {}
+
+  void* EventArena::allocate(std::size_t bytes, std::size_t alignment) {
+    assert(alignment != 0 and (alignment & (alignment - 1)) == 0);
+    if (bytes == 0) {
+      bytes = 1;
+    }
+    Block* block = current_.load(std::memory_order_acquire);
+    if (block) {
+      if (void* p = block->tryAllocate(bytes, alignment)) {
+        bytesAllocated_.fetch_add(bytes, std::memory_order_relaxed);
+        return p;
+      }
+    }
+    return allocateSlow(block, bytes, alignment);
+  }
+
+  void* EventArena::allocateSlow(Block* iFull, std::size_t bytes, std::size_t alignment) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    //another thread may already have moved on to a new block
+    Block* block = current_.load(std::memory_order_acquire);
+    if (block and block != iFull) {
+      if (void* p = block->tryAllocate(bytes, alignment)) {
+        bytesAllocated_.fetch_add(bytes, std::memory_order_relaxed);
+        return p;
+      }
+    }
+    //operator new[] only guarantees alignof(std::max_align_t) so leave room to realign
+    std::size_t const needed = bytes + (alignment > alignof(std::max_align_t) ? alignment : 0);
+    //reuse a retained block large enough, otherwise make a new one
+    std::size_t found = nextBlock_;
+    while (found < blocks_.size() and blocks_[found]->size_ < needed) {
+      ++found;
+    }
+    if (found == blocks_.size()) {
+      blocks_.emplace_back(std::make_unique<Block>(std::max(blockSize_, needed)));
+    }
+    std::swap(blocks_[found], blocks_[nextBlock_]);
+    block = blocks_[nextBlock_++].get();
+    void* p = block->tryAllocate(bytes, alignment);
+    assert(p != nullptr);
+    bytesAllocated_.fetch_add(bytes, std::memory_order_relaxed);
+    //an oversized request should not make us abandon the remainder of a regular block
+    if (needed <= blockSize_ or current_.load(std::memory_order_relaxed) == nullptr) {
+      current_.store(block, std::memory_order_release);
+    }
+    return p;
+  }
+
+  void EventArena::clear() {
+    for (std::size_t i = 0; i < nextBlock_; ++i) {
+      blocks_[i]->used_.store(0, std::memory_order_relaxed);
+    }
+    nextBlock_ = 0;
+    current_.store(nullptr, std::memory_order_relaxed);
+    bytesAllocated_.store(0, std::memory_order_relaxed);
+  }
+
+  std::size_t EventArena::bytesReserved() const {
+    std::size_t total = 0;
+    for (auto const& b : blocks_) {
+      total += b->size_;
+    }
+    return total;
+  }
+}  // namespace edm
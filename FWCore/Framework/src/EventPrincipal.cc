@@ -43,7 +43,8 @@ namespace edm {
         thinnedAssociationsHelper_(thinnedAssociationsHelper),
         branchListIndexes_(),
         branchListIndexToProcessIndex_(),
-        streamID_(streamIndex) {
+        streamID_(streamIndex),
+        arena_(std::make_unique<EventArena>()) {
     assert(thinnedAssociationsHelper_);
   }
 
@@ -54,6 +55,8 @@ namespace edm {
     // it is only connected at beginLumi transition
     provRetrieverPtr_->reset();
     branchListIndexToProcessIndex_.clear();
+    //products were deleted by clearPrincipal so nothing can still refer to the arena
+    arena_->clear();
   }
 
   void EventPrincipal::fillEventPrincipal(EventAuxiliary const& aux,
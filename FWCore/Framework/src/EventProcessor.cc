@@ -540,6 +540,11 @@ namespace edm {
     checkForModuleDependencyCorrectness(pathsAndConsumesOfModules_, printDependencies_);
     actReg_->preBeginJobSignal_(pathsAndConsumesOfModules_, processContext_);
 
+    //SubProcesses and loopers may read products which are not declared by the modules of this process
+    if (subProcesses_.empty() and not looper_) {
+      input_->setConsumedEventProducts(consumedEventProductsFromEarlierProcesses(pathsAndConsumesOfModules_, *preg_));
+    }
+
     if (preallocations_.numberOfLuminosityBlocks() > 1) {
       warnAboutModulesRequiringLuminosityBLockSynchronization();
     }
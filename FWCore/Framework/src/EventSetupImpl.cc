@@ -90,6 +90,14 @@ namespace edm {
     return false;
   }
 
+  void EventSetupImpl::prefetchPreviouslyRequestedData() const {
+    for (auto const* recordImpl : recordImpls_) {
+      if (recordImpl != nullptr) {
+        recordImpl->prefetchPreviouslyRequestedData(this);
+      }
+    }
+  }
+
   void EventSetupImpl::setKeyIters(std::vector<eventsetup::EventSetupRecordKey>::const_iterator const& keysBegin,
                                    std::vector<eventsetup::EventSetupRecordKey>::const_iterator const& keysEnd) {
     keysBegin_ = keysBegin;
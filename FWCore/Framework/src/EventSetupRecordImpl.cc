@@ -264,6 +264,15 @@ namespace edm {
       return false;
     }
 
+    void EventSetupRecordImpl::prefetchPreviouslyRequestedData(EventSetupImpl const* iEventSetupImpl) const {
+      for (std::size_t i = 0; i < proxies_.size(); ++i) {
+        DataProxy const* proxy = proxies_[i].get();
+        if (proxy->requestedInAnyIOV() and not proxy->cacheIsValid()) {
+          proxy->prefetch(*this, keysForProxies_[i], activityRegistry_, iEventSetupImpl);
+        }
+      }
+    }
+
     edm::eventsetup::ComponentDescription const* EventSetupRecordImpl::providerDescription(const DataKey& aKey) const {
       const DataProxy* proxy = find(aKey);
       if (nullptr != proxy) {
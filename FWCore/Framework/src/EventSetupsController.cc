@@ -12,6 +12,7 @@
 
 #include "FWCore/Framework/src/EventSetupsController.h"
 
+#include "FWCore/Concurrency/interface/FunctorTask.h"
 #include "FWCore/Concurrency/interface/WaitingTaskHolder.h"
 #include "FWCore/Concurrency/interface/WaitingTaskList.h"
 #include "FWCore/Framework/interface/DataKey.h"
@@ -21,6 +22,7 @@
 #include "FWCore/Framework/interface/EventSetupRecordKey.h"
 #include "FWCore/Framework/interface/ParameterSetIDHolder.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ServiceRegistry/interface/ServiceRegistry.h"
 #include "FWCore/Utilities/interface/EDMException.h"
 
 #include <algorithm>
@@ -47,6 +49,10 @@ namespace edm {
       fillEventSetupProvider(*this, *returnValue, iPSet);
 
       numberOfConcurrentIOVs_.readConfigurationParameters(eventSetupPset);
+      if (eventSetupPset) {  // this condition is false for SubProcesses
+        prefetchPreviouslyRequestedData_ =
+            eventSetupPset->getUntrackedParameter<bool>("prefetchPreviouslyRequestedData");
+      }
 
       providers_.push_back(returnValue);
       return returnValue;
@@ -116,11 +122,59 @@ namespace edm {
         eventSetupImpls.push_back(eventSetupProvider->eventSetupForInstance(syncValue, newEventSetupImpl));
       }
 
+      if (prefetchPreviouslyRequestedData_ and newEventSetupImpl) {
+        prefetchAsync(taskToStartAfterIOVInit, endIOVWaitingTasks, eventSetupImpls, newEventSetupImpl);
+        return;
+      }
+
       for (auto& eventSetupRecordIOVQueue : eventSetupRecordIOVQueues_) {
         eventSetupRecordIOVQueue->checkForNewIOVs(taskToStartAfterIOVInit, endIOVWaitingTasks, newEventSetupImpl);
       }
     }
 
+    void EventSetupsController::prefetchAsync(WaitingTaskHolder const& taskToStartAfterIOVInit,
+                                              WaitingTaskList& endIOVWaitingTasks,
+                                              std::vector<std::shared_ptr<const EventSetupImpl>> const& eventSetupImpls,
+                                              bool newEventSetupImpl) {
+      // As soon as the new IOVs are initialized, the transition is allowed to
+      // proceed, while a background task produces the data that was requested
+      // in earlier IOVs, so that it is ready when the modules ask for it.
+      // The IOVs must not end before that task is done, so they wait on a
+      // private list, which is released once both the transition and the
+      // background task no longer need them.
+      auto iovsInUse = std::make_shared<WaitingTaskList>();
+      auto releaseIOVs = make_waiting_task(tbb::task::allocate_root(), [iovsInUse](std::exception_ptr const*) mutable {
+        iovsInUse->doneWaiting(std::exception_ptr{});
+      });
+      WaitingTaskHolder prefetchDone{releaseIOVs};
+      endIOVWaitingTasks.add(releaseIOVs);
+
+      auto token = ServiceRegistry::instance().presentToken();
+      auto iovsReady = make_waiting_task(
+          tbb::task::allocate_root(),
+          [taskToStartAfterIOVInit, prefetchDone, eventSetupImpls, token](std::exception_ptr const* iPtr) mutable {
+            if (iPtr) {
+              taskToStartAfterIOVInit.doneWaiting(*iPtr);
+              return;
+            }
+            taskToStartAfterIOVInit.doneWaiting(std::exception_ptr{});
+            tbb::task::spawn(*make_functor_task(
+                tbb::task::allocate_root(),
+                [prefetchDone = std::move(prefetchDone), eventSetupImpls = std::move(eventSetupImpls), token]() mutable {
+                  ServiceRegistry::Operate operate(token);
+                  for (auto const& eventSetupImpl : eventSetupImpls) {
+                    eventSetupImpl->prefetchPreviouslyRequestedData();
+                  }
+                  prefetchDone.doneWaiting(std::exception_ptr{});
+                }));
+          });
+      WaitingTaskHolder iovsReadyHolder{iovsReady};
+
+      for (auto& eventSetupRecordIOVQueue : eventSetupRecordIOVQueues_) {
+        eventSetupRecordIOVQueue->checkForNewIOVs(iovsReadyHolder, *iovsInUse, newEventSetupImpl);
+      }
+    }
+
     void EventSetupsController::eventSetupForInstance(IOVSyncValue const& syncValue) {
       // This function only supports use cases where the event setup
       // system is used without multiple concurrent IOVs.
@@ -162,6 +162,10 @@ namespace edm {
     private:
       void checkESProducerSharing();
       void initializeEventSetupRecordIOVQueues();
+      void prefetchAsync(WaitingTaskHolder const& taskToStartAfterIOVInit,
+                         WaitingTaskList& endIOVWaitingTasks,
+                         std::vector<std::shared_ptr<const EventSetupImpl>> const&,
+                         bool newEventSetupImpl);
 
       // ---------- member data --------------------------------
       std::vector<propagate_const<std::shared_ptr<EventSetupProvider>>> providers_;
@@ -186,6 +190,7 @@ namespace edm {
 
       bool hasNonconcurrentFinder_ = false;
       bool mustFinishConfiguration_ = true;
+      bool prefetchPreviouslyRequestedData_ = false;
     };
   }  // namespace eventsetup
 }  // namespace edm
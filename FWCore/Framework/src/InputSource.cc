@@ -418,6 +418,8 @@ namespace edm {
 
   void InputSource::endJob() {}
 
+  void InputSource::setConsumedEventProducts_(std::vector<BranchID> const&) {}
+
   bool InputSource::randomAccess_() const { return false; }
 
   ProcessingController::ForwardState InputSource::forwardState_() const {
@@ -4,9 +4,14 @@
 #include "FWCore/Framework/src/Worker.h"
 #include "throwIfImproperDependencies.h"
 
+#include "DataFormats/Provenance/interface/BranchID.h"
+#include "DataFormats/Provenance/interface/ProductRegistry.h"
+#include "DataFormats/Provenance/interface/ProductResolverIndexHelper.h"
 #include "FWCore/Utilities/interface/EDMException.h"
 
 #include <algorithm>
+#include <set>
+#include <unordered_map>
 namespace edm {
 
   PathsAndConsumesOfModules::~PathsAndConsumesOfModules() {}
@@ -86,6 +91,44 @@ namespace edm {
     return iter->second;
   }
 
+  std::vector<BranchID> consumedEventProductsFromEarlierProcesses(PathsAndConsumesOfModulesBase const& iPnC,
+                                                                   ProductRegistry const& iRegistry) {
+    std::unordered_map<ProductResolverIndex, BranchID> indexToBranchID;
+    for (auto const& item : iRegistry.productList()) {
+      BranchDescription const& desc = item.second;
+      if (desc.branchType() != InEvent or desc.produced()) {
+        continue;
+      }
+      //an EDAlias is read using the branch of the product it refers to
+      indexToBranchID.emplace(iRegistry.indexFrom(desc.branchID()), desc.originalBranchID());
+    }
+
+    ProductResolverIndexHelper const& helper = *iRegistry.productLookup(InEvent);
+    std::set<BranchID> consumed;
+    for (auto const* description : iPnC.allModules()) {
+      for (auto const& info : iPnC.consumesInfo(description->id())) {
+        if (info.branchType() != InEvent) {
+          continue;
+        }
+        //consumesMany has an empty module label
+        auto matches = info.label().empty()
+                           ? helper.relatedIndexes(info.kindOfType(), info.type())
+                           : helper.relatedIndexes(
+                                 info.kindOfType(), info.type(), info.label().c_str(), info.instance().c_str());
+        for (unsigned int i = 0; i < matches.numberOfMatches(); ++i) {
+          if (not info.process().empty() and info.process() != matches.processName(i)) {
+            continue;
+          }
+          auto found = indexToBranchID.find(matches.index(i));
+          if (found != indexToBranchID.end()) {
+            consumed.insert(found->second);
+          }
+        }
+      }
+    }
+    return std::vector<BranchID>(consumed.begin(), consumed.end());
+  }
+
   //====================================
   // checkForCorrectness algorithm
   //
@@ -29,6 +29,7 @@
 
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+#include "FWCore/Utilities/interface/Exception.h"
 
 #include <memory>
 
@@ -68,6 +69,8 @@ class testEventsetupRecord : public CppUnit::TestFixture {
   CPPUNIT_TEST(proxyResetTest);
   CPPUNIT_TEST(introspectionTest);
   CPPUNIT_TEST(transientTest);
+  CPPUNIT_TEST(prefetchTest);
+  CPPUNIT_TEST(prefetchExceptionTest);
 
   CPPUNIT_TEST_EXCEPTION(getNodataExpTest, NoDataExceptionType);
   CPPUNIT_TEST_EXCEPTION(getExepTest, ExceptionType);
@@ -87,6 +90,8 @@ public:
   void proxyResetTest();
   void introspectionTest();
   void transientTest();
+  void prefetchTest();
+  void prefetchExceptionTest();
 
   void getNodataExpTest();
   void getExepTest();
@@ -106,6 +111,21 @@ protected:
   void invalidateCache() override {}
 };
 
+class ThrowingDummyProxy : public eventsetup::DataProxyTemplate<DummyRecord, Dummy> {
+public:
+  unsigned int makeCalls() const { return makeCalls_; }
+
+protected:
+  const value_type* make(const record_type&, const DataKey&) override {
+    ++makeCalls_;
+    throw cms::Exception("TestFailure") << "make failed";
+  }
+  void invalidateCache() override {}
+
+private:
+  unsigned int makeCalls_ = 0;
+};
+
 class WorkingDummyProxy : public eventsetup::DataProxyTemplate<DummyRecord, Dummy> {
 public:
   WorkingDummyProxy(const Dummy* iDummy) : data_(iDummy), invalidateCalled_(false), invalidateTransientCalled_(false) {}
@@ -784,3 +804,75 @@ void testEventsetupRecord::transientTest() {
     CPPUNIT_ASSERT(workingProxy->invalidateTransientCalled() == false);
   }
 }
+
+void testEventsetupRecord::prefetchTest() {
+  auto dummyProvider = std::make_unique<EventSetupRecordProvider>(DummyRecord::keyForClass(), &activityRegistry);
+
+  DummyRecord dummyRecordNoConst;
+  dummyRecordNoConst.setImpl(&dummyProvider->firstRecordImpl(), 0, nullptr, nullptr);
+  EventSetupRecord const& dummyRecord = dummyRecordNoConst;
+
+  eventsetup::EventSetupRecordImpl& nonConstDummyRecordImpl = *const_cast<EventSetupRecordImpl*>(dummyRecord.impl_);
+
+  Dummy myDummy;
+  std::shared_ptr<WorkingDummyProxy> workingProxy = std::make_shared<WorkingDummyProxy>(&myDummy);
+
+  const DataKey workingDataKey(DataKey::makeTypeTag<WorkingDummyProxy::value_type>(), "");
+
+  std::shared_ptr<WorkingDummyProvider> wdProv = std::make_shared<WorkingDummyProvider>(workingDataKey, workingProxy);
+  wdProv->createKeyedProxies(DummyRecord::keyForClass(), 1);
+  dummyProvider->add(wdProv);
+
+  edm::eventsetup::EventSetupRecordProvider::DataToPreferredProviderMap pref;
+  dummyProvider->usePreferred(pref);
+
+  //nothing was requested yet, so nothing is prefetched
+  nonConstDummyRecordImpl.prefetchPreviouslyRequestedData(nullptr);
+  CPPUNIT_ASSERT(!nonConstDummyRecordImpl.wasGotten(workingDataKey));
+
+  //only transient accesses: the prefetched data must be cleared as transient
+  edm::ESTransientHandle<Dummy> hTDummy;
+  dummyRecord.get(hTDummy);
+  dummyProvider->resetProxies();
+  nonConstDummyRecordImpl.prefetchPreviouslyRequestedData(nullptr);
+  CPPUNIT_ASSERT(nonConstDummyRecordImpl.wasGotten(workingDataKey));
+  nonConstDummyRecordImpl.resetIfTransientInProxies();
+  CPPUNIT_ASSERT(workingProxy->invalidateTransientCalled());
+  CPPUNIT_ASSERT(!nonConstDummyRecordImpl.wasGotten(workingDataKey));
+
+  //after a non-transient access the prefetched data must be kept
+  edm::ESHandle<Dummy> hDummy;
+  dummyRecord.get(hDummy);
+  dummyProvider->resetProxies();
+  nonConstDummyRecordImpl.prefetchPreviouslyRequestedData(nullptr);
+  CPPUNIT_ASSERT(nonConstDummyRecordImpl.wasGotten(workingDataKey));
+  nonConstDummyRecordImpl.resetIfTransientInProxies();
+  CPPUNIT_ASSERT(!workingProxy->invalidateTransientCalled());
+  CPPUNIT_ASSERT(nonConstDummyRecordImpl.wasGotten(workingDataKey));
+}
+
+void testEventsetupRecord::prefetchExceptionTest() {
+  eventsetup::EventSetupRecordImpl dummyRecordImpl{dummyRecordKey_, &activityRegistry};
+
+  ThrowingDummyProxy dummyProxy;
+
+  const DataKey dummyDataKey(DataKey::makeTypeTag<ThrowingDummyProxy::value_type>(), "");
+
+  DummyRecord dummyRecord;
+  dummyRecord.setImpl(&dummyRecordImpl, 0, nullptr, nullptr);
+  dummyRecordImpl.add(dummyDataKey, &dummyProxy);
+
+  CPPUNIT_ASSERT_THROW(dummyRecord.doGet(dummyDataKey), cms::Exception);
+  CPPUNIT_ASSERT(dummyProxy.makeCalls() == 1);
+
+  //new IOV: the failure of the prefetch is reported by the first request, without making the data again
+  dummyProxy.invalidate();
+  dummyRecordImpl.prefetchPreviouslyRequestedData(nullptr);
+  CPPUNIT_ASSERT(dummyProxy.makeCalls() == 2);
+  CPPUNIT_ASSERT_THROW(dummyRecord.doGet(dummyDataKey), cms::Exception);
+  CPPUNIT_ASSERT(dummyProxy.makeCalls() == 2);
+
+  //later requests behave as without the prefetch
+  CPPUNIT_ASSERT_THROW(dummyRecord.doGet(dummyDataKey), cms::Exception);
+  CPPUNIT_ASSERT(dummyProxy.makeCalls() == 3);
+}
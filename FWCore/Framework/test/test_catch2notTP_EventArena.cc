@@ -0,0 +1,87 @@
+#include "catch.hpp"
+
+#include "FWCore/Framework/interface/EventArena.h"
+
+#include <cstdint>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+TEST_CASE("test EventArena", "[EventArena]") {
+  SECTION("alignment") {
+    edm::EventArena arena(1024);
+    for (std::size_t alignment : {1, 2, 8, 16, 64, 256}) {
+      void* p = arena.allocate(3, alignment);
+      REQUIRE(reinterpret_cast<std::uintptr_t>(p) % alignment == 0);
+    }
+  }
+
+  SECTION("allocations larger than a block") {
+    edm::EventArena arena(1024);
+    void* small = arena.allocate(16);
+    void* large = arena.allocate(10000, 128);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(large) % 128 == 0);
+    //the regular block is still in use
+    void* small2 = arena.allocate(16);
+    REQUIRE(static_cast<char*>(small2) - static_cast<char*>(small) == 16);
+    REQUIRE(arena.bytesAllocated() == 10032);
+  }
+
+  SECTION("clear reuses blocks") {
+    edm::EventArena arena(1024);
+    for (int i = 0; i < 100; ++i) {
+      arena.allocate(100);
+    }
+    auto reserved = arena.bytesReserved();
+    arena.clear();
+    REQUIRE(arena.bytesAllocated() == 0);
+    for (int i = 0; i < 100; ++i) {
+      arena.allocate(100);
+    }
+    REQUIRE(arena.bytesReserved() == reserved);
+  }
+
+  SECTION("allocator") {
+    edm::EventArena arena;
+    std::vector<int, edm::EventArenaAllocator<int>> v{edm::EventArenaAllocator<int>(arena)};
+    for (int i = 0; i < 1000; ++i) {
+      v.push_back(i);
+    }
+    REQUIRE(std::accumulate(v.begin(), v.end(), 0) == 999 * 1000 / 2);
+    REQUIRE(arena.bytesAllocated() >= 1000 * sizeof(int));
+
+    edm::EventArena other;
+    REQUIRE(v.get_allocator() == edm::EventArenaAllocator<double>(arena));
+    REQUIRE(v.get_allocator() != edm::EventArenaAllocator<int>(other));
+  }
+
+  SECTION("concurrent allocations do not overlap") {
+    edm::EventArena arena(4096);
+    constexpr unsigned int kThreads = 4;
+    constexpr unsigned int kAllocs = 10000;
+    std::vector<std::vector<std::uint32_t*>> pointers(kThreads);
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < kThreads; ++t) {
+      threads.emplace_back([&arena, &pointers, t]() {
+        for (unsigned int i = 0; i < kAllocs; ++i) {
+          auto p = static_cast<std::uint32_t*>(arena.allocate(sizeof(std::uint32_t) * 4, alignof(std::uint32_t)));
+          for (unsigned int j = 0; j < 4; ++j) {
+            p[j] = t * kAllocs + i;
+          }
+          pointers[t].push_back(p);
+        }
+      });
+    }
+    for (auto& th : threads) {
+      th.join();
+    }
+    for (unsigned int t = 0; t < kThreads; ++t) {
+      for (unsigned int i = 0; i < kAllocs; ++i) {
+        for (unsigned int j = 0; j < 4; ++j) {
+          REQUIRE(pointers[t][i][j] == t * kAllocs + i);
+        }
+      }
+    }
+    REQUIRE(arena.bytesAllocated() == kThreads * kAllocs * sizeof(std::uint32_t) * 4);
+  }
+}
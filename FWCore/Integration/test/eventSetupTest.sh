@@ -24,6 +24,9 @@ cmsRun --parameter-set ${LOCAL_TEST_DIR}/testAllowConcurrentIOVs_cfg.py || die '
 echo testConcurrentIOVsForce_cfg
 cmsRun --parameter-set ${LOCAL_TEST_DIR}/testConcurrentIOVsForce_cfg.py || die 'Failed in testConcurrentIOVsForce_cfg.py' $?
 
+echo testConcurrentIOVsPrefetch_cfg
+cmsRun --parameter-set ${LOCAL_TEST_DIR}/testConcurrentIOVsPrefetch_cfg.py || die 'Failed in testConcurrentIOVsPrefetch_cfg.py' $?
+
 echo testEventSetupRunLumi_cfg
 cmsRun --parameter-set ${LOCAL_TEST_DIR}/testEventSetupRunLumi_cfg.py || die 'Failed in testEventSetupRunLumi_cfg.py' $?
 
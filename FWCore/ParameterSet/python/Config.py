@@ -219,7 +219,8 @@ class Process(object):
                                   numberOfConcurrentIOVs = untracked.uint32(1),
                                   forceNumberOfConcurrentIOVs = untracked.PSet(
                                       allowAnyLabel_ = required.untracked.uint32
-                                  )
+                                  ),
+                                  prefetchPreviouslyRequestedData = untracked.bool(False)
                               ),
                               wantSummary = untracked.bool(False),
                               fileMode = untracked.string('FULLMERGE'),
@@ -1862,7 +1863,8 @@ process.options = cms.untracked.PSet(
         forceNumberOfConcurrentIOVs = cms.untracked.PSet(
 
         ),
-        numberOfConcurrentIOVs = cms.untracked.uint32(1)
+        numberOfConcurrentIOVs = cms.untracked.uint32(1),
+        prefetchPreviouslyRequestedData = cms.untracked.bool(False)
     ),
     fileMode = cms.untracked.string('FULLMERGE'),
     forceEventSetupCacheClearOnNewRun = cms.untracked.bool(False),
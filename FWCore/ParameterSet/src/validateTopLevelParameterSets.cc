@@ -30,6 +30,10 @@ namespace edm {
         "Parameter names should be record names and the values are the number of concurrent IOVS for each record."
         " Overrides all other methods of setting number of concurrent IOVs.");
     eventSetupDescription.addUntracked<edm::ParameterSetDescription>("forceNumberOfConcurrentIOVs", nestedDescription);
+    eventSetupDescription.addUntracked<bool>("prefetchPreviouslyRequestedData", false)
+        ->setComment(
+            "If true, when new IOVs start, produce in the background the data that was requested in earlier IOVs, "
+            "while the transition proceeds");
     description.addUntracked<edm::ParameterSetDescription>("eventSetup", eventSetupDescription);
 
     description.addUntracked<bool>("wantSummary", false)
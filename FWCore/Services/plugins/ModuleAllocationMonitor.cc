@@ -0,0 +1,306 @@
+// -*- C++ -*-
+//
+// Package: FWCore/Services
+// Class  : ModuleAllocationMonitor
+//
+// Implementation:
+//     Attributes the memory allocated and released by each thread to the
+//     module running on that thread, using the per-thread counters kept by
+//     jemalloc (available when the job runs with a jemalloc built with
+//     --enable-stats, as cmsRun does by default).
+//
+//     Limitations, all due to reading only thread.allocatedp and
+//     thread.deallocatedp at the start and end of each module call:
+//     - only byte totals are measured: neither the number of allocations
+//       nor the peak of live memory inside a call are available, and the
+//       "retained" columns are the bytes allocated but not released by the
+//       end of the call;
+//     - memory allocated by TBB tasks that a module spawns and that run on
+//       other threads is not attributed to that module (it is attributed to
+//       whatever module those threads are running, if any).
+//
+
+#include "DataFormats/Provenance/interface/ModuleDescription.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+#include "FWCore/ServiceRegistry/interface/GlobalContext.h"
+#include "FWCore/ServiceRegistry/interface/ModuleCallingContext.h"
+#include "FWCore/ServiceRegistry/interface/ServiceMaker.h"
+#include "FWCore/ServiceRegistry/interface/StreamContext.h"
+#include "FWCore/Utilities/interface/OStreamColumn.h"
+#include "FWCore/Utilities/interface/ThreadMemoryUsage.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+  struct Snapshot {
+    std::uint64_t allocated = 0;
+    std::uint64_t deallocated = 0;
+  };
+
+  // the total number of bytes allocated and deallocated so far by the current thread
+  Snapshot snapshot() { return {edm::ThreadMemoryUsage::allocated(), edm::ThreadMemoryUsage::deallocated()}; }
+
+  // A module call in progress on the current thread. Calls can nest, e.g. when
+  // a module triggers the unscheduled execution of another one; the memory used
+  // by the nested calls is subtracted from that of the enclosing one.
+  struct Frame {
+    Snapshot start;
+    Snapshot nested;
+  };
+
+  thread_local std::vector<Frame> frames;
+
+  //===============================================================
+  class AllocationStatistics {
+  public:
+    std::uint64_t calls() const { return calls_; }
+    std::uint64_t allocated() const { return allocated_; }
+    std::uint64_t deallocated() const { return deallocated_; }
+    std::uint64_t maxAllocated() const { return maxAllocated_; }
+    std::uint64_t maxRetained() const { return maxRetained_; }
+
+    void update(std::uint64_t const allocated, std::uint64_t const deallocated) {
+      ++calls_;
+      allocated_ += allocated;
+      deallocated_ += deallocated;
+      updateMax(maxAllocated_, allocated);
+      if (allocated > deallocated)
+        updateMax(maxRetained_, allocated - deallocated);
+    }
+
+  private:
+    static void updateMax(std::atomic<std::uint64_t>& max, std::uint64_t const value) {
+      std::uint64_t current{max};
+      while (value > current && !max.compare_exchange_weak(current, value))
+        ;
+    }
+
+    std::atomic<std::uint64_t> calls_{};
+    std::atomic<std::uint64_t> allocated_{};
+    std::atomic<std::uint64_t> deallocated_{};
+    std::atomic<std::uint64_t> maxAllocated_{};
+    std::atomic<std::uint64_t> maxRetained_{};
+  };
+
+  enum class Phase : unsigned { Job = 0, Event = 1, RunLumi = 2 };
+  constexpr unsigned nPhases = 3;
+  constexpr std::array<char const*, nPhases> phaseNames{{"job", "event", "run/lumi"}};
+
+  struct ModuleAllocations {
+    std::string label;
+    std::array<AllocationStatistics, nPhases> phases;
+  };
+
+  std::string const space{"  "};
+
+  std::string toMegabytes(double const bytes) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(3) << bytes / (1024. * 1024.) << " MB";
+    return oss.str();
+  }
+
+}  // namespace
+
+namespace edm {
+  namespace service {
+
+    class ModuleAllocationMonitor {
+    public:
+      ModuleAllocationMonitor(ParameterSet const&, ActivityRegistry&);
+      static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+    private:
+      void preModuleConstruction(ModuleDescription const&);
+      void preModuleJobTransition(ModuleDescription const&) { start(); }
+      void postModuleJobTransition(ModuleDescription const& md) { stop(md.id(), Phase::Job); }
+      void preModuleEvent(StreamContext const&, ModuleCallingContext const&) { start(); }
+      void postModuleEvent(StreamContext const&, ModuleCallingContext const& mcc) {
+        stop(mcc.moduleDescription()->id(), Phase::Event);
+      }
+      void preModuleStreamTransition(StreamContext const&, ModuleCallingContext const&) { start(); }
+      void postModuleStreamTransition(StreamContext const&, ModuleCallingContext const& mcc) {
+        stop(mcc.moduleDescription()->id(), Phase::RunLumi);
+      }
+      void preModuleGlobalTransition(GlobalContext const&, ModuleCallingContext const&) { start(); }
+      void postModuleGlobalTransition(GlobalContext const&, ModuleCallingContext const& mcc) {
+        stop(mcc.moduleDescription()->id(), Phase::RunLumi);
+      }
+      void postEndJob();
+
+      void start();
+      void stop(unsigned int moduleID, Phase phase);
+
+      unsigned int const reportedModules_;
+
+      // Module ids are dense, and all modules are constructed before any
+      // other transition, so the vector does not change while it is being
+      // filled concurrently.
+      std::vector<std::unique_ptr<ModuleAllocations>> modules_;
+    };
+
+  }  // namespace service
+}  // namespace edm
+
+using edm::service::ModuleAllocationMonitor;
+
+ModuleAllocationMonitor::ModuleAllocationMonitor(ParameterSet const& iPS, ActivityRegistry& iRegistry)
+    : reportedModules_{iPS.getUntrackedParameter<unsigned int>("reportedModules")} {
+  if (not ThreadMemoryUsage::isAvailable()) {
+    edm::LogWarning("ModuleAllocationMonitor")
+        << "The ModuleAllocationMonitor service requires jemalloc built with statistics support, "
+           "which is not used by this job; no allocations will be monitored.";
+    return;
+  }
+
+  iRegistry.watchPreModuleConstruction(this, &ModuleAllocationMonitor::preModuleConstruction);
+  iRegistry.watchPostModuleConstruction(this, &ModuleAllocationMonitor::postModuleJobTransition);
+  iRegistry.watchPreModuleBeginJob(this, &ModuleAllocationMonitor::preModuleJobTransition);
+  iRegistry.watchPostModuleBeginJob(this, &ModuleAllocationMonitor::postModuleJobTransition);
+  iRegistry.watchPreModuleEndJob(this, &ModuleAllocationMonitor::preModuleJobTransition);
+  iRegistry.watchPostModuleEndJob(this, &ModuleAllocationMonitor::postModuleJobTransition);
+
+  iRegistry.watchPreModuleEventAcquire(this, &ModuleAllocationMonitor::preModuleEvent);
+  iRegistry.watchPostModuleEventAcquire(this, &ModuleAllocationMonitor::postModuleEvent);
+  iRegistry.watchPreModuleEvent(this, &ModuleAllocationMonitor::preModuleEvent);
+  iRegistry.watchPostModuleEvent(this, &ModuleAllocationMonitor::postModuleEvent);
+
+  iRegistry.watchPreModuleStreamBeginRun(this, &ModuleAllocationMonitor::preModuleStreamTransition);
+  iRegistry.watchPostModuleStreamBeginRun(this, &ModuleAllocationMonitor::postModuleStreamTransition);
+  iRegistry.watchPreModuleStreamEndRun(this, &ModuleAllocationMonitor::preModuleStreamTransition);
+  iRegistry.watchPostModuleStreamEndRun(this, &ModuleAllocationMonitor::postModuleStreamTransition);
+  iRegistry.watchPreModuleStreamBeginLumi(this, &ModuleAllocationMonitor::preModuleStreamTransition);
+  iRegistry.watchPostModuleStreamBeginLumi(this, &ModuleAllocationMonitor::postModuleStreamTransition);
+  iRegistry.watchPreModuleStreamEndLumi(this, &ModuleAllocationMonitor::preModuleStreamTransition);
+  iRegistry.watchPostModuleStreamEndLumi(this, &ModuleAllocationMonitor::postModuleStreamTransition);
+
+  iRegistry.watchPreModuleGlobalBeginRun(this, &ModuleAllocationMonitor::preModuleGlobalTransition);
+  iRegistry.watchPostModuleGlobalBeginRun(this, &ModuleAllocationMonitor::postModuleGlobalTransition);
+  iRegistry.watchPreModuleGlobalEndRun(this, &ModuleAllocationMonitor::preModuleGlobalTransition);
+  iRegistry.watchPostModuleGlobalEndRun(this, &ModuleAllocationMonitor::postModuleGlobalTransition);
+  iRegistry.watchPreModuleWriteRun(this, &ModuleAllocationMonitor::preModuleGlobalTransition);
+  iRegistry.watchPostModuleWriteRun(this, &ModuleAllocationMonitor::postModuleGlobalTransition);
+  iRegistry.watchPreModuleGlobalBeginLumi(this, &ModuleAllocationMonitor::preModuleGlobalTransition);
+  iRegistry.watchPostModuleGlobalBeginLumi(this, &ModuleAllocationMonitor::postModuleGlobalTransition);
+  iRegistry.watchPreModuleGlobalEndLumi(this, &ModuleAllocationMonitor::preModuleGlobalTransition);
+  iRegistry.watchPostModuleGlobalEndLumi(this, &ModuleAllocationMonitor::postModuleGlobalTransition);
+  iRegistry.watchPreModuleWriteLumi(this, &ModuleAllocationMonitor::preModuleGlobalTransition);
+  iRegistry.watchPostModuleWriteLumi(this, &ModuleAllocationMonitor::postModuleGlobalTransition);
+
+  iRegistry.watchPostEndJob(this, &ModuleAllocationMonitor::postEndJob);
+}
+
+void ModuleAllocationMonitor::fillDescriptions(ConfigurationDescriptions& descriptions) {
+  ParameterSetDescription desc;
+  desc.addUntracked<unsigned int>("reportedModules", 20)
+      ->setComment(
+          "Number of module transitions, ordered by the total number of bytes allocated,\n"
+          "to be shown in the summary at the end of the job. 0 shows all of them.");
+  descriptions.add("ModuleAllocationMonitor", desc);
+  descriptions.setComment(
+      "This service measures the memory allocated and released by each module, separately for the construction, "
+      "beginJob and endJob transitions, the event transitions, and the run and lumi transitions.\n"
+      "It relies on the per-thread statistics of jemalloc, and does nothing if they are not available.\n"
+      "Only the total number of bytes is measured, not the number of allocations or the peak memory within a "
+      "call; 'retained' is what was allocated and not released by the end of a call. Memory allocated by tasks "
+      "that a module spawns on other threads is not attributed to the module.");
+}
+
+void ModuleAllocationMonitor::preModuleConstruction(ModuleDescription const& md) {
+  auto const mid = md.id();
+  if (mid >= modules_.size()) {
+    modules_.resize(mid + 1);
+  }
+  modules_[mid] = std::make_unique<ModuleAllocations>();
+  modules_[mid]->label = md.moduleLabel();
+  start();
+}
+
+void ModuleAllocationMonitor::start() { frames.push_back(Frame{snapshot(), Snapshot{}}); }
+
+void ModuleAllocationMonitor::stop(unsigned int const moduleID, Phase const phase) {
+  if (frames.empty())
+    return;
+  Snapshot const now = snapshot();
+  Frame const frame = frames.back();
+  frames.pop_back();
+
+  Snapshot const total{now.allocated - frame.start.allocated, now.deallocated - frame.start.deallocated};
+  if (not frames.empty()) {
+    frames.back().nested.allocated += total.allocated;
+    frames.back().nested.deallocated += total.deallocated;
+  }
+
+  if (moduleID < modules_.size() and modules_[moduleID]) {
+    modules_[moduleID]->phases[static_cast<unsigned>(phase)].update(total.allocated - frame.nested.allocated,
+                                                                     total.deallocated - frame.nested.deallocated);
+  }
+}
+
+void ModuleAllocationMonitor::postEndJob() {
+  // collect all the module transitions that allocated any memory, largest first
+  std::vector<std::pair<ModuleAllocations const*, unsigned>> entries;
+  for (auto const& module : modules_) {
+    if (not module)
+      continue;
+    for (unsigned i = 0; i < nPhases; ++i) {
+      if (module->phases[i].allocated() > 0)
+        entries.emplace_back(module.get(), i);
+    }
+  }
+  std::sort(entries.begin(), entries.end(), [](auto const& a, auto const& b) {
+    return a.first->phases[a.second].allocated() > b.first->phases[b.second].allocated();
+  });
+  if (reportedModules_ > 0 and entries.size() > reportedModules_) {
+    entries.resize(reportedModules_);
+  }
+
+  std::size_t width{};
+  for (auto const& entry : entries) {
+    width = std::max(width, entry.first->label.size());
+  }
+
+  OStreamColumn tag{"ModuleAllocationMonitor>"};
+  OStreamColumn col1{"Module label", width};
+  OStreamColumn col2{"Transition", 10};
+  OStreamColumn col3{"# of calls"};
+  OStreamColumn col4{"Total allocated"};
+  OStreamColumn col5{"Avg allocated"};
+  OStreamColumn col6{"Max allocated"};
+  OStreamColumn col7{"Total retained"};
+  OStreamColumn col8{"Max retained"};
+
+  LogAbsolute out{"ModuleAllocationMonitor"};
+  out << '\n';
+  out << tag << space << col1 << space << col2 << space << col3 << space << col4 << space << col5 << space << col6
+      << space << col7 << space << col8 << '\n';
+
+  out << tag << space << std::setfill('-') << col1(std::string{}) << space << col2(std::string{}) << space
+      << col3(std::string{}) << space << col4(std::string{}) << space << col5(std::string{}) << space
+      << col6(std::string{}) << space << col7(std::string{}) << space << col8(std::string{}) << '\n';
+
+  out << std::setfill(' ');
+  for (auto const& entry : entries) {
+    auto const& stats = entry.first->phases[entry.second];
+    double const allocated = stats.allocated();
+    double const retained = allocated - static_cast<double>(stats.deallocated());
+    out << std::left << tag << space << col1(entry.first->label) << space << col2(phaseNames[entry.second]) << space
+        << std::right << col3(stats.calls()) << space << col4(toMegabytes(allocated)) << space
+        << col5(toMegabytes(allocated / stats.calls())) << space << col6(toMegabytes(stats.maxAllocated())) << space
+        << col7(toMegabytes(retained)) << space << col8(toMegabytes(stats.maxRetained())) << '\n';
+  }
+}
+
+DEFINE_FWK_SERVICE(ModuleAllocationMonitor);
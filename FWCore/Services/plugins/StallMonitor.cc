@@ -20,6 +20,8 @@
 #include "FWCore/ServiceRegistry/interface/StreamContext.h"
 #include "FWCore/ServiceRegistry/interface/GlobalContext.h"
 #include "FWCore/ServiceRegistry/interface/ModuleCallingContext.h"
+#include "FWCore/ServiceRegistry/interface/PathsAndConsumesOfModulesBase.h"
+#include "FWCore/ServiceRegistry/interface/ProcessContext.h"
 #include "FWCore/ServiceRegistry/interface/SystemBounds.h"
 #include "FWCore/Utilities/interface/Algorithms.h"
 #include "FWCore/Utilities/interface/OStreamColumn.h"
@@ -27,6 +29,7 @@
 
 #include "tbb/concurrent_unordered_map.h"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <iomanip>
@@ -78,6 +81,30 @@ namespace {
     std::atomic<rep_t> maxTime_{};
   };
 
+  //===============================================================
+  // How much each module contributes to the critical path of the
+  // events, i.e. the longest chain of modules that wait for each
+  // other's products, compared to the total time it runs.
+  class CriticalPathStatistics {
+  public:
+    using rep_t = duration_t::rep;
+
+    unsigned numberOfCriticalEvents() const { return criticalCounter_; }
+    duration_t totalCriticalTime() const { return duration_t{criticalTime_.load()}; }
+    duration_t totalRunningTime() const { return duration_t{runningTime_.load()}; }
+
+    void addRunning(duration_t const d) { runningTime_ += d.count(); }
+    void addCritical(duration_t const d) {
+      ++criticalCounter_;
+      criticalTime_ += d.count();
+    }
+
+  private:
+    std::atomic<unsigned> criticalCounter_{};
+    std::atomic<rep_t> criticalTime_{};
+    std::atomic<rep_t> runningTime_{};
+  };
+
   //===============================================================
   // Message-assembly utilities
   template <typename T>
@@ -197,6 +224,7 @@ namespace edm {
 
     private:
       void preModuleConstruction(edm::ModuleDescription const&);
+      void preBeginJob(PathsAndConsumesOfModulesBase const&, ProcessContext const&);
       void postBeginJob();
       void preSourceEvent(StreamID);
       void postSourceEvent(StreamID);
@@ -215,6 +243,9 @@ namespace edm {
       void postModuleGlobalTransition(GlobalContext const&, ModuleCallingContext const&);
       void postEndJob();
 
+      void analyzeCriticalPath(StreamContext const&);
+      void printCriticalPathSummary() const;
+
       ThreadSafeOutputFileStream file_;
       bool const validFile_;  // Separate data member from file to improve efficiency.
       duration_t const stallThreshold_;
@@ -232,6 +263,23 @@ namespace edm {
       std::vector<std::string> moduleLabels_{};
       std::vector<StallStatistics> moduleStats_{};
       unsigned int numStreams_;
+
+      // Critical-path analysis: for each module, the modules whose
+      // products it consumes or that precede it on a Path; and, for
+      // each stream, when each module started and stopped running in
+      // the current event.
+      struct ModuleTiming {
+        decltype(beginTime_) start{};
+        decltype(beginTime_) end{};
+      };
+      bool const criticalPath_;
+      std::vector<std::vector<ModuleID>> dependencies_{};
+      std::vector<decltype(beginTime_)> eventStart_{};
+      std::vector<std::vector<ModuleTiming>> moduleTimings_{};
+      std::vector<CriticalPathStatistics> criticalPathStats_{};
+      std::atomic<unsigned> criticalPathEvents_{};
+      std::atomic<duration_t::rep> totalEventTime_{};
+      std::atomic<duration_t::rep> totalCriticalPathTime_{};
     };
 
   }  // namespace service
@@ -251,7 +299,8 @@ StallMonitor::StallMonitor(ParameterSet const& iPS, ActivityRegistry& iRegistry)
     : file_{iPS.getUntrackedParameter<std::string>("fileName", filename_default)},
       validFile_{file_},
       stallThreshold_{
-          std::chrono::round<duration_t>(duration<double>(iPS.getUntrackedParameter<double>("stallThreshold")))} {
+          std::chrono::round<duration_t>(duration<double>(iPS.getUntrackedParameter<double>("stallThreshold")))},
+      criticalPath_{iPS.getUntrackedParameter<bool>("criticalPathSummary")} {
   iRegistry.watchPreModuleConstruction(this, &StallMonitor::preModuleConstruction);
   iRegistry.watchPostBeginJob(this, &StallMonitor::postBeginJob);
   iRegistry.watchPostModuleEventPrefetching(this, &StallMonitor::postModuleEventPrefetching);
@@ -259,16 +308,25 @@ StallMonitor::StallMonitor(ParameterSet const& iPS, ActivityRegistry& iRegistry)
   iRegistry.watchPreModuleEvent(this, &StallMonitor::preModuleEvent);
   iRegistry.watchPostEndJob(this, &StallMonitor::postEndJob);
 
+  if (validFile_ or criticalPath_) {
+    iRegistry.watchPreEvent(this, &StallMonitor::preEvent);
+    iRegistry.watchPostModuleEvent(this, &StallMonitor::postModuleEvent);
+    iRegistry.watchPostEvent(this, &StallMonitor::postEvent);
+    iRegistry.preallocateSignal_.connect(
+        [this](service::SystemBounds const& iBounds) { numStreams_ = iBounds.maxNumberOfStreams(); });
+  }
+
+  if (criticalPath_) {
+    iRegistry.watchPreBeginJob(this, &StallMonitor::preBeginJob);
+  }
+
   if (validFile_) {
     // Only enable the following callbacks if writing to a file.
     iRegistry.watchPreSourceEvent(this, &StallMonitor::preSourceEvent);
     iRegistry.watchPostSourceEvent(this, &StallMonitor::postSourceEvent);
-    iRegistry.watchPreEvent(this, &StallMonitor::preEvent);
     iRegistry.watchPostModuleEventAcquire(this, &StallMonitor::postModuleEventAcquire);
     iRegistry.watchPreEventReadFromSource(this, &StallMonitor::preEventReadFromSource);
     iRegistry.watchPostEventReadFromSource(this, &StallMonitor::postEventReadFromSource);
-    iRegistry.watchPostModuleEvent(this, &StallMonitor::postModuleEvent);
-    iRegistry.watchPostEvent(this, &StallMonitor::postEvent);
 
     iRegistry.watchPreModuleStreamBeginRun(this, &StallMonitor::preModuleStreamTransition);
     iRegistry.watchPostModuleStreamBeginRun(this, &StallMonitor::postModuleStreamTransition);
@@ -294,9 +352,6 @@ StallMonitor::StallMonitor(ParameterSet const& iPS, ActivityRegistry& iRegistry)
     iRegistry.watchPreModuleWriteLumi(this, &StallMonitor::preModuleGlobalTransition);
     iRegistry.watchPostModuleWriteLumi(this, &StallMonitor::postModuleGlobalTransition);
 
-    iRegistry.preallocateSignal_.connect(
-        [this](service::SystemBounds const& iBounds) { numStreams_ = iBounds.maxNumberOfStreams(); });
-
     std::ostringstream oss;
     oss << "# Transition       Symbol\n";
     oss << "#----------------- ------\n";
@@ -347,6 +402,15 @@ void StallMonitor::fillDescriptions(ConfigurationDescriptions& descriptions) {
       ->setComment(
           "Threshold (in seconds) used to classify modules as stalled.\n"
           "Microsecond granularity allowed.");
+  desc.addUntracked<bool>("criticalPathSummary", false)
+      ->setComment(
+          "Reconstruct, for each event, the critical path through the modules of the\n"
+          "main process, following the consumes and Path dependencies, and summarise at\n"
+          "the end of the job how much of the event wall time each module accounts for,\n"
+          "compared to the total time it runs.\n"
+          "The critical path time is the sum of the run times of the modules on the path;\n"
+          "the time between a module finishing and the next one on the path starting\n"
+          "(e.g. waiting for a free thread) is not included.");
   descriptions.add("StallMonitor", desc);
   descriptions.setComment(
       "This service keeps track of various times in event-processing to determine which modules are stalling.");
@@ -373,6 +437,32 @@ void StallMonitor::preModuleConstruction(ModuleDescription const& md) {
   }
 }
 
+void StallMonitor::preBeginJob(PathsAndConsumesOfModulesBase const& pathsAndConsumes, ProcessContext const& pc) {
+  // Only the modules of the main process are analysed.
+  if (pc.isSubProcess())
+    return;
+
+  dependencies_.resize(moduleLabels_.size());
+  for (auto const* md : pathsAndConsumes.allModules()) {
+    for (auto const* dependency : pathsAndConsumes.modulesWhoseProductsAreConsumedBy(md->id())) {
+      dependencies_[md->id()].push_back(dependency->id());
+    }
+  }
+  // The modules on a Path run one after the other.
+  for (unsigned int i = 0; i < pathsAndConsumes.paths().size(); ++i) {
+    auto const& modules = pathsAndConsumes.modulesOnPath(i);
+    for (std::size_t j = 1; j < modules.size(); ++j) {
+      dependencies_[modules[j]->id()].push_back(modules[j - 1]->id());
+    }
+  }
+  for (unsigned int i = 0; i < pathsAndConsumes.endPaths().size(); ++i) {
+    auto const& modules = pathsAndConsumes.modulesOnEndPath(i);
+    for (std::size_t j = 1; j < modules.size(); ++j) {
+      dependencies_[modules[j]->id()].push_back(modules[j - 1]->id());
+    }
+  }
+}
+
 void StallMonitor::postBeginJob() {
   // Since a (push,emplace)_back cannot be called for a vector of a
   // type containing atomics (like 'StallStatistics')--i.e. atomics
@@ -383,6 +473,12 @@ void StallMonitor::postBeginJob() {
     moduleStats_[i].setLabel(moduleLabels_[i]);
   }
 
+  if (criticalPath_) {
+    criticalPathStats_ = std::vector<CriticalPathStatistics>(moduleLabels_.size());
+    eventStart_.resize(numStreams_);
+    moduleTimings_.assign(numStreams_, std::vector<ModuleTiming>(moduleLabels_.size()));
+  }
+
   if (validFile_) {
     std::size_t const width{std::to_string(moduleLabels_.size()).size()};
 
@@ -422,7 +518,15 @@ void StallMonitor::postSourceEvent(StreamID const sid) {
 }
 
 void StallMonitor::preEvent(StreamContext const& sc) {
-  auto const t = duration_cast<duration_t>(now() - beginTime_).count();
+  auto const preEvent = now();
+  if (criticalPath_ and not sc.processContext()->isSubProcess()) {
+    auto const sid = stream_id(sc);
+    eventStart_[sid] = preEvent;
+    std::fill(moduleTimings_[sid].begin(), moduleTimings_[sid].end(), ModuleTiming{});
+  }
+  if (not validFile_)
+    return;
+  auto const t = duration_cast<duration_t>(preEvent - beginTime_).count();
   auto const& eid = sc.eventID();
   auto msg = assembleMessage<step::preEvent>(stream_id(sc), eid.run(), eid.luminosityBlock(), eid.event(), t);
   file_.write(std::move(msg));
@@ -447,6 +551,9 @@ void StallMonitor::preModuleEventAcquire(StreamContext const& sc, ModuleCallingC
   auto& start = stallStart_[std::make_pair(sid, mid)];
   auto startT = start.first.time_since_epoch();
   start.second = true;  // record so the preModuleEvent knows that acquire was called
+  if (criticalPath_) {
+    moduleTimings_[sid][mid].start = preModEventAcquire;
+  }
   if (validFile_) {
     auto t = duration_cast<duration_t>(preModEventAcquire - beginTime_).count();
     auto msg = assembleMessage<step::preModuleEventAcquire>(sid, mid, t);
@@ -473,6 +580,12 @@ void StallMonitor::preModuleEvent(StreamContext const& sc, ModuleCallingContext
   auto const mid = module_id(mcc);
   auto const& start = stallStart_[std::make_pair(sid, mid)];
   auto startT = start.first.time_since_epoch();
+  if (criticalPath_) {
+    // for modules with an acquire step, count from the start of acquire
+    auto& timing = moduleTimings_[sid][mid];
+    if (timing.start.time_since_epoch() == duration_t::duration::zero())
+      timing.start = preModEvent;
+  }
   if (validFile_) {
     auto t = duration_cast<duration_t>(preModEvent - beginTime_).count();
     auto msg =
@@ -528,19 +641,87 @@ void StallMonitor::postEventReadFromSource(StreamContext const& sc, ModuleCallin
 }
 
 void StallMonitor::postModuleEvent(StreamContext const& sc, ModuleCallingContext const& mcc) {
-  auto const postModEvent = duration_cast<duration_t>(now() - beginTime_).count();
+  auto const tNow = now();
+  if (criticalPath_) {
+    moduleTimings_[stream_id(sc)][module_id(mcc)].end = tNow;
+  }
+  if (not validFile_)
+    return;
+  auto const postModEvent = duration_cast<duration_t>(tNow - beginTime_).count();
   auto msg = assembleMessage<step::postModuleEvent>(
       stream_id(sc), module_id(mcc), static_cast<std::underlying_type_t<Phase>>(Phase::Event), postModEvent);
   file_.write(std::move(msg));
 }
 
 void StallMonitor::postEvent(StreamContext const& sc) {
+  if (criticalPath_ and not sc.processContext()->isSubProcess()) {
+    analyzeCriticalPath(sc);
+  }
+  if (not validFile_)
+    return;
   auto const t = duration_cast<duration_t>(now() - beginTime_).count();
   auto const& eid = sc.eventID();
   auto msg = assembleMessage<step::postEvent>(stream_id(sc), eid.run(), eid.luminosityBlock(), eid.event(), t);
   file_.write(std::move(msg));
 }
 
+void StallMonitor::analyzeCriticalPath(StreamContext const& sc) {
+  auto const sid = stream_id(sc);
+  auto const& timings = moduleTimings_[sid];
+  auto const hasRun = [](ModuleTiming const& timing) {
+    return timing.end.time_since_epoch() != duration_t::duration::zero();
+  };
+
+  // Accumulate the running time of all modules, and find the last one to finish.
+  ModuleID last{};
+  bool found{false};
+  for (ModuleID mid{}; mid < timings.size(); ++mid) {
+    auto const& timing = timings[mid];
+    if (not hasRun(timing))
+      continue;
+    criticalPathStats_[mid].addRunning(duration_cast<duration_t>(timing.end - timing.start));
+    if (not found or timing.end > timings[last].end) {
+      last = mid;
+      found = true;
+    }
+  }
+  if (not found)
+    return;
+
+  // Walk back from the last module to finish: each module on the critical path
+  // was waiting for whichever of its dependencies finished last before it started.
+  // Only the run times of these modules are summed, the gaps between them are not.
+  duration_t critical{};
+  ModuleID current = last;
+  while (true) {
+    auto const& timing = timings[current];
+    auto const d = duration_cast<duration_t>(timing.end - timing.start);
+    criticalPathStats_[current].addCritical(d);
+    critical += d;
+
+    bool hasPredecessor{false};
+    ModuleID predecessor{};
+    if (current < dependencies_.size()) {
+      for (auto const dependency : dependencies_[current]) {
+        auto const& previous = timings[dependency];
+        if (not hasRun(previous) or previous.end > timing.start)
+          continue;
+        if (not hasPredecessor or previous.end > timings[predecessor].end) {
+          predecessor = dependency;
+          hasPredecessor = true;
+        }
+      }
+    }
+    if (not hasPredecessor)
+      break;
+    current = predecessor;
+  }
+
+  ++criticalPathEvents_;
+  totalEventTime_ += duration_cast<duration_t>(timings[last].end - eventStart_[sid]).count();
+  totalCriticalPathTime_ += critical.count();
+}
+
 void StallMonitor::postEndJob() {
   // Prepare summary
   std::size_t width{};
@@ -581,6 +762,63 @@ void StallMonitor::postEndJob() {
         << space << col3(to_seconds_str(stats.totalStalledTime())) << space
         << col4(to_seconds_str(stats.maxStalledTime())) << '\n';
   }
+
+  if (criticalPath_) {
+    printCriticalPathSummary();
+  }
+}
+
+void StallMonitor::printCriticalPathSummary() const {
+  // Rank the modules by the time they spend on the critical path.
+  std::vector<std::size_t> order;
+  std::size_t width{};
+  for (std::size_t i{}; i < criticalPathStats_.size(); ++i) {
+    if (moduleStats_[i].label().empty() or criticalPathStats_[i].numberOfCriticalEvents() == 0u)
+      continue;
+    order.push_back(i);
+    width = std::max(width, moduleStats_[i].label().size());
+  }
+  std::sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) {
+    return criticalPathStats_[a].totalCriticalTime() > criticalPathStats_[b].totalCriticalTime();
+  });
+
+  using seconds_d = duration<double>;
+  auto to_seconds_str = [](auto const& duration) {
+    std::ostringstream oss;
+    auto const time = duration_cast<seconds_d>(duration).count();
+    oss << time << " s";
+    return oss.str();
+  };
+
+  OStreamColumn tag{"StallMonitor>"};
+  OStreamColumn col1{"Module label", width};
+  OStreamColumn col2{"# on critical path"};
+  OStreamColumn col3{"Critical path time"};
+  OStreamColumn col4{"Running time"};
+  OStreamColumn col5{"Critical fraction"};
+
+  LogAbsolute out{"StallMonitor"};
+  out << '\n';
+  out << tag << space << "Critical path over " << criticalPathEvents_ << " events: "
+      << to_seconds_str(duration_t{totalCriticalPathTime_.load()}) << " out of "
+      << to_seconds_str(duration_t{totalEventTime_.load()})
+      << " of event wall time (module run times only, excluding the waits between them)\n";
+  out << tag << space << col1 << space << col2 << space << col3 << space << col4 << space << col5 << '\n';
+
+  out << tag << space << std::setfill('-') << col1(std::string{}) << space << col2(std::string{}) << space
+      << col3(std::string{}) << space << col4(std::string{}) << space << col5(std::string{}) << '\n';
+
+  out << std::setfill(' ');
+  for (auto const i : order) {
+    auto const& stats = criticalPathStats_[i];
+    auto const running = stats.totalRunningTime().count();
+    std::ostringstream fraction;
+    fraction << std::fixed << std::setprecision(2)
+             << (running > 0 ? double(stats.totalCriticalTime().count()) / running : 0.);
+    out << std::left << tag << space << col1(moduleStats_[i].label()) << space << std::right
+        << col2(stats.numberOfCriticalEvents()) << space << col3(to_seconds_str(stats.totalCriticalTime())) << space
+        << col4(to_seconds_str(stats.totalRunningTime())) << space << col5(fraction.str()) << '\n';
+  }
 }
 
 DEFINE_FWK_SERVICE(StallMonitor);
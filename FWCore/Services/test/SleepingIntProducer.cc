@@ -0,0 +1,56 @@
+// -*- C++ -*-
+//
+// Package:     FWCore/Services
+// Class  :     SleepingIntProducer
+//
+// Implementation:
+//     Consumes the IntProducts of the given modules and sleeps for a fixed
+//     time before putting their sum, to build chains of modules of known
+//     duration for the StallMonitor critical path test.
+//
+
+#include "DataFormats/TestObjects/interface/ToyProducts.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "FWCore/Utilities/interface/transform.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+class SleepingIntProducer : public edm::global::EDProducer<> {
+public:
+  explicit SleepingIntProducer(edm::ParameterSet const& p)
+      : tokens_{edm::vector_transform(p.getParameter<std::vector<edm::InputTag>>("srcs"),
+                                      [this](edm::InputTag const& tag) { return consumes<edmtest::IntProduct>(tag); })},
+        putToken_{produces<edmtest::IntProduct>()},
+        sleep_{p.getParameter<unsigned int>("milliseconds")} {}
+
+  void produce(edm::StreamID, edm::Event& e, edm::EventSetup const&) const override {
+    int value = 1;
+    for (auto const& token : tokens_) {
+      value += e.get(token).value;
+    }
+    std::this_thread::sleep_for(sleep_);
+    e.emplace(putToken_, value);
+  }
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+    edm::ParameterSetDescription desc;
+    desc.add<std::vector<edm::InputTag>>("srcs", {});
+    desc.add<unsigned int>("milliseconds", 0);
+    descriptions.addDefault(desc);
+  }
+
+private:
+  std::vector<edm::EDGetTokenT<edmtest::IntProduct>> const tokens_;
+  edm::EDPutTokenT<edmtest::IntProduct> const putToken_;
+  std::chrono::milliseconds const sleep_;
+};
+
+DEFINE_FWK_MODULE(SleepingIntProducer);
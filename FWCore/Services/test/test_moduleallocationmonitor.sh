@@ -0,0 +1,13 @@
+#!/bin/bash
+
+set -o pipefail
+
+# Pass in name and status
+function die { echo $1: status $2 ;  exit $2; }
+
+F1=${LOCAL_TEST_DIR}/test_moduleallocationmonitor_cfg.py
+
+(cmsRun $F1 2>&1 | tee moduleallocationmonitor.log) || die "Failure using $F1" $?
+# cmsRun runs with jemalloc, so the service must not have been disabled
+grep -q "requires jemalloc" moduleallocationmonitor.log && die "jemalloc statistics not available using $F1" 1
+grep -q "ModuleAllocationMonitor>.*thing" moduleallocationmonitor.log || die "No allocation summary using $F1" 1
@@ -0,0 +1,15 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TEST")
+
+process.source = cms.Source("EmptySource")
+
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(10))
+
+process.thing = cms.EDProducer("ThingProducer")
+process.otherThing = cms.EDProducer("OtherThingProducer")
+
+process.p = cms.Path(process.thing + process.otherThing)
+
+process.add_(cms.Service("ModuleAllocationMonitor",
+                         reportedModules = cms.untracked.uint32(5)))
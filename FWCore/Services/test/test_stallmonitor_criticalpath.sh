@@ -0,0 +1,19 @@
+#!/bin/bash
+
+set -o pipefail
+
+# Pass in name and status
+function die { echo $1: status $2 ;  exit $2; }
+
+F1=${LOCAL_TEST_DIR}/test_stallmonitor_criticalpath_cfg.py
+
+(cmsRun $F1 2>&1 | tee stallmonitor_criticalpath.log) || die "Failure using $F1" $?
+sed -n '/Critical path over/,$p' stallmonitor_criticalpath.log > stallmonitor_criticalpath_summary.log
+grep -q "Critical path over 10 events" stallmonitor_criticalpath_summary.log || die "No critical path summary using $F1" 1
+# every module of the chain is on the critical path of every event
+for module in chainA chainB chainC sum; do
+  grep -q -E "^StallMonitor> +$module +10 " stallmonitor_criticalpath_summary.log || die "$module not on the critical path using $F1" 1
+done
+# the module running concurrently with the chain never is
+grep -q -E "^StallMonitor> +side " stallmonitor_criticalpath_summary.log && die "side on the critical path using $F1" 1
+exit 0
@@ -0,0 +1,24 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TEST")
+
+process.source = cms.Source("EmptySource")
+
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(10))
+process.options = cms.untracked.PSet(numberOfThreads = cms.untracked.uint32(4),
+                                     numberOfStreams = cms.untracked.uint32(1))
+
+# chainA -> chainB -> chainC -> sum is the critical path; side runs
+# concurrently with the chain and is consumed by sum as well, but
+# finishes long before chainC
+process.chainA = cms.EDProducer("SleepingIntProducer", milliseconds = cms.uint32(50))
+process.chainB = cms.EDProducer("SleepingIntProducer", srcs = cms.VInputTag("chainA"), milliseconds = cms.uint32(50))
+process.chainC = cms.EDProducer("SleepingIntProducer", srcs = cms.VInputTag("chainB"), milliseconds = cms.uint32(50))
+process.side = cms.EDProducer("SleepingIntProducer", milliseconds = cms.uint32(10))
+process.sum = cms.EDProducer("SleepingIntProducer", srcs = cms.VInputTag("chainC", "side"), milliseconds = cms.uint32(10))
+
+process.t = cms.Task(process.chainA, process.chainB, process.chainC, process.side)
+process.p = cms.Path(process.sum, process.t)
+
+process.add_(cms.Service("StallMonitor",
+                         criticalPathSummary = cms.untracked.bool(True)))
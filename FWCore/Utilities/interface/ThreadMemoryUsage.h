@@ -0,0 +1,27 @@
+#ifndef FWCore_Utilities_ThreadMemoryUsage_h
+#define FWCore_Utilities_ThreadMemoryUsage_h
+
+// -*- C++ -*-
+//
+// Package:     Utilities
+// Class  :     ThreadMemoryUsage
+//
+// ------------------ per-thread memory statistics -----------------------
+//
+// The number of bytes allocated and deallocated so far by the current thread,
+// read from the per-thread counters kept by jemalloc. They are available only
+// when the job runs with a jemalloc built with --enable-stats, as cmsRun does
+// by default; otherwise they are always zero.
+
+#include <cstdint>
+
+namespace edm {
+  class ThreadMemoryUsage {
+  public:
+    static bool isAvailable();
+    static std::uint64_t allocated();
+    static std::uint64_t deallocated();
+  };
+}  // namespace edm
+
+#endif
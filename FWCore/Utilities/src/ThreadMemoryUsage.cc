@@ -0,0 +1,64 @@
+// -*- C++ -*-
+//
+// Package:     Utilities
+// Class  :     ThreadMemoryUsage
+//
+
+#include "FWCore/Utilities/interface/ThreadMemoryUsage.h"
+
+#include <cstddef>
+
+#include <dlfcn.h>
+
+namespace {
+
+  // see <jemalloc/jemalloc.h>
+  using mallctl_t = int (*)(char const* name, void* oldp, std::size_t* oldlenp, void* newp, std::size_t newlen);
+
+  mallctl_t findMallctl() {
+    // check if mallctl is available, i.e. if we are using jemalloc
+    auto mallctl = reinterpret_cast<mallctl_t>(::dlsym(RTLD_DEFAULT, "mallctl"));
+    if (mallctl == nullptr)
+      return nullptr;
+
+    // check if the statistics are available, i.e. if --enable-stats was specified at build time
+    bool stats = false;
+    std::size_t size = sizeof(bool);
+    if (mallctl("config.stats", &stats, &size, nullptr, 0) != 0 or not stats)
+      return nullptr;
+    return mallctl;
+  }
+
+  mallctl_t mallctl() {
+    static mallctl_t const function = findMallctl();
+    return function;
+  }
+
+  std::uint64_t const zero = 0;
+
+  // pointer to one of the thread-specific allocation statistics, or to zero
+  std::uint64_t const* threadCounter(char const* name) {
+    std::uint64_t const* counter = &zero;
+    std::size_t size = sizeof(counter);
+    if (mallctl() != nullptr)
+      mallctl()(name, &counter, &size, nullptr, 0);
+    return counter;
+  }
+
+}  // namespace
+
+namespace edm {
+
+  bool ThreadMemoryUsage::isAvailable() { return mallctl() != nullptr; }
+
+  std::uint64_t ThreadMemoryUsage::allocated() {
+    thread_local std::uint64_t const* const counter = threadCounter("thread.allocatedp");
+    return *counter;
+  }
+
+  std::uint64_t ThreadMemoryUsage::deallocated() {
+    thread_local std::uint64_t const* const counter = threadCounter("thread.deallocatedp");
+    return *counter;
+  }
+
+}  // namespace edm
@@ -46,10 +46,21 @@ def customiseFor2017DtUnpacking(process):
 
     return process
 
+def customiseForCkfSeedsPerParallelChunk(process):
+    """Build the seeds of the CKF track candidate makers one at a time,
+    as before the seedsPerParallelChunk parameter was introduced"""
+
+    for producer in producers_by_type(process, "CkfTrackCandidateMaker", "CkfTrajectoryMaker"):
+        if not hasattr(producer, "seedsPerParallelChunk"):
+            producer.seedsPerParallelChunk = cms.uint32(0)
+
+    return process
+
 # CMSSW version specific customizations
 def customizeHLTforCMSSW(process, menuType="GRun"):
 
     # add call to action function in proper order: newest last!
     # process = customiseFor12718(process)
+    process = customiseForCkfSeedsPerParallelChunk(process)
 
     return process
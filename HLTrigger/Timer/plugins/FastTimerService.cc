@@ -28,10 +28,10 @@
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 #include "FWCore/Utilities/interface/StreamID.h"
+#include "FWCore/Utilities/interface/ThreadMemoryUsage.h"
 #include "FastTimerService.h"
 
 // local headers
-#include "memory_usage.h"
 #include "processor_model.h"
 
 using namespace std::literals;
@@ -271,8 +271,8 @@ void FastTimerService::Measurement::measure() noexcept {
 #endif  // DEBUG_THREAD_CONCURRENCY
   time_thread = boost::chrono::thread_clock::now();
   time_real = boost::chrono::high_resolution_clock::now();
-  allocated = memory_usage::allocated();
-  deallocated = memory_usage::deallocated();
+  allocated = edm::ThreadMemoryUsage::allocated();
+  deallocated = edm::ThreadMemoryUsage::deallocated();
 }
 
 void FastTimerService::Measurement::measure_and_store(Resources& store) noexcept {
@@ -281,8 +281,8 @@ void FastTimerService::Measurement::measure_and_store(Resources& store) noexcept
 #endif  // DEBUG_THREAD_CONCURRENCY
   auto new_time_thread = boost::chrono::thread_clock::now();
   auto new_time_real = boost::chrono::high_resolution_clock::now();
-  auto new_allocated = memory_usage::allocated();
-  auto new_deallocated = memory_usage::deallocated();
+  auto new_allocated = edm::ThreadMemoryUsage::allocated();
+  auto new_deallocated = edm::ThreadMemoryUsage::deallocated();
   store.time_thread = new_time_thread - time_thread;
   store.time_real = new_time_real - time_real;
   store.allocated = new_allocated - allocated;
@@ -299,8 +299,8 @@ void FastTimerService::Measurement::measure_and_accumulate(Resources& store) noe
 #endif  // DEBUG_THREAD_CONCURRENCY
   auto new_time_thread = boost::chrono::thread_clock::now();
   auto new_time_real = boost::chrono::high_resolution_clock::now();
-  auto new_allocated = memory_usage::allocated();
-  auto new_deallocated = memory_usage::deallocated();
+  auto new_allocated = edm::ThreadMemoryUsage::allocated();
+  auto new_deallocated = edm::ThreadMemoryUsage::deallocated();
   store.time_thread += new_time_thread - time_thread;
   store.time_real += new_time_real - time_real;
   store.allocated += new_allocated - allocated;
@@ -317,8 +317,8 @@ void FastTimerService::Measurement::measure_and_accumulate(AtomicResources& stor
 #endif  // DEBUG_THREAD_CONCURRENCY
   auto new_time_thread = boost::chrono::thread_clock::now();
   auto new_time_real = boost::chrono::high_resolution_clock::now();
-  auto new_allocated = memory_usage::allocated();
-  auto new_deallocated = memory_usage::deallocated();
+  auto new_allocated = edm::ThreadMemoryUsage::allocated();
+  auto new_deallocated = edm::ThreadMemoryUsage::deallocated();
   store.time_thread += boost::chrono::duration_cast<boost::chrono::nanoseconds>(new_time_thread - time_thread).count();
   store.time_real += boost::chrono::duration_cast<boost::chrono::nanoseconds>(new_time_real - time_real).count();
   store.allocated += new_allocated - allocated;
@@ -351,7 +351,7 @@ void FastTimerService::PlotsPerElement::book(dqm::reco::DQMStore::ConcurrentBook
   time_real_.setXTitle("processing time [ms]");
   time_real_.setYTitle(y_title_ms.c_str());
 
-  if (memory_usage::is_available()) {
+  if (edm::ThreadMemoryUsage::isAvailable()) {
     allocated_ = booker.book1D(name + " allocated", title + " allocated memory", mem_bins, 0., ranges.memory_range);
     allocated_.setXTitle("memory [kB]");
     allocated_.setYTitle(y_title_kB.c_str());
@@ -389,7 +389,7 @@ void FastTimerService::PlotsPerElement::book(dqm::reco::DQMStore::ConcurrentBook
   time_real_byls_.setXTitle("lumisection");
   time_real_byls_.setYTitle("processing time [ms]");
 
-  if (memory_usage::is_available()) {
+  if (edm::ThreadMemoryUsage::isAvailable()) {
     allocated_byls_ = booker.bookProfile(name + " allocated_byls",
                                          title + " allocated memory vs. lumisection",
                                          lumisections,
@@ -538,7 +538,7 @@ void FastTimerService::PlotsPerPath::book(dqm::reco::DQMStore::ConcurrentBooker&
   module_time_real_total_ =
       booker.book1DD("module_time_real_total", "total module time (real)", bins, -0.5, bins - 0.5);
   module_time_real_total_.setYTitle("processing time [ms]");
-  if (memory_usage::is_available()) {
+  if (edm::ThreadMemoryUsage::isAvailable()) {
     module_allocated_total_ =
         booker.book1DD("module_allocated_total", "total allocated memory", bins, -0.5, bins - 0.5);
     module_allocated_total_.setYTitle("memory [kB]");
@@ -553,7 +553,7 @@ void FastTimerService::PlotsPerPath::book(dqm::reco::DQMStore::ConcurrentBooker&
     module_counter_.setBinLabel(bin + 1, label);
     module_time_thread_total_.setBinLabel(bin + 1, label);
     module_time_real_total_.setBinLabel(bin + 1, label);
-    if (memory_usage::is_available()) {
+    if (edm::ThreadMemoryUsage::isAvailable()) {
       module_allocated_total_.setBinLabel(bin + 1, label);
       module_deallocated_total_.setBinLabel(bin + 1, label);
     }
@@ -154,6 +154,10 @@ namespace edm {
     InputFile::reportReadBranches();
   }
 
+  void PoolSource::setConsumedEventProducts_(std::vector<BranchID> const& branchIDs) {
+    primaryFileSequence_->setConsumedEventProducts(branchIDs);
+  }
+
   std::unique_ptr<FileBlock> PoolSource::readFile_() {
     std::unique_ptr<FileBlock> fb = primaryFileSequence_->readFile_();
     if (secondaryFileSequence_) {
@@ -60,6 +60,7 @@ namespace edm {
     std::unique_ptr<FileBlock> readFile_() override;
     void closeFile_() override;
     void endJob() override;
+    void setConsumedEventProducts_(std::vector<BranchID> const& branchIDs) override;
     bool readIt(EventID const& id, EventPrincipal& eventPrincipal, StreamContext& streamContext) override;
     void skip(int offset) override;
     bool goToEvent_(EventID const& eventID) override;
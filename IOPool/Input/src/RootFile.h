@@ -258,6 +258,9 @@ namespace edm {
     IndexIntoFile::IndexIntoFileItr indexIntoFileIter() const;
     void setPosition(IndexIntoFile::IndexIntoFileItr const& position);
     void initAssociationsFromSecondary(std::vector<BranchID> const&);
+    void setConsumedEventBranches(std::vector<BranchID> const& branchIDs) {
+      eventTree_.setConsumedBranches(branchIDs);
+    }
 
     void setSignals(
         signalslot::Signal<void(StreamContext const&, ModuleCallingContext const&)> const* preEventReadSource,
@@ -17,7 +17,19 @@
 #include "FWCore/ServiceRegistry/interface/Service.h"
 #include "Utilities/StorageFactory/interface/StorageFactory.h"
 
+#include "TTreeCacheUnzip.h"
+
 namespace edm {
+  namespace {
+    // TTreeCacheUnzip's default
+    constexpr double defaultUnzipRelativeBufferSize = 0.5;
+
+    // ROOT has no getter for the process wide relative unzip buffer size
+    struct UnzipRelativeBufferSize : private TTreeCacheUnzip {
+      static double get() { return fgRelBuffSize; }
+    };
+  }  // namespace
+
   RootPrimaryFileSequence::RootPrimaryFileSequence(ParameterSet const& pset,
                                                    PoolSource& input,
                                                    InputFileCatalog const& catalog)
@@ -32,7 +44,13 @@ namespace edm {
         treeCacheSize_(noEventSort_ ? pset.getUntrackedParameter<unsigned int>("cacheSize") : 0U),
         duplicateChecker_(new DuplicateChecker(pset)),
         usingGoToEvent_(false),
-        enablePrefetching_(false) {
+        enablePrefetching_(false),
+        treeCacheFromConsumes_(pset.getUntrackedParameter<bool>("treeCacheFromConsumes")),
+        consumedEventProductsKnown_(false),
+        consumedEventProducts_(),
+        parallelUnzip_(pset.getUntrackedParameter<bool>("parallelUnzip")),
+        previousParallelUnzip_(TTreeCacheUnzip::GetParallelUnzip()),
+        previousUnzipRelativeBufferSize_(UnzipRelativeBufferSize::get()) {
     // The SiteLocalConfig controls the TTreeCache size and the prefetching settings.
     Service<SiteLocalConfig> pSLC;
     if (pSLC.isAvailable()) {
@@ -42,6 +60,18 @@ namespace edm {
       enablePrefetching_ = pSLC->enablePrefetching();
     }
 
+    // With parallel unzipping, every TTreeCache created afterwards is a TTreeCacheUnzip.
+    // Once a cluster of entries has been read into the cache, its baskets are decompressed
+    // by background tasks into an unzip buffer whose size is bounded relative to the cache
+    // size, so that RootDelayedReader::getProduct usually finds the basket already unzipped.
+    // These are process wide ROOT settings: they apply to all the files opened in the
+    // job while the source exists, secondary input files included, and are restored
+    // when the source is destroyed.
+    if (parallelUnzip_) {
+      TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+      TTreeCacheUnzip::SetUnzipRelBufferSize(pset.getUntrackedParameter<double>("unzipRelativeBufferSize"));
+    }
+
     std::string branchesMustMatch =
         pset.getUntrackedParameter<std::string>("branchesMustMatch", std::string("permissive"));
     if (branchesMustMatch == std::string("strict"))
@@ -65,7 +95,12 @@ namespace edm {
     }
   }
 
-  RootPrimaryFileSequence::~RootPrimaryFileSequence() {}
+  RootPrimaryFileSequence::~RootPrimaryFileSequence() {
+    if (parallelUnzip_) {
+      TTreeCacheUnzip::SetParallelUnzip(previousParallelUnzip_);
+      TTreeCacheUnzip::SetUnzipRelBufferSize(previousUnzipRelativeBufferSize_);
+    }
+  }
 
   void RootPrimaryFileSequence::endJob() { closeFile_(); }
 
@@ -109,35 +144,51 @@ namespace edm {
 
   RootPrimaryFileSequence::RootFileSharedPtr RootPrimaryFileSequence::makeRootFile(std::shared_ptr<InputFile> filePtr) {
     size_t currentIndexIntoFile = sequenceNumberOfFile();
-    return std::make_shared<RootFile>(fileName(),
-                                      input_.processConfiguration(),
-                                      logicalFileName(),
-                                      filePtr,
-                                      eventSkipperByID(),
-                                      initialNumberOfEventsToSkip_ != 0,
-                                      remainingEvents(),
-                                      remainingLuminosityBlocks(),
-                                      input_.nStreams(),
-                                      treeCacheSize_,
-                                      input_.treeMaxVirtualSize(),
-                                      input_.processingMode(),
-                                      input_.runHelper(),
-                                      noEventSort_,
-                                      input_.productSelectorRules(),
-                                      InputType::Primary,
-                                      input_.branchIDListHelper(),
-                                      input_.thinnedAssociationsHelper(),
-                                      nullptr,  // associationsFromSecondary
-                                      duplicateChecker(),
-                                      input_.dropDescendants(),
-                                      input_.processHistoryRegistryForUpdate(),
-                                      indexesIntoFiles(),
-                                      currentIndexIntoFile,
-                                      orderedProcessHistoryIDs_,
-                                      input_.bypassVersionCheck(),
-                                      input_.labelRawDataLikeMC(),
-                                      usingGoToEvent_,
-                                      enablePrefetching_);
+    auto file = std::make_shared<RootFile>(fileName(),
+                                           input_.processConfiguration(),
+                                           logicalFileName(),
+                                           filePtr,
+                                           eventSkipperByID(),
+                                           initialNumberOfEventsToSkip_ != 0,
+                                           remainingEvents(),
+                                           remainingLuminosityBlocks(),
+                                           input_.nStreams(),
+                                           treeCacheSize_,
+                                           input_.treeMaxVirtualSize(),
+                                           input_.processingMode(),
+                                           input_.runHelper(),
+                                           noEventSort_,
+                                           input_.productSelectorRules(),
+                                           InputType::Primary,
+                                           input_.branchIDListHelper(),
+                                           input_.thinnedAssociationsHelper(),
+                                           nullptr,  // associationsFromSecondary
+                                           duplicateChecker(),
+                                           input_.dropDescendants(),
+                                           input_.processHistoryRegistryForUpdate(),
+                                           indexesIntoFiles(),
+                                           currentIndexIntoFile,
+                                           orderedProcessHistoryIDs_,
+                                           input_.bypassVersionCheck(),
+                                           input_.labelRawDataLikeMC(),
+                                           usingGoToEvent_,
+                                           enablePrefetching_);
+    if (consumedEventProductsKnown_) {
+      file->setConsumedEventBranches(consumedEventProducts_);
+    }
+    return file;
+  }
+
+  void RootPrimaryFileSequence::setConsumedEventProducts(std::vector<BranchID> const& branchIDs) {
+    if (not treeCacheFromConsumes_) {
+      return;
+    }
+    consumedEventProducts_ = branchIDs;
+    consumedEventProductsKnown_ = true;
+    // The first file was opened before the framework knew what is consumed
+    if (rootFile()) {
+      rootFile()->setConsumedEventBranches(consumedEventProducts_);
+    }
   }
 
   bool RootPrimaryFileSequence::nextFile() {
@@ -317,6 +368,20 @@ namespace edm {
             "Note 3: Any sorting occurs independently in each input file (no sorting across input files).");
     desc.addUntracked<unsigned int>("cacheSize", roottree::defaultCacheSize)
         ->setComment("Size of ROOT TTree prefetch cache.  Affects performance.");
+    desc.addUntracked<bool>("treeCacheFromConsumes", false)
+        ->setComment(
+            "True:  Fill the TTree cache with the branches of the products consumed by the modules of the job, "
+            "sized from their baskets in the file, without a learning phase.\n"
+            "False: Learn the branches to cache from the first events read from each file.");
+    desc.addUntracked<bool>("parallelUnzip", false)
+        ->setComment(
+            "True:  Decompress the baskets held in the TTree cache in background tasks ahead of their use. "
+            "This is a job wide ROOT setting, which also applies to the other input files of the job.\n"
+            "False: Decompress each basket on the thread that first reads from it.");
+    desc.addUntracked<double>("unzipRelativeBufferSize", defaultUnzipRelativeBufferSize)
+        ->setComment(
+            "Size of the buffer holding the decompressed baskets, relative to 'cacheSize'. "
+            "Only used if 'parallelUnzip' is True. This is a job wide ROOT setting.");
     std::string defaultString("permissive");
     desc.addUntracked<std::string>("branchesMustMatch", defaultString)
         ->setComment(
@@ -17,6 +17,8 @@ RootPrimaryFileSequence: This is an InputSource
 #include "DataFormats/Provenance/interface/BranchDescription.h"
 #include "DataFormats/Provenance/interface/ProcessHistoryID.h"
 
+#include "TTreeCacheUnzip.h"
+
 #include <memory>
 #include <string>
 #include <vector>
@@ -46,6 +48,7 @@ namespace edm {
     bool skipEvents(int offset);
     bool goToEvent(EventID const& eventID);
     void rewind_();
+    void setConsumedEventProducts(std::vector<BranchID> const& branchIDs);
     static void fillDescription(ParameterSetDescription& desc);
     ProcessingController::ForwardState forwardState() const;
     ProcessingController::ReverseState reverseState() const;
@@ -77,6 +80,13 @@ namespace edm {
     edm::propagate_const<std::shared_ptr<DuplicateChecker>> duplicateChecker_;
     bool usingGoToEvent_;
     bool enablePrefetching_;
+    bool treeCacheFromConsumes_;
+    bool consumedEventProductsKnown_;
+    std::vector<BranchID> consumedEventProducts_;
+    bool parallelUnzip_;
+    // the process wide TTreeCacheUnzip settings in use before parallelUnzip changed them
+    TTreeCacheUnzip::EParUnzipMode previousParallelUnzip_;
+    double previousUnzipRelativeBufferSize_;
   };  // class RootPrimaryFileSequence
 }  // namespace edm
 #endif
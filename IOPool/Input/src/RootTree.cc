@@ -9,6 +9,7 @@
 #include "TTreeCache.h"
 #include "TLeaf.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 
@@ -47,6 +48,8 @@ namespace edm {
         rawTriggerTreeCache_(),
         trainedSet_(),
         triggerSet_(),
+        consumedBranches_(),
+        useConsumedBranches_(false),
         entries_(tree_ ? tree_->GetEntries() : 0),
         entryNumber_(-1),
         entryNumberForIndex_(new std::vector<EntryNumber>(nIndexes, IndexIntoFile::invalidEntry)),
@@ -240,10 +243,14 @@ namespace edm {
     tree_->LoadTree(entryNumber_);
     filePtr_->SetCacheRead(nullptr);
     if (treeCache_ && trainNow_ && entryNumber_ >= 0) {
-      startTraining();
-      trainNow_ = false;
       trainedSet_.clear();
       triggerSet_.clear();
+      if (useConsumedBranches_) {
+        startTrainingFromConsumedBranches();
+      } else {
+        startTraining();
+      }
+      trainNow_ = false;
       rawTriggerSwitchOverEntry_ = -1;
     }
     if (treeCache_ && treeCache_->IsLearning() && switchOverEntry_ >= 0 && entryNumber_ >= switchOverEntry_) {
@@ -430,6 +437,61 @@ namespace edm {
     assert(treeCache_->GetTree() == tree_);
   }
 
+  void RootTree::setConsumedBranches(std::vector<BranchID> const& branchIDs) {
+    consumedBranches_.clear();
+    for (auto const& branchID : branchIDs) {
+      roottree::BranchInfo const* info = branches_.find(branchID);
+      if (info != nullptr and info->productBranch_ != nullptr) {
+        consumedBranches_.push_back(info->productBranch_);
+      }
+    }
+    useConsumedBranches_ = true;
+  }
+
+  void RootTree::startTrainingFromConsumedBranches() {
+    if (cacheSize_ == 0) {
+      return;
+    }
+    assert(branchType_ == InEvent);
+    assert(!rawTreeCache_);
+    TBranch* branchListIndexesBranch = tree_->GetBranch(poolNames::branchListIndexesBranchName().c_str());
+    // Size the cache to hold one cluster of the branches we will read, as measured from their
+    // compressed baskets, rather than using the configured size which is only an upper bound.
+    double zipBytes = auxBranch_->GetZipBytes("*");
+    if (branchListIndexesBranch != nullptr) {
+      zipBytes += branchListIndexesBranch->GetZipBytes("*");
+    }
+    for (TBranch* branch : consumedBranches_) {
+      zipBytes += branch->GetZipBytes("*");
+    }
+    // The 25% margin allows for clusters larger than the average.
+    double clusterBytes = 1.25 * zipBytes * treeAutoFlush_ / (entries_ + 1);
+    double cacheSize = std::min(static_cast<double>(cacheSize_),
+                                std::max(clusterBytes, static_cast<double>(roottree::minimumSeededCacheSize)));
+    setCacheSize(static_cast<unsigned int>(cacheSize));
+    if (!treeCache_) {
+      return;
+    }
+    filePtr_->SetCacheRead(treeCache_.get());
+    treeCache_->StartLearningPhase();
+    treeCache_->SetEntryRange(entryNumber_, tree_->GetEntries());
+    if (branchListIndexesBranch != nullptr) {
+      treeCache_->AddBranch(branchListIndexesBranch, kTRUE);
+      trainedSet_.insert(branchListIndexesBranch);
+    }
+    treeCache_->AddBranch(auxBranch_, kTRUE);
+    trainedSet_.insert(auxBranch_);
+    for (TBranch* branch : consumedBranches_) {
+      treeCache_->AddBranch(branch, kTRUE);
+      trainedSet_.insert(branch);
+    }
+    treeCache_->StopLearningPhase();
+    filePtr_->SetCacheRead(nullptr);
+    // There is no learning phase, so switch over immediately
+    switchOverEntry_ = entryNumber_;
+    assert(treeCache_->GetTree() == tree_);
+  }
+
   void RootTree::stopTraining() {
     filePtr_->SetCacheRead(treeCache_.get());
     treeCache_->StopLearningPhase();
@@ -47,6 +47,7 @@ namespace edm {
     unsigned int const defaultNonEventCacheSize = 1U * 1024 * 1024;
     unsigned int const defaultLearningEntries = 20U;
     unsigned int const defaultNonEventLearningEntries = 1U;
+    unsigned int const minimumSeededCacheSize = 256U * 1024;
     typedef IndexIntoFile::EntryNumber_t EntryNumber;
     struct BranchInfo {
       BranchInfo(BranchDescription const& prod)
@@ -190,6 +191,8 @@ namespace edm {
     inline TTreeCache* selectCache(TBranch* branch, EntryNumber entryNumber) const;
     void trainCache(char const* branchNames);
     void resetTraining() { trainNow_ = true; }
+    // Fill the cache with exactly these products instead of learning which branches are read.
+    void setConsumedBranches(std::vector<BranchID> const& branchIDs);
 
     BranchType branchType() const { return branchType_; }
 
@@ -201,6 +204,7 @@ namespace edm {
     void setCacheSize(unsigned int cacheSize);
     void setTreeMaxVirtualSize(int treeMaxVirtualSize);
     void startTraining();
+    void startTrainingFromConsumedBranches();
     void stopTraining();
 
     std::shared_ptr<InputFile> filePtr_;
@@ -220,6 +224,8 @@ namespace edm {
     mutable std::shared_ptr<TTreeCache> rawTriggerTreeCache_;
     mutable std::unordered_set<TBranch*> trainedSet_;
     mutable std::unordered_set<TBranch*> triggerSet_;
+    std::vector<TBranch*> consumedBranches_;
+    bool useConsumedBranches_;
     EntryNumber entries_;
     EntryNumber entryNumber_;
     std::unique_ptr<std::vector<EntryNumber> > entryNumberForIndex_;
@@ -11,6 +11,9 @@ cp PoolInputTest.root PoolInputOther.root
 cmsRun --parameter-set ${LOCAL_TEST_DIR}/PoolInputTest_cfg.py || die 'Failure using PoolInputTest_cfg.py' $?
 cmsRun  ${LOCAL_TEST_DIR}/PoolInputTest_noDelay_cfg.py >& ${LOCAL_TMP_DIR}/PoolInputTest_noDelay_cfg.txt || die 'Failure using PoolInputTest_noDelay_cfg.py' $?
 grep 'event delayed read from source' ${LOCAL_TMP_DIR}/PoolInputTest_noDelay_cfg.txt && die 'Failure in PoolInputTest_noDelay_cfg.py, found delay reads from source' 1
+cmsRun ${LOCAL_TEST_DIR}/PoolInputTest_learnCache_cfg.py || die 'Failure using PoolInputTest_learnCache_cfg.py' $?
+cmsRun ${LOCAL_TEST_DIR}/PoolInputTest_parallelUnzip_cfg.py || die 'Failure using PoolInputTest_parallelUnzip_cfg.py' $?
+cmsRun ${LOCAL_TEST_DIR}/PoolInputTest_cacheFromConsumes_cfg.py || die 'Failure using PoolInputTest_cacheFromConsumes_cfg.py' $?
 
 cmsRun ${LOCAL_TEST_DIR}/PrePool2FileInputTest_cfg.py || die 'Failure using PrePool2FileInputTest_cfg.py' $?
 cmsRun ${LOCAL_TEST_DIR}/Pool2FileInputTest_cfg.py || die 'Failure using Pool2FileInputTest_cfg.py' $?
@@ -0,0 +1,92 @@
+/** Trains a ZSTD dictionary on the serialized events of streamer files.
+
+    The dictionary can be given to the streamer output modules with the
+    compression_dictionary parameter, e.g. to compress the events of a run
+    with a dictionary trained on the events of a previous run. It is
+    stored in the INIT message, so nothing is needed on the reading side.
+
+    Usage: TrainStreamerDictionary dictionary_file streamer_file [streamer_file ...]
+*/
+
+#include "FWCore/Utilities/interface/Exception.h"
+#include "IOPool/Streamer/interface/EventMessage.h"
+#include "IOPool/Streamer/interface/InitMessage.h"
+#include "IOPool/Streamer/interface/StreamerInputFile.h"
+#include "IOPool/Streamer/interface/StreamerInputSource.h"
+
+#include "zdict.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+  // same limits as the zstd command line tool
+  constexpr size_t dictionaryCapacity = 112640;
+  constexpr size_t maxSamplesSize = 2000 * dictionaryCapacity;
+
+  // Appends the uncompressed event data blob to samples and returns its size
+  size_t appendEvent(EventMsgView const& eview, std::vector<unsigned char>& samples) {
+    unsigned char* data = const_cast<unsigned char*>(eview.eventData());
+    unsigned int length = eview.eventLength();
+    unsigned int origsize = eview.origDataSize();
+    std::vector<unsigned char> buffer;
+    if (origsize == 78 || origsize == 0) {
+      buffer.assign(data, data + length);
+    } else if (length >= 4 && !strcmp((char const*)data, "XZ")) {
+      buffer.resize(edm::StreamerInputSource::uncompressBufferLZMA(data, length, buffer, origsize));
+    } else if (length >= 4 && !strcmp((char const*)data, "ZS")) {
+      buffer.resize(edm::StreamerInputSource::uncompressBufferZSTD(data, length, buffer, origsize));
+    } else {
+      buffer.resize(edm::StreamerInputSource::uncompressBuffer(data, length, buffer, origsize));
+    }
+    samples.insert(samples.end(), buffer.begin(), buffer.end());
+    return buffer.size();
+  }
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc < 3) {
+    std::cerr << "Usage: TrainStreamerDictionary dictionary_file streamer_file [streamer_file ...]" << std::endl;
+    return 1;
+  }
+
+  std::vector<unsigned char> samples;
+  std::vector<size_t> sampleSizes;
+  try {
+    for (int i = 2; i < argc && samples.size() < maxSamplesSize; ++i) {
+      edm::StreamerInputFile reader(argv[i]);
+      while (reader.next() && samples.size() < maxSamplesSize) {
+        sampleSizes.push_back(appendEvent(*reader.currentRecord(), samples));
+      }
+    }
+  } catch (cms::Exception const& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+
+  if (sampleSizes.empty()) {
+    std::cerr << "No events found to train the dictionary on" << std::endl;
+    return 1;
+  }
+
+  std::vector<unsigned char> dictionary(dictionaryCapacity);
+  size_t size =
+      ZDICT_trainFromBuffer(&dictionary[0], dictionary.size(), &samples[0], &sampleSizes[0], sampleSizes.size());
+  if (ZDICT_isError(size)) {
+    std::cerr << "Training the dictionary on " << sampleSizes.size() << " events failed: " << ZDICT_getErrorName(size)
+              << std::endl;
+    return 1;
+  }
+
+  std::ofstream file(argv[1], std::ios::binary);
+  file.write((char const*)&dictionary[0], size);
+  if (!file) {
+    std::cerr << "Could not write the dictionary to " << argv[1] << std::endl;
+    return 1;
+  }
+  std::cout << "Trained a dictionary of " << size << " bytes on " << sampleSizes.size() << " events" << std::endl;
+  return 0;
+}
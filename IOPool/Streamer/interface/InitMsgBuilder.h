@@ -4,6 +4,8 @@
 #include "IOPool/Streamer/interface/MsgTools.h"
 #include "IOPool/Streamer/interface/InitMessage.h"
 
+#include <vector>
+
 // ----------------- init -------------------
 
 class InitMsgBuilder {
@@ -19,7 +21,8 @@ public:
                  const Strings& hlt_names,
                  const Strings& hlt_selections,
                  const Strings& l1_names,
-                 uint32 adler32_chksum);
+                 uint32 adler32_chksum,
+                 std::vector<unsigned char> const& compression_dictionary = std::vector<unsigned char>());
 
   uint8* startAddress() const { return buf_; }
   void setDataLength(uint32 registry_length);
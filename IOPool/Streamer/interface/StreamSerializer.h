@@ -61,6 +61,7 @@ struct SerializeDataBuffer {
 
 class EventMsgBuilder;
 class InitMsgBuilder;
+struct ZSTD_CDict_s;
 namespace edm {
   enum StreamerCompressionAlgo { UNCOMPRESSED = 0, ZLIB = 1, LZMA = 2, ZSTD = 4 };
 
@@ -81,7 +82,9 @@ namespace edm {
                        ParameterSetID const &selectorConfig,
                        StreamerCompressionAlgo compressionAlgo,
                        int compression_level,
-                       unsigned int reserveSize) const;
+                       unsigned int reserveSize,
+                       unsigned int compressionChunkSize = 0,
+                       ZSTD_CDict_s const *compressionDictionary = nullptr) const;
 
     /**
      * Compresses the data in the specified input buffer into the
@@ -101,12 +104,34 @@ namespace edm {
                                            unsigned int reserveSize,
                                            bool addHeader = true);
 
+    /**
+     * If a dictionary is given, it is used instead of compressionLevel
+     * (which is fixed when the dictionary is digested). The reading side
+     * gets the same dictionary from the INIT message.
+     */
     static unsigned int compressBufferZSTD(unsigned char *inputBuffer,
                                            unsigned int inputSize,
                                            std::vector<unsigned char> &outputBuffer,
                                            int compressionLevel,
                                            unsigned int reserveSize,
-                                           bool addHeader = true);
+                                           bool addHeader = true,
+                                           ZSTD_CDict_s const *dictionary = nullptr);
+
+    /**
+     * Same as compressBufferZSTD, but the input is split in chunks of
+     * chunkSize bytes which are compressed concurrently into independent
+     * ZSTD frames. The concatenated frames are decompressed in one go
+     * by ZSTD_decompress, so the reading side does not need to know
+     * about the chunking.
+     */
+    static unsigned int compressBufferZSTDChunked(unsigned char *inputBuffer,
+                                                  unsigned int inputSize,
+                                                  std::vector<unsigned char> &outputBuffer,
+                                                  int compressionLevel,
+                                                  unsigned int reserveSize,
+                                                  unsigned int chunkSize,
+                                                  bool addHeader = true,
+                                                  ZSTD_CDict_s const *dictionary = nullptr);
 
   private:
     SelectedProducts const *selections_;
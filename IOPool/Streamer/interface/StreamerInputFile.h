@@ -19,15 +19,20 @@ namespace edm {
   class StreamerInputFile {
   public:
     /**Reads a Streamer file */
+    /** If memoryMap is true, local files are mapped into memory and the
+        EventMsgView of each event points directly into the mapped pages */
     explicit StreamerInputFile(std::string const& name,
                                std::string const& LFN,
-                               std::shared_ptr<EventSkipperByID> eventSkipperByID = std::shared_ptr<EventSkipperByID>());
+                               std::shared_ptr<EventSkipperByID> eventSkipperByID = std::shared_ptr<EventSkipperByID>(),
+                               bool memoryMap = false);
     explicit StreamerInputFile(std::string const& name,
-                               std::shared_ptr<EventSkipperByID> eventSkipperByID = std::shared_ptr<EventSkipperByID>());
+                               std::shared_ptr<EventSkipperByID> eventSkipperByID = std::shared_ptr<EventSkipperByID>(),
+                               bool memoryMap = false);
 
     /** Multiple Streamer files */
     explicit StreamerInputFile(std::vector<FileCatalogItem> const& names,
-                               std::shared_ptr<EventSkipperByID> eventSkipperByID = std::shared_ptr<EventSkipperByID>());
+                               std::shared_ptr<EventSkipperByID> eventSkipperByID = std::shared_ptr<EventSkipperByID>(),
+                               bool memoryMap = false);
 
     ~StreamerInputFile();
 
@@ -50,11 +55,14 @@ namespace edm {
 
   private:
     void openStreamerFile(std::string const& name, std::string const& LFN);
+    bool mapStreamerFile(std::string const& name);
+    void unmapStreamerFile();
     IOSize readBytes(char* buf, IOSize nBytes);
     IOOffset skipBytes(IOSize nBytes);
 
     void readStartMessage();
     int readEventMessage();
+    int readMappedEventMessage();
 
     bool openNextFile();
     /** Compares current File header with the newly opened file header
@@ -85,6 +93,13 @@ namespace edm {
     edm::propagate_const<std::unique_ptr<Storage>> storage_;
 
     bool endOfFile_;
+
+    bool memoryMap_;         /** True if local files should be memory mapped */
+    char* mappedFile_;       /** Start of the mapped file, nullptr if the file is read through storage_ */
+    IOSize mappedSize_;      /** Size of the mapped file */
+    IOSize mappedOffset_;    /** Offset of the next message in the mapped file */
+    IOSize releasedSize_;    /** Size of the mapped region already handed back to the kernel */
+    IOSize prefetchedSize_;  /** Size of the mapped region the kernel was asked to read ahead */
   };
 }  // namespace edm
 
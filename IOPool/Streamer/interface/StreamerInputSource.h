@@ -22,6 +22,7 @@
 
 class InitMsgView;
 class EventMsgView;
+struct ZSTD_DDict_s;
 
 namespace edm {
   class BranchIDListHelper;
@@ -79,7 +80,8 @@ namespace edm {
                                              unsigned int inputSize,
                                              std::vector<unsigned char>& outputBuffer,
                                              unsigned int expectedFullSize,
-                                             bool hasHeader = true);
+                                             bool hasHeader = true,
+                                             ZSTD_DDict_s const* dictionary = nullptr);
 
   protected:
     static void declareStreamers(SendDescs const& descs);
@@ -123,6 +125,8 @@ namespace edm {
 
     std::string processName_;
     unsigned int protocolVersion_;
+    // ZSTD dictionary from the last INIT message, if the events were compressed with one
+    std::shared_ptr<ZSTD_DDict_s> compressionDDict_;
   };  //end-of-class-def
 }  // namespace edm
 
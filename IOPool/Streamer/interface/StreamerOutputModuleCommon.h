@@ -6,6 +6,7 @@
 #include "IOPool/Streamer/interface/StreamSerializer.h"
 #include "DataFormats/Common/interface/Handle.h"
 #include <memory>
+#include <string>
 #include <vector>
 
 class InitMsgBuilder;
@@ -51,6 +52,9 @@ namespace edm {
     bool useCompression_;
     std::string compressionAlgoStr_;
     int compressionLevel_;
+    unsigned int compressionChunkSize_;
+    std::vector<unsigned char> compressionDictionary_;
+    std::shared_ptr<ZSTD_CDict_s> compressionCDict_;
 
     StreamerCompressionAlgo compressionAlgo_;
 
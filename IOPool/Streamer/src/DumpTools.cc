@@ -33,6 +33,9 @@ void dumpInitHeader(const InitMsgView* view) {
     std::cout << "Checksum for Registry data = " << view->adler32_chksum() << " Hostname = " << view->hostName()
               << std::endl;
   }
+  if (view->protocolVersion() >= 12) {
+    std::cout << "Compression dictionary length = " << view->compressionDictionaryLength() << std::endl;
+  }
 
   //PSet 16 byte non-printable representation, stored in message.
   uint8 vpset[16];
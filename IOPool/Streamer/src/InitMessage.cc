@@ -26,6 +26,8 @@ InitMsgView::InitMsgView(void* buf)
       adler32_chksum_(0),
       host_name_start_(nullptr),
       host_name_len_(0),
+      dictionary_start_(nullptr),
+      dictionary_len_(0),
       desc_start_(nullptr),
       desc_len_(0) {
   if (protocolVersion() == 2) {
@@ -96,6 +98,12 @@ InitMsgView::InitMsgView(void* buf)
     }
   }
 
+  if (protocolVersion() > 11) {
+    dictionary_len_ = convert32(pos);
+    dictionary_start_ = pos + sizeof(char_uint32);
+    pos = dictionary_start_ + dictionary_len_;
+  }
+
   desc_start_ = pos;
   desc_len_ = convert32(desc_start_);
   desc_start_ += sizeof(char_uint32);
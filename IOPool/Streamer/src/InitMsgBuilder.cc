@@ -1,6 +1,7 @@
 #include "IOPool/Streamer/interface/InitMsgBuilder.h"
 #include "IOPool/Streamer/interface/EventMsgBuilder.h"
 #include "IOPool/Streamer/interface/MsgHeader.h"
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <cstdint>
@@ -17,7 +18,8 @@ InitMsgBuilder::InitMsgBuilder(void* buf,
                                const Strings& hlt_names,
                                const Strings& hlt_selections,
                                const Strings& l1_names,
-                               uint32 adler_chksum)
+                               uint32 adler_chksum,
+                               std::vector<unsigned char> const& compression_dictionary)
     : buf_((uint8*)buf), size_(size) {
   InitHeader* h = (InitHeader*)buf_;
   // fixed length parts
@@ -60,6 +62,12 @@ InitMsgBuilder::InitMsgBuilder(void* buf,
   convert(adler_chksum, pos);
   pos = pos + sizeof(uint32);
 
+  // ZSTD dictionary needed to uncompress the events, if any
+  convert((uint32)compression_dictionary.size(), pos);
+  pos += sizeof(char_uint32);
+  std::copy(compression_dictionary.begin(), compression_dictionary.end(), pos);
+  pos += compression_dictionary.size();
+
   data_addr_ = pos + sizeof(char_uint32);
   setDataLength(0);
 
@@ -25,11 +25,31 @@
 #include "zlib.h"
 #include "lzma.h"
 #include "zstd.h"
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
 #include <algorithm>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <memory>
 #include <vector>
 
+namespace {
+  // Compresses one ZSTD frame, using the already digested dictionary if there is one
+  size_t compressZSTDFrame(unsigned char *dst,
+                           size_t dstCapacity,
+                           unsigned char const *src,
+                           size_t srcSize,
+                           int compressionLevel,
+                           ZSTD_CDict const *dictionary) {
+    if (dictionary == nullptr) {
+      return ZSTD_compress(dst, dstCapacity, src, srcSize, compressionLevel);
+    }
+    std::unique_ptr<ZSTD_CCtx, size_t (*)(ZSTD_CCtx *)> context(ZSTD_createCCtx(), ZSTD_freeCCtx);
+    return ZSTD_compress_usingCDict(context.get(), dst, dstCapacity, src, srcSize, dictionary);
+  }
+}  // namespace
+
 namespace edm {
 
   /**
@@ -129,7 +149,9 @@ namespace edm {
                                        ParameterSetID const &selectorConfig,
                                        StreamerCompressionAlgo compressionAlgo,
                                        int compression_level,
-                                       unsigned int reserveSize) const {
+                                       unsigned int reserveSize,
+                                       unsigned int compressionChunkSize,
+                                       ZSTD_CDict_s const *compressionDictionary) const {
     EventSelectionIDVector selectionIDs = event.eventSelectionIDs();
     selectionIDs.push_back(selectorConfig);
     SendEvent se(event.eventAuxiliary(), event.processHistory(), selectionIDs, event.branchListIndexes());
@@ -231,11 +253,24 @@ namespace edm {
                                        reserveSize);
         break;
       case ZSTD:
-        dest_size = compressBufferZSTD((unsigned char *)data_buffer.rootbuf_.Buffer(),
-                                       data_buffer.curr_event_size_,
-                                       data_buffer.comp_buf_,
-                                       compression_level,
-                                       reserveSize);
+        if (compressionChunkSize > 0 && data_buffer.curr_event_size_ > compressionChunkSize) {
+          dest_size = compressBufferZSTDChunked((unsigned char *)data_buffer.rootbuf_.Buffer(),
+                                                data_buffer.curr_event_size_,
+                                                data_buffer.comp_buf_,
+                                                compression_level,
+                                                reserveSize,
+                                                compressionChunkSize,
+                                                true,
+                                                compressionDictionary);
+        } else {
+          dest_size = compressBufferZSTD((unsigned char *)data_buffer.rootbuf_.Buffer(),
+                                         data_buffer.curr_event_size_,
+                                         data_buffer.comp_buf_,
+                                         compression_level,
+                                         reserveSize,
+                                         true,
+                                         compressionDictionary);
+        }
         break;
       default:
         dest_size = data_buffer.rootbuf_.Length();
@@ -383,7 +418,8 @@ namespace edm {
                                                     std::vector<unsigned char> &outputBuffer,
                                                     int compressionLevel,
                                                     unsigned int reserveSize,
-                                                    bool addHeader) {
+                                                    bool addHeader,
+                                                    ZSTD_CDict_s const *dictionary) {
     unsigned int hdr_size = addHeader ? 4 : 0;
     unsigned int resultSize = 0;
 
@@ -403,8 +439,8 @@ namespace edm {
     }
 
     // compression 1-20
-    size_t dest_size = ZSTD_compress(
-        (void *)&outputBuffer[reserveSize + hdr_size], worst_size, (void *)inputBuffer, inputSize, compressionLevel);
+    size_t dest_size = compressZSTDFrame(
+        &outputBuffer[reserveSize + hdr_size], worst_size, inputBuffer, inputSize, compressionLevel, dictionary);
 
     // check status
     if (!ZSTD_isError(dest_size)) {
@@ -421,4 +457,59 @@ namespace edm {
     return resultSize;
   }
 
+  unsigned int StreamSerializer::compressBufferZSTDChunked(unsigned char *inputBuffer,
+                                                           unsigned int inputSize,
+                                                           std::vector<unsigned char> &outputBuffer,
+                                                           int compressionLevel,
+                                                           unsigned int reserveSize,
+                                                           unsigned int chunkSize,
+                                                           bool addHeader,
+                                                           ZSTD_CDict_s const *dictionary) {
+    unsigned int hdr_size = addHeader ? 4 : 0;
+    unsigned int nChunks = (inputSize + chunkSize - 1) / chunkSize;
+
+    // Each chunk is first compressed into its own worst case slot and the
+    // results are then moved together, so no additional buffer is needed.
+    size_t chunk_worst_size = ZSTD_compressBound(chunkSize);
+    size_t worst_size = nChunks * chunk_worst_size;
+    if (outputBuffer.size() < worst_size + reserveSize + hdr_size)
+      outputBuffer.resize(worst_size + reserveSize + hdr_size);
+
+    unsigned char *tgt = &outputBuffer[reserveSize];
+    if (addHeader) {
+      tgt[0] = 'Z'; /* Pre */
+      tgt[1] = 'S';
+      tgt[2] = 0;
+      tgt[3] = 0;
+    }
+    unsigned char *frames = tgt + hdr_size;
+
+    std::vector<size_t> chunk_sizes(nChunks);
+    // Isolate so that the calling thread does not pick up another event of
+    // the same output module while waiting for the chunks to be compressed.
+    tbb::this_task_arena::isolate([&] {
+      tbb::parallel_for(0U, nChunks, [&](unsigned int i) {
+        unsigned int offset = i * chunkSize;
+        unsigned int size = std::min(chunkSize, inputSize - offset);
+        chunk_sizes[i] = compressZSTDFrame(
+            frames + i * chunk_worst_size, chunk_worst_size, inputBuffer + offset, size, compressionLevel, dictionary);
+      });
+    });
+
+    size_t dest_size = 0;
+    for (unsigned int i = 0; i < nChunks; ++i) {
+      if (ZSTD_isError(chunk_sizes[i])) {
+        throw cms::Exception("StreamSerializer", "compressBuffer")
+            << "Compression (ZSTD) Error: " << ZSTD_getErrorName(chunk_sizes[i]);
+      }
+      std::memmove(frames + dest_size, frames + i * chunk_worst_size, chunk_sizes[i]);
+      dest_size += chunk_sizes[i];
+    }
+
+    FDEBUG(1) << " original size = " << inputSize << " final size = " << dest_size << " in " << nChunks << " chunks"
+              << " ratio = " << double(dest_size) / double(inputSize) << std::endl;
+
+    return (unsigned int)dest_size + hdr_size;
+  }
+
 }  // namespace edm
@@ -11,16 +11,30 @@
 #include "Utilities/StorageFactory/interface/IOFlags.h"
 #include "Utilities/StorageFactory/interface/StorageFactory.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 namespace edm {
 
+  namespace {
+    // Amount of a memory mapped file the kernel is asked to read ahead of the current event
+    IOSize const mappedReadAheadSize = 64 * 1024 * 1024;
+  }  // namespace
+
   StreamerInputFile::~StreamerInputFile() { closeStreamerFile(); }
 
   StreamerInputFile::StreamerInputFile(std::string const& name,
                                        std::string const& LFN,
-                                       std::shared_ptr<EventSkipperByID> eventSkipperByID)
+                                       std::shared_ptr<EventSkipperByID> eventSkipperByID,
+                                       bool memoryMap)
       : startMsg_(),
         currentEvMsg_(),
         headerBuf_(1000 * 1000),
@@ -35,16 +49,25 @@ namespace edm {
         currProto_(0),
         newHeader_(false),
         storage_(),
-        endOfFile_(false) {
+        endOfFile_(false),
+        memoryMap_(memoryMap),
+        mappedFile_(nullptr),
+        mappedSize_(0),
+        mappedOffset_(0),
+        releasedSize_(0),
+        prefetchedSize_(0) {
     openStreamerFile(name, LFN);
     readStartMessage();
   }
 
-  StreamerInputFile::StreamerInputFile(std::string const& name, std::shared_ptr<EventSkipperByID> eventSkipperByID)
-      : StreamerInputFile(name, name, eventSkipperByID) {}
+  StreamerInputFile::StreamerInputFile(std::string const& name,
+                                       std::shared_ptr<EventSkipperByID> eventSkipperByID,
+                                       bool memoryMap)
+      : StreamerInputFile(name, name, eventSkipperByID, memoryMap) {}
 
   StreamerInputFile::StreamerInputFile(std::vector<FileCatalogItem> const& names,
-                                       std::shared_ptr<EventSkipperByID> eventSkipperByID)
+                                       std::shared_ptr<EventSkipperByID> eventSkipperByID,
+                                       bool memoryMap)
       : startMsg_(),
         currentEvMsg_(),
         headerBuf_(1000 * 1000),
@@ -58,7 +81,13 @@ namespace edm {
         currRun_(0),
         currProto_(0),
         newHeader_(false),
-        endOfFile_(false) {
+        endOfFile_(false),
+        memoryMap_(memoryMap),
+        mappedFile_(nullptr),
+        mappedSize_(0),
+        mappedOffset_(0),
+        releasedSize_(0),
+        prefetchedSize_(0) {
     openStreamerFile(names.at(0).fileName(), names.at(0).logicalFileName());
     ++currentFile_;
     readStartMessage();
@@ -83,6 +112,12 @@ namespace edm {
 
     logFileAction("  Initiating request to open file ");
 
+    if (memoryMap_ && mapStreamerFile(name)) {
+      currentFileOpen_ = true;
+      logFileAction("  Successfully mapped file ");
+      return;
+    }
+
     IOOffset size = -1;
     if (StorageFactory::get()->check(name, &size)) {
       try {
@@ -102,8 +137,58 @@ namespace edm {
     logFileAction("  Successfully opened file ");
   }
 
+  bool StreamerInputFile::mapStreamerFile(std::string const& name) {
+    // Only local files can be mapped. Anything else, or a local file that cannot
+    // be mapped, is read through the StorageFactory.
+    std::string path(name);
+    std::string::size_type colon = name.find(':');
+    if (colon != std::string::npos) {
+      if (name.compare(0, colon, "file") != 0) {
+        return false;
+      }
+      path = name.substr(colon + 1);
+    }
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return false;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+      ::close(fd);
+      return false;
+    }
+    // The mapping is private and writable so that code which const_casts the
+    // message buffers only ever touches its own copy of a page.
+    void* addr = ::mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+      LogInfo("StreamerInputFile") << "Could not memory map " << path << ": " << std::strerror(errno)
+                                   << "\nReading it through the storage layer instead.";
+      return false;
+    }
+    mappedFile_ = static_cast<char*>(addr);
+    mappedSize_ = st.st_size;
+    mappedOffset_ = 0;
+    releasedSize_ = 0;
+    prefetchedSize_ = std::min(mappedSize_, mappedReadAheadSize);
+    ::madvise(mappedFile_, mappedSize_, MADV_SEQUENTIAL);
+    ::madvise(mappedFile_, prefetchedSize_, MADV_WILLNEED);
+    return true;
+  }
+
+  void StreamerInputFile::unmapStreamerFile() {
+    // The current event points into the mapping.
+    currentEvMsg_ = nullptr;
+    ::munmap(mappedFile_, mappedSize_);
+    mappedFile_ = nullptr;
+    mappedSize_ = mappedOffset_ = releasedSize_ = prefetchedSize_ = 0;
+  }
+
   void StreamerInputFile::closeStreamerFile() {
-    if (currentFileOpen_ && storage_) {
+    if (currentFileOpen_ && mappedFile_) {
+      unmapStreamerFile();
+      logFileAction("  Closed file ");
+    } else if (currentFileOpen_ && storage_) {
       storage_->close();
       logFileAction("  Closed file ");
     }
@@ -112,6 +197,12 @@ namespace edm {
 
   IOSize StreamerInputFile::readBytes(char* buf, IOSize nBytes) {
     IOSize n = 0;
+    if (mappedFile_) {
+      n = std::min(nBytes, mappedSize_ - mappedOffset_);
+      std::memcpy(buf, mappedFile_ + mappedOffset_, n);
+      mappedOffset_ += n;
+      return n;
+    }
     try {
       n = storage_->read(buf, nBytes);
     } catch (cms::Exception& ce) {
@@ -124,6 +215,11 @@ namespace edm {
 
   IOOffset StreamerInputFile::skipBytes(IOSize nBytes) {
     IOOffset n = 0;
+    if (mappedFile_) {
+      n = std::min(nBytes, mappedSize_ - mappedOffset_);
+      mappedOffset_ += n;
+      return n;
+    }
     try {
       // We wish to return the number of bytes skipped, not the final offset.
       n = storage_->position(0, Storage::CURRENT);
@@ -226,6 +322,8 @@ namespace edm {
   int StreamerInputFile::readEventMessage() {
     if (endOfFile_)
       return 0;
+    if (mappedFile_)
+      return readMappedEventMessage();
 
     bool eventRead = false;
     while (!eventRead) {
@@ -285,6 +383,72 @@ namespace edm {
     return 1;
   }
 
+  int StreamerInputFile::readMappedEventMessage() {
+    static IOSize const pageSize = ::sysconf(_SC_PAGESIZE);
+
+    bool eventRead = false;
+    char* eventStart = nullptr;
+    while (!eventRead) {
+      IOSize nLeft = mappedSize_ - mappedOffset_;
+      if (nLeft == 0) {
+        // no more data available
+        endOfFile_ = true;
+        return 0;
+      }
+      if (nLeft < sizeof(EventHeader)) {
+        throw edm::Exception(errors::FileReadError, "StreamerInputFile::readEventMessage")
+            << "Failed reading streamer file, first read in readEventMessage\n"
+            << "Requested " << sizeof(EventHeader) << " bytes, only " << nLeft << " bytes left in mapped file\n";
+      }
+      eventStart = mappedFile_ + mappedOffset_;
+      HeaderView head(eventStart);
+      uint32 code = head.code();
+
+      // If it is not an event then something is wrong.
+      if (code != Header::EVENT) {
+        throw Exception(errors::FileReadError, "StreamerInputFile::readEventMessage")
+            << "Failed reading streamer file, unknown code in event header\n"
+            << "code = " << code << "\n";
+      }
+      uint32 eventSize = head.size();
+      if (eventSize <= sizeof(EventHeader)) {
+        throw edm::Exception(errors::FileReadError, "StreamerInputFile::readEventMessage")
+            << "Failed reading streamer file, event header size from data too small\n";
+      }
+      if (eventSize > nLeft) {
+        throw Exception(errors::FileReadError, "StreamerInputFile::readEventMessage")
+            << "Failed reading streamer file, second read in readEventMessage\n"
+            << "Requested " << eventSize << " bytes, only " << nLeft << " bytes left in mapped file\n";
+      }
+      eventRead = true;
+      if (eventSkipperByID_) {
+        EventHeader* evh = (EventHeader*)eventStart;
+        if (eventSkipperByID_->skipIt(convert32(evh->run_), convert32(evh->lumi_), convert64(evh->event_))) {
+          eventRead = false;
+        }
+      }
+      mappedOffset_ += eventSize;
+    }
+
+    // Pages before the current event will not be used again, so the kernel may drop them,
+    // and ask it to read ahead once we get close to the end of the previously requested region.
+    IOSize eventOffset = eventStart - mappedFile_;
+    IOSize releaseSize = eventOffset / pageSize * pageSize;
+    if (releaseSize > releasedSize_) {
+      ::madvise(mappedFile_ + releasedSize_, releaseSize - releasedSize_, MADV_DONTNEED);
+      releasedSize_ = releaseSize;
+    }
+    if (prefetchedSize_ < mappedSize_ && mappedOffset_ + mappedReadAheadSize / 2 > prefetchedSize_) {
+      IOSize prefetchStart = prefetchedSize_ / pageSize * pageSize;
+      prefetchedSize_ = std::min(mappedSize_, mappedOffset_ + mappedReadAheadSize);
+      ::madvise(mappedFile_ + prefetchStart, prefetchedSize_ - prefetchStart, MADV_WILLNEED);
+    }
+
+    // No copy: the view points directly into the mapped file.
+    currentEvMsg_ = std::make_shared<EventMsgView>((void*)eventStart);  // propagate_const<T> has no reset() function
+    return 1;
+  }
+
   void StreamerInputFile::logFileAction(char const* msg) {
     LogAbsolute("fileAction") << std::setprecision(0) << TimeOfDay() << msg << currentFileName_;
     FlushMessageLog();
@@ -35,6 +35,7 @@
 
 #include <string>
 #include <iostream>
+#include <memory>
 #include <set>
 
 namespace edm {
@@ -146,6 +147,15 @@ namespace edm {
           << " host name = " << initView.hostName() << std::endl;
     }
 
+    compressionDDict_.reset();
+    if (initView.compressionDictionaryLength() > 0) {
+      compressionDDict_ = std::shared_ptr<ZSTD_DDict>(
+          ZSTD_createDDict(initView.compressionDictionary(), initView.compressionDictionaryLength()), ZSTD_freeDDict);
+      if (!compressionDDict_)
+        throw cms::Exception("StreamTranslation", "Registry deserialization error")
+            << "Could not load the ZSTD compression dictionary from the INIT message\n";
+    }
+
     TClass* desc = getTClass(typeid(SendJobHeader));
 
     TBufferFile xbuf(
@@ -218,7 +228,9 @@ namespace edm {
         dest_size = uncompressBufferZSTD(const_cast<unsigned char*>((unsigned char const*)eventView.eventData()),
                                          eventView.eventLength(),
                                          dest_,
-                                         origsize);
+                                         origsize,
+                                         true,
+                                         compressionDDict_.get());
       } else
         dest_size = uncompressBuffer(const_cast<unsigned char*>((unsigned char const*)eventView.eventData()),
                                      eventView.eventLength(),
@@ -438,14 +450,26 @@ namespace edm {
                                                          unsigned int inputSize,
                                                          std::vector<unsigned char>& outputBuffer,
                                                          unsigned int expectedFullSize,
-                                                         bool hasHeader) {
+                                                         bool hasHeader,
+                                                         ZSTD_DDict_s const* dictionary) {
     unsigned long uncompressedSize = expectedFullSize * 1.1;
     FDEBUG(1) << "Uncompress: original size = " << expectedFullSize << ", compressed size = " << inputSize << std::endl;
     outputBuffer.resize(uncompressedSize);
 
     size_t hdrSize = hasHeader ? 4 : 0;
-    size_t ret = ZSTD_decompress(
-        (void*)&(outputBuffer[0]), uncompressedSize, (const void*)(inputBuffer + hdrSize), inputSize - hdrSize);
+    size_t ret;
+    if (dictionary == nullptr) {
+      ret = ZSTD_decompress(
+          (void*)&(outputBuffer[0]), uncompressedSize, (const void*)(inputBuffer + hdrSize), inputSize - hdrSize);
+    } else {
+      std::unique_ptr<ZSTD_DCtx, size_t (*)(ZSTD_DCtx*)> context(ZSTD_createDCtx(), ZSTD_freeDCtx);
+      ret = ZSTD_decompress_usingDDict(context.get(),
+                                       (void*)&(outputBuffer[0]),
+                                       uncompressedSize,
+                                       (const void*)(inputBuffer + hdrSize),
+                                       inputSize - hdrSize,
+                                       dictionary);
+    }
 
     if (ZSTD_isError(ret)) {
       throw cms::Exception("StreamDeserializationZSTD", "ZSTD uncompression error")
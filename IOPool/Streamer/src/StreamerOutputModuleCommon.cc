@@ -14,13 +14,16 @@
 #include "DataFormats/Provenance/interface/SelectedProducts.h"
 #include "FWCore/Framework/interface/getAllTriggerNames.h"
 
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <sys/time.h>
 #include <unistd.h>
 #include <vector>
 #include <zlib.h>
+#include <zstd.h>
 
 namespace edm {
   StreamerOutputModuleCommon::StreamerOutputModuleCommon(ParameterSet const& ps, SelectedProducts const* selections)
@@ -30,6 +33,7 @@ namespace edm {
         useCompression_(ps.getUntrackedParameter<bool>("use_compression")),
         compressionAlgoStr_(ps.getUntrackedParameter<std::string>("compression_algorithm")),
         compressionLevel_(ps.getUntrackedParameter<int>("compression_level")),
+        compressionChunkSize_(ps.getUntrackedParameter<unsigned int>("compression_chunk_size")),
         lumiSectionInterval_(ps.getUntrackedParameter<int>("lumiSection_interval")),
         hltsize_(0),
         host_name_(),
@@ -84,6 +88,24 @@ namespace edm {
     // 25-Jan-2008, KAB - pull out the trigger selection request
     // which we need for the INIT message
     hltTriggerSelections_ = EventSelector::getEventSelectionVString(ps);
+
+    auto const dictionaryFile = ps.getUntrackedParameter<std::string>("compression_dictionary");
+    if (!dictionaryFile.empty()) {
+      if (compressionAlgo_ != ZSTD)
+        throw cms::Exception("StreamerOutputModuleCommon", "Compression dictionary")
+            << "A compression dictionary can only be used with the ZSTD compression algorithm";
+      std::ifstream file(dictionaryFile, std::ios::binary);
+      if (!file)
+        throw cms::Exception("StreamerOutputModuleCommon", "Compression dictionary")
+            << "Could not open compression dictionary file " << dictionaryFile;
+      compressionDictionary_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+      compressionCDict_ = std::shared_ptr<ZSTD_CDict>(
+          ZSTD_createCDict(compressionDictionary_.data(), compressionDictionary_.size(), compressionLevel_),
+          ZSTD_freeCDict);
+      if (!compressionCDict_)
+        throw cms::Exception("StreamerOutputModuleCommon", "Compression dictionary")
+            << "Could not load ZSTD compression dictionary from " << dictionaryFile;
+    }
   }
 
   StreamerOutputModuleCommon::~StreamerOutputModuleCommon() {}
@@ -99,7 +121,7 @@ namespace edm {
     // resize header_buf_ to reflect space used in serializer_ + header
     // I just added an overhead for header of 50000 for now
     unsigned int src_size = sbuf.currentSpaceUsed();
-    unsigned int new_size = src_size + 50000;
+    unsigned int new_size = src_size + compressionDictionary_.size() + 50000;
     if (sbuf.header_buf_.size() < new_size)
       sbuf.header_buf_.resize(new_size);
 
@@ -141,7 +163,8 @@ namespace edm {
                                                          hltTriggerNames,
                                                          hltTriggerSelections_,
                                                          l1_names,
-                                                         (uint32)sbuf.adler32_chksum());
+                                                         (uint32)sbuf.adler32_chksum(),
+                                                         compressionDictionary_);
 
     // copy data into the destination message
     unsigned char* src = sbuf.bufferPointer();
@@ -221,7 +244,14 @@ namespace edm {
         lumi = static_cast<uint32>(timeInSec / lumiSectionInterval_) + 1;
     }
 
-    serializer_.serializeEvent(sbuf, e, selectorCfg, compressionAlgo_, compressionLevel_, reserve_size);
+    serializer_.serializeEvent(sbuf,
+                               e,
+                               selectorCfg,
+                               compressionAlgo_,
+                               compressionLevel_,
+                               reserve_size,
+                               compressionChunkSize_,
+                               compressionCDict_.get());
 
     // resize header_buf_ to reserved size on first written event
     if (sbuf.header_buf_.size() < reserve_size)
@@ -269,6 +299,15 @@ namespace edm {
     desc.addUntracked<std::string>("compression_algorithm", "ZLIB")
         ->setComment("Compression algorithm to use: UNCOMPRESSED, ZLIB, LZMA or ZSTD");
     desc.addUntracked<int>("compression_level", 1)->setComment("Compression level to use on serialized ROOT events");
+    desc.addUntracked<unsigned int>("compression_chunk_size", 0)
+        ->setComment(
+            "Only used with ZSTD. If not 0, serialized events larger than this many bytes are split in chunks which "
+            "are compressed concurrently.");
+    desc.addUntracked<std::string>("compression_dictionary", "")
+        ->setComment(
+            "Only used with ZSTD. If not empty, the name of a ZSTD dictionary file (e.g. trained with "
+            "TrainStreamerDictionary on events of a previous run) used to compress the events. The dictionary is "
+            "stored in the INIT message.");
     desc.addUntracked<int>("lumiSection_interval", 0)
         ->setComment(
             "If 0, use lumi section number from event.\n"
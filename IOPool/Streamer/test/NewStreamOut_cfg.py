@@ -9,6 +9,18 @@ options.register ('compAlgo',
                   VarParsing.VarParsing.varType.string,
                   "Compression Algorithm")
 
+options.register ('compChunkSize',
+                  0, # default value
+                  VarParsing.VarParsing.multiplicity.singleton,
+                  VarParsing.VarParsing.varType.int,
+                  "Compression chunk size (ZSTD only)")
+
+options.register ('compDictionary',
+                  '', # default value
+                  VarParsing.VarParsing.multiplicity.singleton,
+                  VarParsing.VarParsing.varType.string,
+                  "Compression dictionary file (ZSTD only)")
+
 options.parseArguments()
 
 
@@ -20,7 +32,7 @@ process.options = FWCore.Framework.test.cmsExceptionsFatal_cff.options
 process.load("FWCore.MessageLogger.MessageLogger_cfi")
 
 process.maxEvents = cms.untracked.PSet(
-    input = cms.untracked.int32(50)
+    input = cms.untracked.int32(options.maxEvents if options.maxEvents > 0 else 50)
 )
 
 process.source = cms.Source("EmptySource",
@@ -43,6 +55,8 @@ process.out = cms.OutputModule("EventStreamFileWriter",
     compression_level = cms.untracked.int32(1),
     use_compression = cms.untracked.bool(True),
     compression_algorithm = cms.untracked.string(options.compAlgo),
+    compression_chunk_size = cms.untracked.uint32(options.compChunkSize),
+    compression_dictionary = cms.untracked.string(options.compDictionary),
     max_event_size = cms.untracked.int32(7000000)
 )
 
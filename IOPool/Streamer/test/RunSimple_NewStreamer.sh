@@ -17,6 +17,16 @@ TEST_COMPRESSION_ALGO="ZLIB"
 fi
 echo "TEST_COMPRESSION_ALGO = $TEST_COMPRESSION_ALGO"
 
+if [ -z  $TEST_COMPRESSION_CHUNK_SIZE ]; then
+TEST_COMPRESSION_CHUNK_SIZE="0"
+fi
+echo "TEST_COMPRESSION_CHUNK_SIZE = $TEST_COMPRESSION_CHUNK_SIZE"
+echo "TEST_COMPRESSION_DICTIONARY = $TEST_COMPRESSION_DICTIONARY"
+OUT_ARGS="compAlgo=${TEST_COMPRESSION_ALGO} compChunkSize=${TEST_COMPRESSION_CHUNK_SIZE}"
+if [ -n "$TEST_COMPRESSION_DICTIONARY" ]; then
+OUT_ARGS="${OUT_ARGS} compDictionary=${TEST_COMPRESSION_DICTIONARY}"
+fi
+
 cd $LOCAL_TEST_DIR
 
 RC=0
@@ -28,9 +38,14 @@ mkdir ${OUTDIR}
 cp *_cfg.py ${OUTDIR}
 cd ${OUTDIR}
 
-cmsRun NewStreamOut_cfg.py compAlgo=${TEST_COMPRESSION_ALGO} > out 2>&1 || die "cmsRun NewStreamOut_cfg.py compAlgo=${TEST_COMPRESSION_ALGO}" $?
+cmsRun NewStreamOut_cfg.py ${OUT_ARGS} > out 2>&1 || die "cmsRun NewStreamOut_cfg.py ${OUT_ARGS}" $?
+if [ -n "$TEST_COMPRESSION_DICTIONARY" ]; then
+  DiagStreamerFile teststreamfile.dat > diag 2>&1 || die "DiagStreamerFile teststreamfile.dat" $?
+  grep -q "Compression dictionary length = [1-9]" diag || die "compression dictionary not stored in INIT message" 1
+fi
 cmsRun --parameter-set NewStreamIn_cfg.py  > in  2>&1 || die "cmsRun NewStreamIn_cfg.py" $?
 cmsRun --parameter-set NewStreamIn2_cfg.py  > in2  2>&1 || die "cmsRun NewStreamIn2_cfg.py" $?
+cmsRun --parameter-set NewStreamInMmap_cfg.py  > inmmap  2>&1 || die "cmsRun NewStreamInMmap_cfg.py" $?
 cmsRun --parameter-set NewStreamCopy_cfg.py  > copy  2>&1 || die "cmsRun NewStreamCopy_cfg.py" $?
 cmsRun --parameter-set NewStreamCopy2_cfg.py  > copy2  2>&1 || die "cmsRun NewStreamCopy2_cfg.py" $?
 
@@ -41,6 +56,7 @@ ANS_OUT_SIZE=`grep -c CHECKSUM out`
 ANS_OUT=`grep CHECKSUM out`
 ANS_IN=`grep CHECKSUM in`
 ANS_IN2=`grep CHECKSUM in2`
+ANS_INMMAP=`grep CHECKSUM inmmap`
 ANS_COPY=`grep CHECKSUM copy`
 
 if [ "${ANS_OUT_SIZE}" == "0" ]
@@ -61,6 +77,12 @@ then
     RC=1
 fi
 
+if [ "${ANS_OUT}" != "${ANS_INMMAP}" ]
+then
+    echo "New Stream Test Failed (out!=inmmap)"
+    RC=1
+fi
+
 if [ "${ANS_OUT}" != "${ANS_COPY}" ]
 then
     echo "New Stream Test Failed (copy!=out)"
@@ -0,0 +1,5 @@
+#!/bin/bash
+SCRIPTDIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" && pwd )"
+export TEST_COMPRESSION_ALGO="ZSTD"
+export TEST_COMPRESSION_CHUNK_SIZE="256"
+exec ${SCRIPTDIR}/RunSimple_NewStreamer.sh
@@ -0,0 +1,20 @@
+#!/bin/bash
+
+function die { echo Failure $1: status $2 ; exit $2 ; }
+
+SCRIPTDIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" && pwd )"
+if [ -z  $LOCAL_TMP_DIR ]; then
+LOCAL_TMP_DIR="/tmp"
+fi
+
+# train the dictionary on the events of an uncompressed "previous run"
+SAMPLEDIR=${LOCAL_TMP_DIR}/dict_${USER}$$
+mkdir ${SAMPLEDIR}
+cp ${SCRIPTDIR}/NewStreamOut_cfg.py ${SAMPLEDIR}
+cd ${SAMPLEDIR}
+cmsRun NewStreamOut_cfg.py compAlgo=UNCOMPRESSED maxEvents=500 > sample 2>&1 || die "cmsRun NewStreamOut_cfg.py compAlgo=UNCOMPRESSED" $?
+TrainStreamerDictionary ${SAMPLEDIR}/streamer.dict teststreamfile.dat || die "TrainStreamerDictionary" $?
+
+export TEST_COMPRESSION_ALGO="ZSTD"
+export TEST_COMPRESSION_DICTIONARY="${SAMPLEDIR}/streamer.dict"
+exec ${SCRIPTDIR}/RunSimple_NewStreamer.sh
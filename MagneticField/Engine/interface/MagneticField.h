@@ -29,6 +29,11 @@ public:
   /// Field value ad specified global point, in Tesla
   virtual GlobalVector inTesla(const GlobalPoint& gp) const = 0;
 
+  /// Field values at n global points, in Tesla. The default
+  /// implementation calls inTesla for each point; engines can override
+  /// it to share the work between points close to each other.
+  virtual void inTeslaBatch(const GlobalPoint* gp, GlobalVector* b, unsigned int n) const;
+
   /// Field value ad specified global point, in KGauss
   GlobalVector inKGauss(const GlobalPoint& gp) const { return inTesla(gp) * 10.F; }
 
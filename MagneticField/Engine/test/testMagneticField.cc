@@ -12,6 +12,10 @@
  *  TOSCA = input test tables, searches for the corresponding volume/sector determined from the file name and path.
  *  TOSCAFileList = file with a list of TOSCA tables
  *  TOSCASecorComparison: compare each if the listed TOSCA txt tables with those of the other sectors
+ *
+ *  testBatch: check that MagneticField::inTeslaBatch gives the same values as inTesla, also
+ *  around the region of the parametrization, where it must not ask the parametrization for
+ *  the points outside its validity region (which would print a warning for each of them)
  * 
  *  \author N. Amapane - CERN
  */
@@ -36,6 +40,7 @@
 #include "DataFormats/GeometryVector/interface/CoordinateSets.h"
 #include "MagneticField/GeomBuilder/test/stubs/GlobalPointProvider.h"
 #include "MagneticField/VolumeBasedEngine/interface/MagGeometry.h"
+#include "MagneticField/VolumeBasedEngine/interface/VolumeBasedMagneticField.h"
 #include "MagneticField/VolumeGeometry/interface/MagVolume6Faces.h"
 
 #include <iostream>
@@ -70,6 +75,8 @@ public:
     OuterRadius = pset.getUntrackedParameter<double>("OuterRadius", 900);
     //    half length of test cylinder
     HalfLength = pset.getUntrackedParameter<double>("HalfLength", 2400);
+    //    compare the batch interface with the one for single points
+    testBatch = pset.getUntrackedParameter<bool>("testBatch", true);
   }
 
   ~testMagneticField() {}
@@ -112,6 +119,11 @@ public:
       validate(inputFile, inputFileType);
     }
 
+    if (testBatch) {
+      validateBatch(numberOfPoints);
+      validateBatchOutsideParametrization(numberOfPoints);
+    }
+
     // Some ad-hoc test
     //    for (float phi = 0; phi<Geom::twoPi(); phi+=Geom::pi()/48.) {
     //      go(GlobalPoint(Cylindrical2Cartesian<float>(89.,phi,145.892)), magfield.product());
@@ -121,6 +133,8 @@ public:
   void writeValidationTable(int npoints, string filename);
   void validate(string filename, string type = "xyz");
   void validateVsTOSCATable(string filename);
+  void validateBatch(int npoints);
+  void validateBatchOutsideParametrization(int npoints);
 
   const MagVolume6Faces* findVolume(GlobalPoint& gp);
   const MagVolume6Faces* findMasterVolume(int volume, int sector);
@@ -139,6 +153,7 @@ private:
   double OuterRadius;
   double InnerRadius;
   double HalfLength;
+  bool testBatch;
 };
 
 void testMagneticField::writeValidationTable(int npoints, string filename) {
@@ -205,6 +220,125 @@ void testMagneticField::validate(string filename, string type) {
        << endl;
 }
 
+void testMagneticField::validateBatch(int npoints) {
+  GlobalPointProvider p(InnerRadius, OuterRadius, -Geom::pi(), Geom::pi(), -HalfLength, HalfLength);
+
+  const unsigned int batchSize = 64;
+  vector<GlobalPoint> points(batchSize);
+  vector<GlobalVector> batchB(batchSize);
+
+  int fail = 0;
+  int count = 0;
+  float maxdelta = 0.;
+
+  while (count < npoints) {
+    // points along a straight line between two random points, as along a trajectory, so that
+    // most of them are in the same volume as the previous one
+    GlobalPoint start = p.getPoint();
+    GlobalVector step = (p.getPoint() - start) / float(batchSize);
+    for (unsigned int i = 0; i < batchSize; ++i) {
+      points[i] = start + float(i) * step;
+    }
+    field->inTeslaBatch(points.data(), batchB.data(), batchSize);
+
+    for (unsigned int i = 0; i < batchSize; ++i) {
+      GlobalVector B = field->inTesla(points[i]);
+      float delta = (batchB[i] - B).mag();
+      if (delta > reso) {
+        ++fail;
+        cout << " Discrepancy at: " << points[i] << " R " << points[i].perp() << " Phi " << points[i].phi()
+             << " inTesla: " << B << " inTeslaBatch: " << batchB[i] << endl;
+      }
+      maxdelta = max(maxdelta, delta);
+      count++;
+    }
+  }
+  cout << endl
+       << " testMagneticField::validateBatch: tested " << count << " points " << fail
+       << " failures; max delta = " << maxdelta << endl
+       << endl;
+}
+
+namespace {
+  // Forwards to a parametrization, counting the calls to inTesla for points outside
+  // its validity region, for which the parametrizations print a warning
+  class CountingParametrization : public MagneticField {
+  public:
+    explicit CountingParametrization(const MagneticField* param) : param_(param) {}
+
+    GlobalVector inTesla(const GlobalPoint& gp) const override {
+      if (!param_->isDefined(gp))
+        ++outsideCalls_;
+      return param_->inTesla(gp);
+    }
+    GlobalVector inTeslaUnchecked(const GlobalPoint& gp) const override { return param_->inTeslaUnchecked(gp); }
+    bool isDefined(const GlobalPoint& gp) const override { return param_->isDefined(gp); }
+
+    unsigned int outsideCalls() const { return outsideCalls_; }
+
+  private:
+    const MagneticField* param_;
+    mutable unsigned int outsideCalls_ = 0;
+  };
+}  // namespace
+
+void testMagneticField::validateBatchOutsideParametrization(int npoints) {
+  const VolumeBasedMagneticField* vbf = dynamic_cast<const VolumeBasedMagneticField*>(field);
+  if (vbf == nullptr || vbf->paramField == nullptr) {
+    cout << " testMagneticField::validateBatchOutsideParametrization: no parametrization, skipped" << endl;
+    return;
+  }
+  // shallow copy of the field whose parametrization counts the calls outside its validity region
+  CountingParametrization param(vbf->paramField);
+  VolumeBasedMagneticField countingField(*vbf);
+  countingField.paramField = &param;
+
+  // a region a bit larger than the one of the parametrizations (R < 115 cm, |Z| < 280 cm)
+  GlobalPointProvider p(0., 300., -Geom::pi(), Geom::pi(), -500., 500.);
+
+  const unsigned int batchSize = 64;
+  vector<GlobalPoint> points(batchSize);
+  vector<GlobalVector> batchB(batchSize);
+
+  int fail = 0;
+  int count = 0;
+  int inside = 0;
+  float maxdelta = 0.;
+
+  while (count < npoints) {
+    // lines crossing the border of the parametrization most of the time
+    GlobalPoint start = p.getPoint();
+    GlobalVector step = (p.getPoint() - start) / float(batchSize);
+    for (unsigned int i = 0; i < batchSize; ++i) {
+      points[i] = start + float(i) * step;
+    }
+    countingField.inTeslaBatch(points.data(), batchB.data(), batchSize);
+
+    for (unsigned int i = 0; i < batchSize; ++i) {
+      if (param.isDefined(points[i]))
+        ++inside;
+      GlobalVector B = field->inTesla(points[i]);
+      float delta = (batchB[i] - B).mag();
+      if (delta > reso) {
+        ++fail;
+        cout << " Discrepancy at: " << points[i] << " R " << points[i].perp() << " Phi " << points[i].phi()
+             << " inTesla: " << B << " inTeslaBatch: " << batchB[i] << endl;
+      }
+      maxdelta = max(maxdelta, delta);
+      count++;
+    }
+  }
+  if (param.outsideCalls() > 0) {
+    ++fail;
+    cout << " inTeslaBatch asked the parametrization for " << param.outsideCalls()
+         << " points outside its validity region" << endl;
+  }
+  cout << endl
+       << " testMagneticField::validateBatchOutsideParametrization: tested " << count << " points (" << inside
+       << " inside the parametrization) " << fail << " failures; max delta = " << maxdelta << endl
+       << endl;
+}
+
 void testMagneticField::parseTOSCATablePath(string filename, int& volNo, int& sector, string& type) {
   // Determine volume number, type, and sector from filename, assumed to be like:
   // [path]/s01_1/v-xyz-1156.table
@@ -31,6 +31,9 @@ public:
 
   GlobalVector inTeslaUnchecked(const GlobalPoint& gp) const override;
 
+  /// Zero outside the validity region, as inTesla, but without logging
+  void inTeslaBatch(const GlobalPoint* gp, GlobalVector* b, unsigned int n) const override;
+
   inline float B0Z(const float a) const;
 
   inline float Kr(const float R2) const;
@@ -10,6 +10,8 @@
 
 #include "MagneticField/Engine/interface/MagneticField.h"
 
+#include <algorithm>
+
 class UniformMagneticField final : public MagneticField {
 public:
   ///Construct passing the Z field component in Tesla
@@ -26,6 +28,10 @@ public:
 
   GlobalVector inTeslaUnchecked(const GlobalPoint& gp) const override { return theField; }
 
+  void inTeslaBatch(const GlobalPoint*, GlobalVector* b, unsigned int n) const override {
+    std::fill(b, b + n, theField);
+  }
+
   bool isDefined(const GlobalPoint& gp) const override { return true; }
 
 private:
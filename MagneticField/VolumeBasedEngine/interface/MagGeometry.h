@@ -11,7 +11,6 @@
 #include "MagneticField/Layers/src/MagBinFinders.h"
 
 #include <vector>
-#include <atomic>
 
 class MagBLayer;
 class MagESector;
@@ -43,7 +42,8 @@ public:
   /// Return field vector at the specified global point
   GlobalVector fieldInTesla(const GlobalPoint& gp) const;
 
-  /// Find a volume
+  /// Find a volume. The last volume found is cached per thread, so that
+  /// threads working in different regions do not evict each other's entry.
   MagVolume const* findVolume(const GlobalPoint& gp, double tolerance = 0.) const;
 
   // Deprecated, will be removed
@@ -61,7 +61,7 @@ private:
 
   bool inBarrel(const GlobalPoint& gp) const;
 
-  mutable std::atomic<MagVolume const*> lastVolume;  // Cache last volume found
+  const unsigned long long theId;  // Identifies this geometry in the per-thread cache of the last volume
 
   std::vector<MagBLayer const*> theBLayers;
   std::vector<MagESector const*> theESectors;
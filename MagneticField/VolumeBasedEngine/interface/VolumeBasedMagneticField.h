@@ -43,6 +43,8 @@ public:
 
   GlobalVector inTeslaUnchecked(const GlobalPoint& g) const override;
 
+  void inTeslaBatch(const GlobalPoint* gp, GlobalVector* b, unsigned int n) const override;
+
   const MagVolume* findVolume(const GlobalPoint& gp) const;
 
   bool isDefined(const GlobalPoint& gp) const override;
@@ -18,11 +18,24 @@
 #include "MagneticField/Layers/interface/MagVerbosity.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
+#include <atomic>
 #include <iostream>
 
 using namespace std;
 using namespace edm;
 
+namespace {
+  std::atomic<unsigned long long> nextGeometryId{1};
+
+  // Last volume found by this thread. The geometry id is unique over the
+  // job, so an entry left by a deleted geometry is never used.
+  struct LastVolumeCache {
+    unsigned long long geometryId = 0;
+    MagVolume const* volume = nullptr;
+  };
+  thread_local LastVolumeCache lastVolume;
+}  // namespace
+
 MagGeometry::MagGeometry(int geomVersion,
                          const std::vector<MagBLayer*>& tbl,
                          const std::vector<MagESector*>& tes,
@@ -39,7 +52,7 @@ MagGeometry::MagGeometry(int geomVersion,
                          const std::vector<MagESector const*>& tes,
                          const std::vector<MagVolume6Faces const*>& tbv,
                          const std::vector<MagVolume6Faces const*>& tev)
-    : lastVolume(nullptr),
+    : theId(nextGeometryId++),
       theBLayers(tbl),
       theESectors(tes),
       theBVolumes(tbv),
@@ -149,9 +162,9 @@ MagVolume const* MagGeometry::findVolume1(const GlobalPoint& gp, double toleranc
 // Use hierarchical structure for fast lookup.
 MagVolume const* MagGeometry::findVolume(const GlobalPoint& gp, double tolerance) const {
   // Check volume cache
-  auto lastVolumeCheck = lastVolume.load(std::memory_order_acquire);
-  if (lastVolumeCheck != nullptr && lastVolumeCheck->inside(gp)) {
-    return lastVolumeCheck;
+  LastVolumeCache& cache = lastVolume;
+  if (cache.geometryId == theId && cache.volume != nullptr && cache.volume->inside(gp)) {
+    return cache.volume;
   }
 
   MagVolume const* result = nullptr;
@@ -192,8 +205,10 @@ MagVolume const* MagGeometry::findVolume(const GlobalPoint& gp, double tolerance
     result = findVolume(gp, 0.03);
   }
 
-  if (cacheLastVolume)
-    lastVolume.store(result, std::memory_order_release);
+  if (cacheLastVolume) {
+    cache.geometryId = theId;
+    cache.volume = result;
+  }
 
   return result;
 }
@@ -56,6 +56,19 @@ GlobalVector VolumeBasedMagneticField::inTeslaUnchecked(const GlobalPoint& gp) c
   return field->fieldInTesla(gp);
 }
 
+void VolumeBasedMagneticField::inTeslaBatch(const GlobalPoint* gp, GlobalVector* b, unsigned int n) const {
+  // Same as inTesla() for each point. The parametrization is only called
+  // for the points where it is defined, since the parametrizations warn
+  // about the points outside their validity region. Consecutive points are
+  // usually in the same volume, which is then found in the cache.
+  for (unsigned int i = 0; i < n; ++i) {
+    if (paramField && paramField->isDefined(gp[i]))
+      b[i] = paramField->inTeslaUnchecked(gp[i]);
+    else
+      b[i] = isDefined(gp[i]) ? field->fieldInTesla(gp[i]) : GlobalVector();
+  }
+}
+
 const MagVolume* VolumeBasedMagneticField::findVolume(const GlobalPoint& gp) const { return field->findVolume(gp); }
 
 bool VolumeBasedMagneticField::isDefined(const GlobalPoint& gp) const {
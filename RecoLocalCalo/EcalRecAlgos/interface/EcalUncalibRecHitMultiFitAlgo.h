@@ -13,6 +13,7 @@
 #include "CondFormats/EcalObjects/interface/EcalPedestals.h"
 #include "CondFormats/EcalObjects/interface/EcalGainRatios.h"
 #include "RecoLocalCalo/EcalRecAlgos/interface/PulseChiSqSNNLS.h"
+#include "RecoLocalCalo/EcalRecAlgos/interface/PulseChiSqSNNLSBatch.h"
 
 #include "TMatrixDSym.h"
 #include "TVectorD.h"
@@ -38,7 +39,44 @@ public:
   void setSimplifiedNoiseModelForGainSwitch(bool b) { _simplifiedNoiseModelForGainSwitch = b; }
   void setGainSwitchUseMaxSample(bool b) { _gainSwitchUseMaxSample = b; }
 
+  /// Batched fit, see PulseChiSqSNNLSBatch: the channels accepted by addToBatch are fitted
+  /// together by fitBatch, and their rechits are then made in the order they were added.
+  void clearBatch(const BXVector &activeBX) {
+    _batch.reset(activeBX);
+    _batchIds.clear();
+    _batchPedestals.clear();
+  }
+  /// Returns false, and does not add the channel, if it needs a feature the batched fit does not have
+  /// (prefit, amplitude uncertainty, dynamic pedestals, special treatment of gain switches)
+  bool addToBatch(const EcalDataFrame &dataFrame,
+                  const EcalPedestals::Item *aped,
+                  const EcalMGPAGainRatio *aGain,
+                  const SampleMatrixGainArray &noisecors,
+                  const FullSampleVector &fullpulse,
+                  const FullSampleMatrix &fullpulsecov);
+  void fitBatch() { _batch.fit(); }
+  EcalUncalibratedRecHit makeBatchRecHit(unsigned int i) const;
+
 private:
+  static constexpr unsigned int iSampleMax = 5;
+
+  void fillSamples(const EcalDataFrame &dataFrame,
+                   const EcalPedestals::Item *aped,
+                   const EcalMGPAGainRatio *aGain,
+                   bool dynamicPedestal,
+                   SampleVector &amplitudes,
+                   SampleGainVector &gainsNoise,
+                   SampleGainVector &gainsPedestal,
+                   double &maxamplitude,
+                   double &pedval) const;
+  bool mitigateBadSample(bool hasGainSwitch, const SampleGainVector &gainsNoise) const;
+  SampleMatrix noiseCovariance(const EcalPedestals::Item *aped,
+                               const EcalMGPAGainRatio *aGain,
+                               const SampleMatrixGainArray &noisecors,
+                               const SampleGainVector &gainsNoise,
+                               bool hasGainSwitch,
+                               bool dynamicPedestal) const;
+
   PulseChiSqSNNLS _pulsefunc;
   PulseChiSqSNNLS _pulsefuncSingle;
   bool _computeErrors;
@@ -51,6 +89,10 @@ private:
   bool _simplifiedNoiseModelForGainSwitch;
   bool _gainSwitchUseMaxSample;
   BXVector _singlebx;
+
+  PulseChiSqSNNLSBatch _batch;
+  std::vector<DetId> _batchIds;
+  std::vector<double> _batchPedestals;
 };
 
 #endif
@@ -0,0 +1,110 @@
+#ifndef RecoLocalCalo_EcalRecAlgos_PulseChiSqSNNLSBatch_h
+#define RecoLocalCalo_EcalRecAlgos_PulseChiSqSNNLSBatch_h
+
+/** \class PulseChiSqSNNLSBatch
+ *  Multi-template fit of all the channels of an event at once.
+ *
+ *  This is the fit of PulseChiSqSNNLS::DoFit for a set of bunch crossings
+ *  common to all channels, without dynamic pedestals, without step
+ *  corrections for bad samples and without the amplitude uncertainties.
+ *  The channels are stored as structure of arrays and fitted W at a time:
+ *  the covariance, its Cholesky decomposition, the triangular solves, the
+ *  normal equations and the chi2 are computed for the W channels together
+ *  using compiler vector extensions. The active-set updates of the NNLS
+ *  depend on each channel and are done one channel at a time, on fixed-size
+ *  matrices, in the same order as in PulseChiSqSNNLS, so that the results
+ *  agree with it up to rounding.
+ *
+ *  Usage:
+ *    PulseChiSqSNNLSBatch batch;
+ *    batch.reset(bxs);
+ *    for (...) batch.push_back(samples, samplecov, fullpulse, fullpulsecov);
+ *    batch.fit();
+ *    for (unsigned int i = 0; i < batch.size(); ++i) use(batch.X(i, ipulse), batch.ChiSq(i));
+ */
+
+#define EIGEN_NO_DEBUG  // kill throws in eigen code
+#include "RecoLocalCalo/EcalRecAlgos/interface/EigenMatrixTypes.h"
+
+#include <vector>
+
+class PulseChiSqSNNLSBatch {
+public:
+  typedef BXVector::Index Index;
+
+  // packed lower triangle of a matrix of size n, as in ROOT::Math::MatRepSym
+  static constexpr unsigned int symSize(unsigned int n) { return n * (n + 1) / 2; }
+  static constexpr unsigned int symIndex(unsigned int i, unsigned int j) {
+    return i >= j ? i * (i + 1) / 2 + j : j * (j + 1) / 2 + i;
+  }
+
+  // the pulse covariance is only used from this sample on, whatever the bunch crossing
+  static constexpr unsigned int firstPulseCovSample = 7;
+  static constexpr unsigned int nPulseCov = FullSampleVectorSize - firstPulseCovSample;
+
+  /// Removes all the channels and sets the bunch crossings of the pulses fitted in each channel
+  void reset(const BXVector &bxs);
+  void reserve(unsigned int n);
+
+  /// Adds a channel, the arguments are those of PulseChiSqSNNLS::DoFit
+  void push_back(const SampleVector &samples,
+                 const SampleMatrix &samplecov,
+                 const FullSampleVector &fullpulse,
+                 const FullSampleMatrix &fullpulsecov);
+
+  unsigned int size() const { return chisq_.size(); }
+
+  /// Fits all channels
+  void fit();
+
+  /// Only after fit(). The pulses are in the order of the bunch crossings given to reset()
+  const BXVector &BXs() const { return bxs_; }
+  double X(unsigned int i, unsigned int ipulse) const { return amplitudes_[ipulse][i]; }
+  double ChiSq(unsigned int i) const { return chisq_[i]; }
+  /// False if the Cholesky decomposition of the covariance of channel i hit a non-positive pivot.
+  /// PulseChiSqSNNLS::DoFit does not check this and returns true, so there is no scalar equivalent.
+  bool Status(unsigned int i) const { return status_[i]; }
+
+  void setMaxIters(int n) { maxiters_ = n; }
+
+private:
+  // state of the active-set minimization of one channel
+  struct ChannelState {
+    PulseVector ampvec;                                // in the order of bxs_
+    std::array<unsigned char, PulseVectorSize> perm;  // pulses ordered as in PulseChiSqSNNLS, the first nP are free
+    unsigned int nP;
+    double chisq;
+    bool done;
+    bool status;
+  };
+
+  template <int W>
+  void fitChannels(unsigned int first);
+  static void NNLS(const PulseMatrix &aTamat, const PulseVector &aTbvec, ChannelState &state);
+
+  BXVector bxs_;
+  int maxiters_ = 50;
+
+  // The inputs are stored by blocks of blockSize channels, all the values of a
+  // given kind being contiguous for the channels of a block. A plain structure
+  // of arrays would need too many streams of memory to be read efficiently.
+  static constexpr unsigned int blockSize = 8;
+  static constexpr unsigned int iSamples = 0;
+  static constexpr unsigned int iSampleCov = iSamples + SampleVectorSize;
+  static constexpr unsigned int iFullPulse = iSampleCov + SampleVectorSize * (SampleVectorSize + 1) / 2;
+  static constexpr unsigned int iPulseCov = iFullPulse + FullSampleVectorSize;
+  static constexpr unsigned int nInputs = iPulseCov + nPulseCov * (nPulseCov + 1) / 2;
+  double &input(unsigned int k, unsigned int i) {
+    return inputs_[(i / blockSize * nInputs + k) * blockSize + i % blockSize];
+  }
+  const double &input(unsigned int k, unsigned int i) const {
+    return inputs_[(i / blockSize * nInputs + k) * blockSize + i % blockSize];
+  }
+  std::vector<double> inputs_;
+
+  std::vector<double> amplitudes_[PulseVectorSize];
+  std::vector<double> chisq_;
+  std::vector<char> status_;
+};
+
+#endif
@@ -33,13 +33,10 @@ EcalUncalibratedRecHit EcalUncalibRecHitMultiFitAlgo::makeRecHit(const EcalDataF
                                                                  const BXVector &activeBX) {
   uint32_t flags = 0;
 
-  const unsigned int nsample = EcalDataFrame::MAXSAMPLES;
-
-  double maxamplitude = -std::numeric_limits<double>::max();
-  const unsigned int iSampleMax = 5;
   const unsigned int iFullPulseMax = 9;
 
-  double pedval = 0.;
+  double maxamplitude;
+  double pedval;
 
   SampleVector amplitudes;
   SampleGainVector gainsNoise;
@@ -51,6 +48,160 @@ EcalUncalibratedRecHit EcalUncalibRecHitMultiFitAlgo::makeRecHit(const EcalDataF
   //no dynamic pedestal in case of gain switch, since then the fit becomes too underconstrained
   bool dynamicPedestal = _dynamicPedestals && !hasGainSwitch;
 
+  fillSamples(dataFrame, aped, aGain, dynamicPedestal, amplitudes, gainsNoise, gainsPedestal, maxamplitude, pedval);
+
+  double amplitude, amperr, chisq;
+  bool status = false;
+
+  //special handling for gain switch, where sample before maximum is potentially affected by slew rate limitation
+  //optionally apply a stricter criteria, assuming slew rate limit is only reached in case where maximum sample has gain switched but previous sample has not
+  //option 1: use simple max-sample algorithm
+  if (hasGainSwitch && _gainSwitchUseMaxSample) {
+    double maxpulseamplitude = maxamplitude / fullpulse[iFullPulseMax];
+    EcalUncalibratedRecHit rh(dataFrame.id(), maxpulseamplitude, pedval, 0., 0., flags);
+    rh.setAmplitudeError(0.);
+    for (unsigned int ipulse = 0; ipulse < _pulsefunc.BXs().rows(); ++ipulse) {
+      int bx = _pulsefunc.BXs().coeff(ipulse);
+      if (bx != 0) {
+        rh.setOutOfTimeAmplitude(bx + 5, 0.0);
+      }
+    }
+    return rh;
+  }
+
+  //option2: A floating negative single-sample offset is added to the fit
+  //such that the affected sample is treated only as a lower limit for the true amplitude
+  if (mitigateBadSample(hasGainSwitch, gainsNoise)) {
+    badSamples[iSampleMax - 1] = 1;
+  }
+
+  //compute noise covariance matrix, which depends on the sample gains
+  SampleMatrix noisecov = noiseCovariance(aped, aGain, noisecors, gainsNoise, hasGainSwitch, dynamicPedestal);
+
+  //optimized one-pulse fit for hlt
+  bool usePrefit = false;
+  if (_doPrefit) {
+    status =
+        _pulsefuncSingle.DoFit(amplitudes, noisecov, _singlebx, fullpulse, fullpulsecov, gainsPedestal, badSamples);
+    amplitude = status ? _pulsefuncSingle.X()[0] : 0.;
+    amperr = status ? _pulsefuncSingle.Errors()[0] : 0.;
+    chisq = _pulsefuncSingle.ChiSq();
+
+    if (chisq < _prefitMaxChiSq) {
+      usePrefit = true;
+    }
+  }
+
+  if (!usePrefit) {
+    if (!_computeErrors)
+      _pulsefunc.disableErrorCalculation();
+    status = _pulsefunc.DoFit(amplitudes, noisecov, activeBX, fullpulse, fullpulsecov, gainsPedestal, badSamples);
+    chisq = _pulsefunc.ChiSq();
+
+    if (!status) {
+      edm::LogWarning("EcalUncalibRecHitMultiFitAlgo::makeRecHit") << "Failed Fit" << std::endl;
+    }
+
+    unsigned int ipulseintime = 0;
+    for (unsigned int ipulse = 0; ipulse < _pulsefunc.BXs().rows(); ++ipulse) {
+      if (_pulsefunc.BXs().coeff(ipulse) == 0) {
+        ipulseintime = ipulse;
+        break;
+      }
+    }
+
+    amplitude = status ? _pulsefunc.X()[ipulseintime] : 0.;
+    amperr = status ? _pulsefunc.Errors()[ipulseintime] : 0.;
+  }
+
+  double jitter = 0.;
+
+  EcalUncalibratedRecHit rh(dataFrame.id(), amplitude, pedval, jitter, chisq, flags);
+  rh.setAmplitudeError(amperr);
+
+  if (!usePrefit) {
+    for (unsigned int ipulse = 0; ipulse < _pulsefunc.BXs().rows(); ++ipulse) {
+      int bx = _pulsefunc.BXs().coeff(ipulse);
+      if (bx != 0 && std::abs(bx) < 100) {
+        rh.setOutOfTimeAmplitude(bx + 5, status ? _pulsefunc.X().coeff(ipulse) : 0.);
+      } else if (bx == (100 + gainsPedestal[iSampleMax])) {
+        rh.setPedestal(status ? _pulsefunc.X().coeff(ipulse) : 0.);
+      }
+    }
+  }
+
+  return rh;
+}
+
+bool EcalUncalibRecHitMultiFitAlgo::addToBatch(const EcalDataFrame &dataFrame,
+                                               const EcalPedestals::Item *aped,
+                                               const EcalMGPAGainRatio *aGain,
+                                               const SampleMatrixGainArray &noisecors,
+                                               const FullSampleVector &fullpulse,
+                                               const FullSampleMatrix &fullpulsecov) {
+  if (_computeErrors || _doPrefit)
+    return false;
+  bool hasGainSwitch = dataFrame.isSaturated() || dataFrame.hasSwitchToGain6() || dataFrame.hasSwitchToGain1();
+  if ((_dynamicPedestals && !hasGainSwitch) || (hasGainSwitch && _gainSwitchUseMaxSample))
+    return false;
+
+  double maxamplitude;
+  double pedval;
+  SampleVector amplitudes;
+  SampleGainVector gainsNoise;
+  SampleGainVector gainsPedestal;
+  fillSamples(dataFrame, aped, aGain, false, amplitudes, gainsNoise, gainsPedestal, maxamplitude, pedval);
+  if (mitigateBadSample(hasGainSwitch, gainsNoise))
+    return false;
+
+  SampleMatrix noisecov = noiseCovariance(aped, aGain, noisecors, gainsNoise, hasGainSwitch, false);
+  _batch.push_back(amplitudes, noisecov, fullpulse, fullpulsecov);
+  _batchIds.push_back(dataFrame.id());
+  _batchPedestals.push_back(pedval);
+  return true;
+}
+
+EcalUncalibratedRecHit EcalUncalibRecHitMultiFitAlgo::makeBatchRecHit(unsigned int i) const {
+  const BXVector &bxs = _batch.BXs();
+  unsigned int ipulseintime = 0;
+  for (unsigned int ipulse = 0; ipulse < bxs.rows(); ++ipulse) {
+    if (bxs.coeff(ipulse) == 0) {
+      ipulseintime = ipulse;
+      break;
+    }
+  }
+
+  bool status = _batch.Status(i);
+  if (!status) {
+    edm::LogWarning("EcalUncalibRecHitMultiFitAlgo::makeBatchRecHit") << "Failed Fit" << std::endl;
+  }
+
+  double amplitude = status ? _batch.X(i, ipulseintime) : 0.;
+  EcalUncalibratedRecHit rh(_batchIds[i], amplitude, _batchPedestals[i], 0., _batch.ChiSq(i), 0);
+  rh.setAmplitudeError(0.);
+  for (unsigned int ipulse = 0; ipulse < bxs.rows(); ++ipulse) {
+    int bx = bxs.coeff(ipulse);
+    if (bx != 0) {
+      rh.setOutOfTimeAmplitude(bx + 5, status ? _batch.X(i, ipulse) : 0.);
+    }
+  }
+  return rh;
+}
+
+void EcalUncalibRecHitMultiFitAlgo::fillSamples(const EcalDataFrame &dataFrame,
+                                                const EcalPedestals::Item *aped,
+                                                const EcalMGPAGainRatio *aGain,
+                                                bool dynamicPedestal,
+                                                SampleVector &amplitudes,
+                                                SampleGainVector &gainsNoise,
+                                                SampleGainVector &gainsPedestal,
+                                                double &maxamplitude,
+                                                double &pedval) const {
+  const unsigned int nsample = EcalDataFrame::MAXSAMPLES;
+
+  maxamplitude = -std::numeric_limits<double>::max();
+  pedval = 0.;
+
   for (unsigned int iSample = 0; iSample < nsample; iSample++) {
     const EcalMGPASample &sample = dataFrame.sample(iSample);
 
@@ -101,36 +252,20 @@ EcalUncalibratedRecHit EcalUncalibRecHitMultiFitAlgo::makeRecHit(const EcalDataF
       pedval = pedestal;
     }
   }
+}
 
-  double amplitude, amperr, chisq;
-  bool status = false;
-
-  //special handling for gain switch, where sample before maximum is potentially affected by slew rate limitation
-  //optionally apply a stricter criteria, assuming slew rate limit is only reached in case where maximum sample has gain switched but previous sample has not
-  //option 1: use simple max-sample algorithm
-  if (hasGainSwitch && _gainSwitchUseMaxSample) {
-    double maxpulseamplitude = maxamplitude / fullpulse[iFullPulseMax];
-    EcalUncalibratedRecHit rh(dataFrame.id(), maxpulseamplitude, pedval, 0., 0., flags);
-    rh.setAmplitudeError(0.);
-    for (unsigned int ipulse = 0; ipulse < _pulsefunc.BXs().rows(); ++ipulse) {
-      int bx = _pulsefunc.BXs().coeff(ipulse);
-      if (bx != 0) {
-        rh.setOutOfTimeAmplitude(bx + 5, 0.0);
-      }
-    }
-    return rh;
-  }
-
-  //option2: A floating negative single-sample offset is added to the fit
-  //such that the affected sample is treated only as a lower limit for the true amplitude
-  bool mitigateBadSample = _mitigateBadSamples && hasGainSwitch && iSampleMax > 0;
-  mitigateBadSample &=
-      (!_selectiveBadSampleCriteria || (gainsNoise.coeff(iSampleMax - 1) != gainsNoise.coeff(iSampleMax)));
-  if (mitigateBadSample) {
-    badSamples[iSampleMax - 1] = 1;
-  }
+bool EcalUncalibRecHitMultiFitAlgo::mitigateBadSample(bool hasGainSwitch, const SampleGainVector &gainsNoise) const {
+  bool mitigate = _mitigateBadSamples && hasGainSwitch && iSampleMax > 0;
+  mitigate &= (!_selectiveBadSampleCriteria || (gainsNoise.coeff(iSampleMax - 1) != gainsNoise.coeff(iSampleMax)));
+  return mitigate;
+}
 
-  //compute noise covariance matrix, which depends on the sample gains
+SampleMatrix EcalUncalibRecHitMultiFitAlgo::noiseCovariance(const EcalPedestals::Item *aped,
+                                                            const EcalMGPAGainRatio *aGain,
+                                                            const SampleMatrixGainArray &noisecors,
+                                                            const SampleGainVector &gainsNoise,
+                                                            bool hasGainSwitch,
+                                                            bool dynamicPedestal) const {
   SampleMatrix noisecov;
   if (hasGainSwitch) {
     std::array<double, 3> pedrmss = {{aped->rms_x12, aped->rms_x6, aped->rms_x1}};
@@ -168,58 +303,5 @@ EcalUncalibratedRecHit EcalUncalibRecHitMultiFitAlgo::makeRecHit(const EcalDataF
       noisecov += _addPedestalUncertainty * _addPedestalUncertainty * SampleMatrix::Ones();
     }
   }
-
-  //optimized one-pulse fit for hlt
-  bool usePrefit = false;
-  if (_doPrefit) {
-    status =
-        _pulsefuncSingle.DoFit(amplitudes, noisecov, _singlebx, fullpulse, fullpulsecov, gainsPedestal, badSamples);
-    amplitude = status ? _pulsefuncSingle.X()[0] : 0.;
-    amperr = status ? _pulsefuncSingle.Errors()[0] : 0.;
-    chisq = _pulsefuncSingle.ChiSq();
-
-    if (chisq < _prefitMaxChiSq) {
-      usePrefit = true;
-    }
-  }
-
-  if (!usePrefit) {
-    if (!_computeErrors)
-      _pulsefunc.disableErrorCalculation();
-    status = _pulsefunc.DoFit(amplitudes, noisecov, activeBX, fullpulse, fullpulsecov, gainsPedestal, badSamples);
-    chisq = _pulsefunc.ChiSq();
-
-    if (!status) {
-      edm::LogWarning("EcalUncalibRecHitMultiFitAlgo::makeRecHit") << "Failed Fit" << std::endl;
-    }
-
-    unsigned int ipulseintime = 0;
-    for (unsigned int ipulse = 0; ipulse < _pulsefunc.BXs().rows(); ++ipulse) {
-      if (_pulsefunc.BXs().coeff(ipulse) == 0) {
-        ipulseintime = ipulse;
-        break;
-      }
-    }
-
-    amplitude = status ? _pulsefunc.X()[ipulseintime] : 0.;
-    amperr = status ? _pulsefunc.Errors()[ipulseintime] : 0.;
-  }
-
-  double jitter = 0.;
-
-  EcalUncalibratedRecHit rh(dataFrame.id(), amplitude, pedval, jitter, chisq, flags);
-  rh.setAmplitudeError(amperr);
-
-  if (!usePrefit) {
-    for (unsigned int ipulse = 0; ipulse < _pulsefunc.BXs().rows(); ++ipulse) {
-      int bx = _pulsefunc.BXs().coeff(ipulse);
-      if (bx != 0 && std::abs(bx) < 100) {
-        rh.setOutOfTimeAmplitude(bx + 5, status ? _pulsefunc.X().coeff(ipulse) : 0.);
-      } else if (bx == (100 + gainsPedestal[iSampleMax])) {
-        rh.setPedestal(status ? _pulsefunc.X().coeff(ipulse) : 0.);
-      }
-    }
-  }
-
-  return rh;
+  return noisecov;
 }
@@ -1,9 +1,13 @@
 #include "RecoLocalCalo/EcalRecAlgos/interface/PulseChiSqSNNLS.h"
+#include "RecoLocalCalo/EcalRecAlgos/src/PulseChiSqSNNLSSolve.h"
 #include <cmath>
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include <iostream>
 
-void eigen_solve_submatrix(PulseMatrix &mat, PulseVector &invec, PulseVector &outvec, unsigned NP) {
+void pulsechisqsnnls::detail::eigen_solve_submatrix(PulseMatrix &mat,
+                                                    PulseVector &invec,
+                                                    PulseVector &outvec,
+                                                    unsigned NP) {
   using namespace Eigen;
   switch (NP) {  // pulse matrix is always square.
     case 10: {
@@ -347,7 +351,7 @@ bool PulseChiSqSNNLS::NNLS() {
       //solve for unconstrained parameters
       //need to have specialized function to call optimized versions
       // of matrix solver... this is truly amazing...
-      eigen_solve_submatrix(aTamat, aTbvec, ampvecpermtest, _nP);
+      pulsechisqsnnls::detail::eigen_solve_submatrix(aTamat, aTbvec, ampvecpermtest, _nP);
 
       //check solution
       bool positive = true;
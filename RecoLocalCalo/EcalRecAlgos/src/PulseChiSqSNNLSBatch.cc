@@ -0,0 +1,416 @@
+#include "RecoLocalCalo/EcalRecAlgos/interface/PulseChiSqSNNLSBatch.h"
+#include "RecoLocalCalo/EcalRecAlgos/src/PulseChiSqSNNLSSolve.h"
+#include "DataFormats/Math/interface/ExtVec.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+#if defined(__AVX__)
+  constexpr int defaultWidth = 4;
+#else
+  constexpr int defaultWidth = 2;
+#endif
+
+  template <int W>
+  struct Lanes {
+    using type = ExtVec<double, W>;
+  };
+  template <>
+  struct Lanes<1> {
+    using type = double;
+  };
+
+  template <typename V>
+  inline V load(double const* p) {
+    V v;
+    std::memcpy(&v, p, sizeof(V));
+    return v;
+  }
+
+  // one of the channels processed together
+  template <typename V>
+  inline double lane(V const& v, int l) {
+    return v[l];
+  }
+  inline double lane(double v, int) { return v; }
+  template <typename V>
+  inline void setLane(V& v, int l, double x) {
+    v[l] = x;
+  }
+  inline void setLane(double& v, int, double x) { v = x; }
+
+  template <typename V>
+  inline V vsqrt(V v) {
+    for (unsigned int l = 0; l < sizeof(V) / sizeof(double); ++l)
+      v[l] = std::sqrt(v[l]);
+    return v;
+  }
+  inline double vsqrt(double v) { return std::sqrt(v); }
+
+}  // namespace
+
+void PulseChiSqSNNLSBatch::reset(const BXVector& bxs) {
+  for (unsigned int ipulse = 0; ipulse < bxs.rows(); ++ipulse) {
+    int offset = 7 - 3 - bxs.coeff(ipulse);
+    if (offset < 0 || offset + SampleVectorSize > FullSampleVectorSize)
+      throw cms::Exception("MultFitWeirdState")
+          << "Bunch crossing " << int(bxs.coeff(ipulse)) << " cannot be used in the multifit";
+  }
+  if (bxs.rows() == 0 || bxs.rows() > PulseVectorSize)
+    throw cms::Exception("MultFitWeirdState")
+        << "Weird number of pulses encountered in multifit, module is configured incorrectly!";
+  bxs_ = bxs;
+
+  inputs_.clear();
+  for (auto& v : amplitudes_)
+    v.clear();
+  chisq_.clear();
+  status_.clear();
+}
+
+void PulseChiSqSNNLSBatch::reserve(unsigned int n) {
+  inputs_.reserve((n + blockSize - 1) / blockSize * nInputs * blockSize);
+  for (auto& v : amplitudes_)
+    v.reserve(n);
+  chisq_.reserve(n);
+  status_.reserve(n);
+}
+
+void PulseChiSqSNNLSBatch::push_back(const SampleVector& samples,
+                                     const SampleMatrix& samplecov,
+                                     const FullSampleVector& fullpulse,
+                                     const FullSampleMatrix& fullpulsecov) {
+  const unsigned int n = size();
+  if (n % blockSize == 0)
+    inputs_.resize(inputs_.size() + nInputs * blockSize);
+  for (unsigned int i = 0; i < SampleVectorSize; ++i) {
+    input(iSamples + i, n) = samples.coeff(i);
+    for (unsigned int j = 0; j <= i; ++j)
+      input(iSampleCov + symIndex(i, j), n) = samplecov.coeff(i, j);
+  }
+  for (unsigned int i = 0; i < FullSampleVectorSize; ++i)
+    input(iFullPulse + i, n) = fullpulse.coeff(i);
+  for (unsigned int i = 0; i < nPulseCov; ++i)
+    for (unsigned int j = 0; j <= i; ++j)
+      input(iPulseCov + symIndex(i, j), n) = fullpulsecov.coeff(i + firstPulseCovSample, j + firstPulseCovSample);
+
+  for (auto& v : amplitudes_)
+    v.push_back(0.);
+  chisq_.push_back(0.);
+  status_.push_back(false);
+}
+
+void PulseChiSqSNNLSBatch::fit() {
+  static_assert(blockSize % defaultWidth == 0, "the channels fitted together must be in the same block");
+  const unsigned int n = size();
+  unsigned int first = 0;
+  for (; first + defaultWidth <= n; first += defaultWidth)
+    fitChannels<defaultWidth>(first);
+  for (; first < n; ++first)
+    fitChannels<1>(first);
+}
+
+template <int W>
+void PulseChiSqSNNLSBatch::fitChannels(unsigned int first) {
+  using V = typename Lanes<W>::type;
+  constexpr unsigned int nsample = SampleVectorSize;
+  const unsigned int npulse = bxs_.rows();
+
+  V sampvec[nsample];
+  for (unsigned int i = 0; i < nsample; ++i)
+    sampvec[i] = load<V>(&input(iSamples + i, first));
+
+  //initialize pulse template matrix
+  V pulsemat[nsample][PulseVectorSize];
+  for (unsigned int ipulse = 0; ipulse < npulse; ++ipulse) {
+    int offset = 7 - 3 - bxs_.coeff(ipulse);
+    for (unsigned int i = 0; i < nsample; ++i)
+      pulsemat[i][ipulse] = load<V>(&input(iFullPulse + i + offset, first));
+  }
+
+  //the covariances are used at each iteration
+  V samplecov[symSize(nsample)];
+  for (unsigned int k = 0; k < symSize(nsample); ++k)
+    samplecov[k] = load<V>(&input(iSampleCov + k, first));
+  V pulsecov[symSize(nPulseCov)];
+  for (unsigned int k = 0; k < symSize(nPulseCov); ++k)
+    pulsecov[k] = load<V>(&input(iPulseCov + k, first));
+
+  ChannelState states[W];
+  for (int l = 0; l < W; ++l) {
+    auto& state = states[l];
+    state.ampvec = PulseVector::Zero(npulse);
+    for (unsigned int ipulse = 0; ipulse < npulse; ++ipulse)
+      state.perm[ipulse] = ipulse;
+    state.nP = 0;
+    state.chisq = 0.;
+    state.done = false;
+    state.status = true;
+    if (npulse == 1)
+      state.ampvec.coeffRef(0) = input(iSamples + bxs_.coeff(0) + 5, first + l);
+  }
+
+  PulseMatrix aTamat(npulse, npulse);
+  PulseVector aTbvec(npulse);
+  for (int iter = 0; iter < maxiters_; ++iter) {
+    //covariance including the pulse shape uncertainty, see PulseChiSqSNNLS::updateCov
+    V invcov[symSize(nsample)];
+    for (unsigned int k = 0; k < symSize(nsample); ++k)
+      invcov[k] = samplecov[k];
+    for (unsigned int ipulse = 0; ipulse < npulse; ++ipulse) {
+      V ampsq;
+      bool zero = true;
+      for (int l = 0; l < W; ++l) {
+        const double ampveccoef = states[l].ampvec.coeff(ipulse);
+        setLane(ampsq, l, ampveccoef * ampveccoef);
+        zero &= ampveccoef == 0.;
+      }
+      if (zero)
+        continue;
+      int bx = bxs_.coeff(ipulse);
+      int firstsamplet = std::max(0, bx + 3);
+      int offset = 7 - 3 - bx - firstPulseCovSample;
+      for (int i = firstsamplet; i < int(nsample); ++i)
+        for (int j = firstsamplet; j <= i; ++j)
+          invcov[symIndex(i, j)] += ampsq * pulsecov[symIndex(i + offset, j + offset)];
+    }
+
+    //Cholesky decomposition, the inverse of the diagonal is kept for the solves
+    V covL[symSize(nsample)];
+    V covLinvdiag[nsample];
+    for (unsigned int j = 0; j < nsample; ++j) {
+      V d = invcov[symIndex(j, j)];
+      for (unsigned int k = 0; k < j; ++k)
+        d -= covL[symIndex(j, k)] * covL[symIndex(j, k)];
+      for (int l = 0; l < W; ++l) {
+        //as Eigen::LLT, which fails for a non-positive pivot
+        if (!(lane(d, l) > 0.) && !states[l].done) {
+          states[l].status = false;
+          states[l].done = true;
+        }
+      }
+      d = vsqrt(d);
+      covL[symIndex(j, j)] = d;
+      covLinvdiag[j] = 1. / d;
+      for (unsigned int i = j + 1; i < nsample; ++i) {
+        V e = invcov[symIndex(i, j)];
+        for (unsigned int k = 0; k < j; ++k)
+          e -= covL[symIndex(i, k)] * covL[symIndex(j, k)];
+        covL[symIndex(i, j)] = e * covLinvdiag[j];
+      }
+    }
+    auto solveL = [&](V* vec) {
+      for (unsigned int i = 0; i < nsample; ++i) {
+        V e = vec[i];
+        for (unsigned int k = 0; k < i; ++k)
+          e -= covL[symIndex(i, k)] * vec[k];
+        vec[i] = e * covLinvdiag[i];
+      }
+    };
+
+    //normal equations, see PulseChiSqSNNLS::NNLS
+    V invcovp[PulseVectorSize][nsample];
+    for (unsigned int ipulse = 0; ipulse < npulse; ++ipulse) {
+      for (unsigned int i = 0; i < nsample; ++i)
+        invcovp[ipulse][i] = pulsemat[i][ipulse];
+      solveL(invcovp[ipulse]);
+    }
+    V invcovs[nsample];
+    for (unsigned int i = 0; i < nsample; ++i)
+      invcovs[i] = sampvec[i];
+    solveL(invcovs);
+
+    V aTa[symSize(PulseVectorSize)];
+    V aTb[PulseVectorSize];
+    for (unsigned int ipulse = 0; ipulse < npulse; ++ipulse) {
+      for (unsigned int jpulse = 0; jpulse <= ipulse; ++jpulse) {
+        V e = invcovp[ipulse][0] * invcovp[jpulse][0];
+        for (unsigned int i = 1; i < nsample; ++i)
+          e += invcovp[ipulse][i] * invcovp[jpulse][i];
+        aTa[symIndex(ipulse, jpulse)] = e;
+      }
+      V e = invcovp[ipulse][0] * invcovs[0];
+      for (unsigned int i = 1; i < nsample; ++i)
+        e += invcovp[ipulse][i] * invcovs[i];
+      aTb[ipulse] = e;
+    }
+
+    //minimization, one channel at a time
+    for (int l = 0; l < W; ++l) {
+      auto& state = states[l];
+      if (state.done)
+        continue;
+      for (unsigned int ipulse = 0; ipulse < npulse; ++ipulse) {
+        aTbvec.coeffRef(ipulse) = lane(aTb[ipulse], l);
+        for (unsigned int jpulse = 0; jpulse <= ipulse; ++jpulse)
+          aTamat.coeffRef(ipulse, jpulse) = aTamat.coeffRef(jpulse, ipulse) =
+              lane(aTa[symIndex(ipulse, jpulse)], l);
+      }
+      if (npulse > 1) {
+        NNLS(aTamat, aTbvec, state);
+      } else {
+        //special case for one pulse fit, see PulseChiSqSNNLS::OnePulseMinimize
+        state.ampvec.coeffRef(0) = std::max(0., aTbvec.coeff(0) / aTamat.coeff(0, 0));
+      }
+    }
+
+    //chi2 with the new amplitudes, but the covariance of the previous ones, see PulseChiSqSNNLS::ComputeChiSq
+    V ampvec[PulseVectorSize];
+    for (unsigned int ipulse = 0; ipulse < npulse; ++ipulse)
+      for (int l = 0; l < W; ++l)
+        setLane(ampvec[ipulse], l, states[l].ampvec.coeff(ipulse));
+    V resvec[nsample];
+    for (unsigned int i = 0; i < nsample; ++i) {
+      V e = pulsemat[i][0] * ampvec[0];
+      for (unsigned int ipulse = 1; ipulse < npulse; ++ipulse)
+        e += pulsemat[i][ipulse] * ampvec[ipulse];
+      resvec[i] = e - sampvec[i];
+    }
+    solveL(resvec);
+    V chisq = resvec[0] * resvec[0];
+    for (unsigned int i = 1; i < nsample; ++i)
+      chisq += resvec[i] * resvec[i];
+
+    bool done = true;
+    for (int l = 0; l < W; ++l) {
+      auto& state = states[l];
+      if (!state.done) {
+        double chisqnow = lane(chisq, l);
+        double deltachisq = chisqnow - state.chisq;
+        state.chisq = chisqnow;
+        state.done = std::abs(deltachisq) < 1e-3;
+      }
+      done &= state.done;
+    }
+    if (done)
+      break;
+  }
+
+  for (int l = 0; l < W; ++l) {
+    chisq_[first + l] = states[l].chisq;
+    status_[first + l] = states[l].status;
+    for (unsigned int ipulse = 0; ipulse < npulse; ++ipulse)
+      amplitudes_[ipulse][first + l] = states[l].ampvec.coeff(ipulse);
+  }
+}
+
+void PulseChiSqSNNLSBatch::NNLS(const PulseMatrix& aTamat, const PulseVector& aTbvec, ChannelState& state) {
+  //Fast NNLS (fnnls) algorithm as in PulseChiSqSNNLS::NNLS, on copies of the inputs ordered as state.perm
+
+  const unsigned int npulse = aTbvec.rows();
+  constexpr unsigned int nsamples = SampleVectorSize;
+  auto& perm = state.perm;
+  auto& nP = state.nP;
+
+  PulseMatrix aTamatperm(npulse, npulse);
+  PulseVector aTbvecperm(npulse);
+  PulseVector ampvecperm(npulse);
+  for (unsigned int i = 0; i < npulse; ++i) {
+    for (unsigned int j = 0; j < npulse; ++j)
+      aTamatperm.coeffRef(i, j) = aTamat.coeff(perm[i], perm[j]);
+    aTbvecperm.coeffRef(i) = aTbvec.coeff(perm[i]);
+    ampvecperm.coeffRef(i) = state.ampvec.coeff(perm[i]);
+  }
+
+  auto swapParameters = [&](unsigned int i, unsigned int j) {
+    aTamatperm.col(i).swap(aTamatperm.col(j));
+    aTamatperm.row(i).swap(aTamatperm.row(j));
+    std::swap(aTbvecperm.coeffRef(i), aTbvecperm.coeffRef(j));
+    std::swap(ampvecperm.coeffRef(i), ampvecperm.coeffRef(j));
+    std::swap(perm[i], perm[j]);
+  };
+
+  PulseVector updatework;
+  PulseVector ampvecpermtest;
+
+  int iter = 0;
+  Index idxwmax = 0;
+  double wmax = 0.0;
+  double threshold = 1e-11;
+  while (true) {
+    //can only perform this step if solution is guaranteed viable
+    if (iter > 0 || nP == 0) {
+      if (nP == std::min(npulse, nsamples))
+        break;
+
+      const unsigned int nActive = npulse - nP;
+
+      updatework = aTbvecperm - aTamatperm * ampvecperm;
+      Index idxwmaxprev = idxwmax;
+      double wmaxprev = wmax;
+      wmax = updatework.tail(nActive).maxCoeff(&idxwmax);
+
+      //convergence
+      if (wmax < threshold || (idxwmax == idxwmaxprev && wmax == wmaxprev))
+        break;
+
+      //worst case protection
+      if (iter >= 500) {
+        LogDebug("PulseChiSqSNNLSBatch::NNLS()") << "Max Iterations reached at iter " << iter;
+        break;
+      }
+
+      //unconstrain parameter
+      swapParameters(nP, nP + idxwmax);
+      ++nP;
+    }
+
+    while (true) {
+      if (nP == 0)
+        break;
+
+      ampvecpermtest = ampvecperm;
+
+      //solve for unconstrained parameters
+      pulsechisqsnnls::detail::eigen_solve_submatrix(aTamatperm, aTbvecperm, ampvecpermtest, nP);
+
+      //check solution
+      bool positive = true;
+      for (unsigned int i = 0; i < nP; ++i)
+        positive &= (ampvecpermtest(i) > 0);
+      if (positive) {
+        ampvecperm.head(nP) = ampvecpermtest.head(nP);
+        break;
+      }
+
+      //update parameter vector
+      Index minratioidx = 0;
+      double minratio = std::numeric_limits<double>::max();
+      for (unsigned int ipulse = 0; ipulse < nP; ++ipulse) {
+        if (ampvecpermtest.coeff(ipulse) <= 0.) {
+          const double c_ampvec = ampvecperm.coeff(ipulse);
+          const double ratio = c_ampvec / (c_ampvec - ampvecpermtest.coeff(ipulse));
+          if (ratio < minratio) {
+            minratio = ratio;
+            minratioidx = ipulse;
+          }
+        }
+      }
+
+      ampvecperm.head(nP) += minratio * (ampvecpermtest.head(nP) - ampvecperm.head(nP));
+
+      //avoid numerical problems with later ==0. check
+      ampvecperm.coeffRef(minratioidx) = 0.;
+
+      //constrain parameter
+      swapParameters(nP - 1, minratioidx);
+      --nP;
+    }
+    ++iter;
+
+    //adaptive convergence threshold to avoid infinite loops but still
+    //ensure best value is used
+    if (iter % 16 == 0) {
+      threshold *= 2;
+    }
+  }
+
+  for (unsigned int i = 0; i < npulse; ++i)
+    state.ampvec.coeffRef(perm[i]) = ampvecperm.coeff(i);
+}
@@ -0,0 +1,13 @@
+#ifndef RecoLocalCalo_EcalRecAlgos_PulseChiSqSNNLSSolve_h
+#define RecoLocalCalo_EcalRecAlgos_PulseChiSqSNNLSSolve_h
+
+// Shared by PulseChiSqSNNLS and PulseChiSqSNNLSBatch, not part of the interface of the package.
+
+#include "RecoLocalCalo/EcalRecAlgos/interface/EigenMatrixTypes.h"
+
+namespace pulsechisqsnnls::detail {
+  // solves the top-left NP x NP block of mat with fixed-size matrices
+  void eigen_solve_submatrix(PulseMatrix &mat, PulseVector &invec, PulseVector &outvec, unsigned NP);
+}  // namespace pulsechisqsnnls::detail
+
+#endif
@@ -0,0 +1,108 @@
+/* Unit test for PulseChiSqSNNLSBatch: the batched fit must give the
+   amplitudes and chi2 of PulseChiSqSNNLS
+ */
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "RecoLocalCalo/EcalRecAlgos/interface/PulseChiSqSNNLS.h"
+#include "RecoLocalCalo/EcalRecAlgos/interface/PulseChiSqSNNLSBatch.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+class testPulseChiSqSNNLSBatch : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(testPulseChiSqSNNLSBatch);
+  CPPUNIT_TEST(testTenBX);
+  CPPUNIT_TEST(testThreeBX);
+  CPPUNIT_TEST(testOneBX);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void testTenBX() { compare({-5, -4, -3, -2, -1, 0, 1, 2, 3, 4}); }
+  void testThreeBX() { compare({-1, 0, 1}); }
+  void testOneBX() { compare({0}); }
+
+private:
+  void compare(const std::vector<int>& activeBXs);
+};
+
+///registration of the test so that the runner can find it
+CPPUNIT_TEST_SUITE_REGISTRATION(testPulseChiSqSNNLSBatch);
+
+void testPulseChiSqSNNLSBatch::compare(const std::vector<int>& activeBXs) {
+  const double pdf[12] = {1.13979e-02,
+                          7.58151e-01,
+                          1.00000e+00,
+                          8.87744e-01,
+                          6.73548e-01,
+                          4.74332e-01,
+                          3.19561e-01,
+                          2.15144e-01,
+                          1.47464e-01,
+                          1.01087e-01,
+                          6.93181e-02,
+                          4.75044e-02};
+
+  BXVector bxs(activeBXs.size());
+  for (unsigned int ibx = 0; ibx < activeBXs.size(); ++ibx)
+    bxs.coeffRef(ibx) = activeBXs[ibx];
+  const unsigned int nbx = bxs.rows();
+
+  // an odd number of channels, so that some are not fitted with the vectorized code
+  const unsigned int nchannels = 203;
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> flat(0., 1.);
+  std::normal_distribution<double> gauss(0., 1.);
+
+  SampleMatrix noisecov;
+  const double rms = 1.1, rho = 0.7;
+  for (unsigned int i = 0; i < SampleVectorSize; ++i)
+    for (unsigned int j = 0; j < SampleVectorSize; ++j)
+      noisecov(i, j) = rms * rms * std::pow(rho, std::abs(int(i) - int(j)));
+
+  PulseChiSqSNNLSBatch batch;
+  batch.reset(bxs);
+  std::vector<double> amplitudes(nchannels * nbx), chisq(nchannels);
+  for (unsigned int ich = 0; ich < nchannels; ++ich) {
+    FullSampleVector fullpulse = FullSampleVector::Zero();
+    FullSampleMatrix fullpulsecov = FullSampleMatrix::Zero();
+    for (unsigned int i = 0; i < 12; ++i)
+      fullpulse(i + 7) = pdf[i] * (1. + 0.02 * gauss(gen));
+    for (unsigned int i = 0; i < 12; ++i)
+      for (unsigned int j = 0; j < 12; ++j)
+        fullpulsecov(i + 7, j + 7) = 1e-5 * pdf[i] * pdf[j] * (i == j ? 2. : 1.);
+
+    // in-time signal over a wide range, out-of-time pileup in some of the channels
+    const double amplitude = 5000. * std::pow(flat(gen), 3);
+    const double pileup = flat(gen) < 0.3 ? 30. * flat(gen) : 0.;
+    const int bxpileup = int(flat(gen) * 10) - 5;
+    SampleVector samples;
+    for (unsigned int i = 0; i < SampleVectorSize; ++i)
+      samples(i) = amplitude * fullpulse(i + 4) + pileup * fullpulse(i + 4 - bxpileup) + rms * gauss(gen);
+
+    PulseChiSqSNNLS pulsefunc;
+    pulsefunc.disableErrorCalculation();
+    CPPUNIT_ASSERT(pulsefunc.DoFit(samples, noisecov, bxs, fullpulse, fullpulsecov));
+    // PulseChiSqSNNLS reorders the pulses
+    for (unsigned int ipulse = 0; ipulse < nbx; ++ipulse) {
+      unsigned int ibx = 0;
+      while (bxs.coeff(ibx) != pulsefunc.BXs().coeff(ipulse))
+        ++ibx;
+      amplitudes[ich * nbx + ibx] = pulsefunc.X().coeff(ipulse);
+    }
+    chisq[ich] = pulsefunc.ChiSq();
+
+    batch.push_back(samples, noisecov, fullpulse, fullpulsecov);
+  }
+  batch.fit();
+
+  CPPUNIT_ASSERT_EQUAL(nchannels, batch.size());
+  for (unsigned int ich = 0; ich < nchannels; ++ich) {
+    CPPUNIT_ASSERT(batch.Status(ich));
+    for (unsigned int ibx = 0; ibx < nbx; ++ibx) {
+      const double expected = amplitudes[ich * nbx + ibx];
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(expected, batch.X(ich, ibx), 1e-9 * (1. + std::abs(expected)));
+    }
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(chisq[ich], batch.ChiSq(ich), 1e-9 * (1. + chisq[ich]));
+  }
+}
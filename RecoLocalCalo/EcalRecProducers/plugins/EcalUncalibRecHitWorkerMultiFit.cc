@@ -22,6 +22,18 @@
 #include <FWCore/ParameterSet/interface/ParameterSetDescription.h>
 #include <FWCore/ParameterSet/interface/EmptyGroupDescription.h>
 
+namespace {
+  // conditions of a channel, and the last sample before saturation (-2 if it is not saturated)
+  struct ChannelInputs {
+    const EcalPedestals::Item* aped = nullptr;
+    const EcalMGPAGainRatio* aGain = nullptr;
+    const EcalXtalGroupId* gid = nullptr;
+    const EcalPulseShapes::Item* aPulse = nullptr;
+    const EcalPulseCovariances::Item* aPulseCov = nullptr;
+    int lastSampleBeforeSaturation = -2;
+  };
+}  // namespace
+
 EcalUncalibRecHitWorkerMultiFit::EcalUncalibRecHitWorkerMultiFit(const edm::ParameterSet& ps, edm::ConsumesCollector& c)
     : EcalUncalibRecHitWorkerBaseClass(ps, c) {
   // get the BX for the pulses to be activated
@@ -33,6 +45,7 @@ EcalUncalibRecHitWorkerMultiFit::EcalUncalibRecHitWorkerMultiFit(const edm::Para
 
   // uncertainty calculation (CPU intensive)
   ampErrorCalculation_ = ps.getParameter<bool>("ampErrorCalculation");
+  batchedFit_ = ps.getParameter<bool>("batchedFit");
   useLumiInfoRunHeader_ = ps.getParameter<bool>("useLumiInfoRunHeader");
 
   if (useLumiInfoRunHeader_) {
@@ -264,50 +277,85 @@ void EcalUncalibRecHitWorkerMultiFit::run(const edm::Event& evt,
   FullSampleVector fullpulse(FullSampleVector::Zero());
   FullSampleMatrix fullpulsecov(FullSampleMatrix::Zero());
 
+  // conditions of each channel, looked up once for the batched fit and the loop making the rechits
+  std::vector<ChannelInputs> inputs(digis.size());
+  unsigned int idg = 0;
+  for (auto itdg = digis.begin(); itdg != digis.end(); ++itdg, ++idg) {
+    auto& in = inputs[idg];
+    if (barrel) {
+      unsigned int hashedIndex = EBDetId(itdg->id()).hashedIndex();
+      in.aped = &peds->barrel(hashedIndex);
+      in.aGain = &gains->barrel(hashedIndex);
+      in.gid = &grps->barrel(hashedIndex);
+      in.aPulse = &pulseshapes->barrel(hashedIndex);
+      in.aPulseCov = &pulsecovariances->barrel(hashedIndex);
+    } else {
+      unsigned int hashedIndex = EEDetId(itdg->id()).hashedIndex();
+      in.aped = &peds->endcap(hashedIndex);
+      in.aGain = &gains->endcap(hashedIndex);
+      in.gid = &grps->endcap(hashedIndex);
+      in.aPulse = &pulseshapes->endcap(hashedIndex);
+      in.aPulseCov = &pulsecovariances->endcap(hashedIndex);
+    }
+
+    for (unsigned int iSample = 0; iSample < EcalDataFrame::MAXSAMPLES; iSample++) {
+      if (((EcalDataFrame)(*itdg)).sample(iSample).gainId() == 0) {
+        in.lastSampleBeforeSaturation = iSample - 1;
+        break;
+      }
+    }
+  }
+
+  auto fillPulse = [&fullpulse](const ChannelInputs& in) {
+    for (int i = 0; i < EcalPulseShape::TEMPLATESAMPLES; ++i)
+      fullpulse(i + 7) = in.aPulse->pdfval[i];
+  };
+  auto fillPulseCov = [&fullpulsecov](const ChannelInputs& in) {
+    for (int i = 0; i < EcalPulseShape::TEMPLATESAMPLES; i++)
+      for (int j = 0; j < EcalPulseShape::TEMPLATESAMPLES; j++)
+        fullpulsecov(i + 7, j + 7) = in.aPulseCov->covval[i][j];
+  };
+
+  // batched multifit: fit together all the channels that allow it, their rechits are made in the loop below
+  std::vector<int> batchIndex;
+  if (batchedFit_) {
+    multiFitMethod_.clearBatch(activeBX);
+    batchIndex.resize(digis.size(), -1);
+    int nBatch = 0;
+    idg = 0;
+    for (auto itdg = digis.begin(); itdg != digis.end(); ++itdg, ++idg) {
+      const auto& in = inputs[idg];
+      if (in.lastSampleBeforeSaturation != -2)  // saturated
+        continue;
+
+      fillPulse(in);
+      fillPulseCov(in);
+      if (multiFitMethod_.addToBatch(*itdg, in.aped, in.aGain, noisecor(barrel), fullpulse, fullpulsecov))
+        batchIndex[idg] = nBatch++;
+    }
+    multiFitMethod_.fitBatch();
+  }
+
   result.reserve(result.size() + digis.size());
-  for (auto itdg = digis.begin(); itdg != digis.end(); ++itdg) {
+  idg = 0;
+  for (auto itdg = digis.begin(); itdg != digis.end(); ++itdg, ++idg) {
     DetId detid(itdg->id());
 
     const EcalSampleMask* sampleMask_ = sampleMaskHand_.product();
 
     // intelligence for recHit computation
-    float offsetTime = 0;
-
-    const EcalPedestals::Item* aped = nullptr;
-    const EcalMGPAGainRatio* aGain = nullptr;
-    const EcalXtalGroupId* gid = nullptr;
-    const EcalPulseShapes::Item* aPulse = nullptr;
-    const EcalPulseCovariances::Item* aPulseCov = nullptr;
-
-    if (barrel) {
-      unsigned int hashedIndex = EBDetId(detid).hashedIndex();
-      aped = &peds->barrel(hashedIndex);
-      aGain = &gains->barrel(hashedIndex);
-      gid = &grps->barrel(hashedIndex);
-      aPulse = &pulseshapes->barrel(hashedIndex);
-      aPulseCov = &pulsecovariances->barrel(hashedIndex);
-      offsetTime = offtime->getEBValue();
-    } else {
-      unsigned int hashedIndex = EEDetId(detid).hashedIndex();
-      aped = &peds->endcap(hashedIndex);
-      aGain = &gains->endcap(hashedIndex);
-      gid = &grps->endcap(hashedIndex);
-      aPulse = &pulseshapes->endcap(hashedIndex);
-      aPulseCov = &pulsecovariances->endcap(hashedIndex);
-      offsetTime = offtime->getEEValue();
-    }
+    const auto& in = inputs[idg];
+    const EcalPedestals::Item* aped = in.aped;
+    const EcalMGPAGainRatio* aGain = in.aGain;
+    const EcalXtalGroupId* gid = in.gid;
+    const int lastSampleBeforeSaturation = in.lastSampleBeforeSaturation;
+    const bool batched = batchedFit_ && batchIndex[idg] >= 0;
+    float offsetTime = barrel ? offtime->getEBValue() : offtime->getEEValue();
 
     double pedVec[3] = {aped->mean_x12, aped->mean_x6, aped->mean_x1};
     double pedRMSVec[3] = {aped->rms_x12, aped->rms_x6, aped->rms_x1};
     double gainRatios[3] = {1., aGain->gain12Over6(), aGain->gain6Over1() * aGain->gain12Over6()};
 
-    for (int i = 0; i < EcalPulseShape::TEMPLATESAMPLES; ++i)
-      fullpulse(i + 7) = aPulse->pdfval[i];
-
-    for (int i = 0; i < EcalPulseShape::TEMPLATESAMPLES; i++)
-      for (int j = 0; j < EcalPulseShape::TEMPLATESAMPLES; j++)
-        fullpulsecov(i + 7, j + 7) = aPulseCov->covval[i][j];
-
     // compute the right bin of the pulse shape using time calibration constants
     EcalTimeCalibConstantMap::const_iterator it = itime->find(detid);
     EcalTimeCalibConstant itimeconst = 0;
@@ -318,14 +366,6 @@ void EcalUncalibRecHitWorkerMultiFit::run(const edm::Event& evt,
                                        << "! something wrong with EcalTimeCalibConstants in your DB? ";
     }
 
-    int lastSampleBeforeSaturation = -2;
-    for (unsigned int iSample = 0; iSample < EcalDataFrame::MAXSAMPLES; iSample++) {
-      if (((EcalDataFrame)(*itdg)).sample(iSample).gainId() == 0) {
-        lastSampleBeforeSaturation = iSample - 1;
-        break;
-      }
-    }
-
     // === amplitude computation ===
 
     if (lastSampleBeforeSaturation == 4) {  // saturation on the expected max sample
@@ -351,7 +391,14 @@ void EcalUncalibRecHitWorkerMultiFit::run(const edm::Event& evt,
       // multifit
       const SampleMatrixGainArray& noisecors = noisecor(barrel);
 
-      result.push_back(multiFitMethod_.makeRecHit(*itdg, aped, aGain, noisecors, fullpulse, fullpulsecov, activeBX));
+      if (batched) {
+        result.push_back(multiFitMethod_.makeBatchRecHit(batchIndex[idg]));
+      } else {
+        fillPulse(in);
+        fillPulseCov(in);
+        result.push_back(
+            multiFitMethod_.makeRecHit(*itdg, aped, aGain, noisecors, fullpulse, fullpulsecov, activeBX));
+      }
       auto& uncalibRecHit = result.back();
 
       // === time computation ===
@@ -442,6 +489,8 @@ void EcalUncalibRecHitWorkerMultiFit::run(const edm::Event& evt,
         }
       } else if (timealgo_ == weightsMethod) {
         //  weights method on the PU subtracted pulse shape
+        if (batched)  // fullpulse was not filled for this channel
+          fillPulse(in);
         std::vector<double> amplitudes;
         for (unsigned int ibx = 0; ibx < activeBX.size(); ++ibx)
           amplitudes.push_back(uncalibRecHit.outOfTimeAmplitude(ibx));
@@ -595,6 +644,7 @@ edm::ParameterSetDescription EcalUncalibRecHitWorkerMultiFit::getAlgoDescription
   psd.addNode(
       edm::ParameterDescription<std::vector<int>>("activeBXs", {-5, -4, -3, -2, -1, 0, 1, 2, 3, 4}, true) and
       edm::ParameterDescription<bool>("ampErrorCalculation", true, true) and
+      edm::ParameterDescription<bool>("batchedFit", false, true) and
       edm::ParameterDescription<bool>("useLumiInfoRunHeader", true, true) and
       edm::ParameterDescription<int>("bunchSpacing", 0, true) and
       edm::ParameterDescription<bool>("doPrefitEB", false, true) and
@@ -66,6 +66,7 @@ private:
   std::array<SampleMatrixGainArray, 2> noisecors_;
   BXVector activeBX;
   bool ampErrorCalculation_;
+  bool batchedFit_;
   bool useLumiInfoRunHeader_;
   EcalUncalibRecHitMultiFitAlgo multiFitMethod_;
 
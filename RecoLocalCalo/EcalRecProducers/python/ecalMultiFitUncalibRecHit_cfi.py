@@ -13,6 +13,9 @@ ecalMultiFitUncalibRecHit = cms.EDProducer("EcalUncalibRecHitProducer",
       EcalPulseShapeParameters = cms.PSet( ecal_pulse_shape_parameters ),
       activeBXs = cms.vint32(-5,-4,-3,-2,-1,0,1,2,3,4),
       ampErrorCalculation = cms.bool(True),
+      # fit all channels of the event together, only for the channels which do not
+      # need the prefit, the amplitude uncertainty or the special gain switch treatments
+      batchedFit = cms.bool(False),
       useLumiInfoRunHeader = cms.bool(True),
   
       doPrefitEB = cms.bool(False),
@@ -20,6 +20,7 @@
 #include "RecoLocalCalo/HGCalRecAlgos/interface/RecHitTools.h"
 
 // C/C++ headers
+#include <cstdint>
 #include <set>
 #include <string>
 #include <vector>
@@ -140,6 +141,9 @@ private:
 
   float outlierDeltaFactor_ = 2.f;
 
+  // layers with fewer cells are not split into tasks
+  unsigned int minCellsForParallelLayer_ = 1000;
+
   struct CellsOnLayer {
     std::vector<DetId> detid;
     std::vector<bool> isSi;
@@ -155,8 +159,9 @@ private:
     std::vector<int> nearestHigher;
     std::vector<int> clusterIndex;
     std::vector<float> sigmaNoise;
-    std::vector<std::vector<int>> followers;
-    std::vector<bool> isSeed;
+    // not std::vector<bool>, as they are filled concurrently
+    std::vector<uint8_t> isSeed;
+    std::vector<uint8_t> isOutlier;
 
     void clear() {
       detid.clear();
@@ -171,8 +176,8 @@ private:
       nearestHigher.clear();
       clusterIndex.clear();
       sigmaNoise.clear();
-      followers.clear();
       isSeed.clear();
+      isOutlier.clear();
     }
   };
 
@@ -196,13 +201,16 @@ private:
     return std::sqrt(distance2(cell1, cell2, layerId, isEtaPhi));
   }
 
+  // calls f for each cell of the layer, in parallel over the rows of tiles for large layers
+  template <typename F>
+  void forEachCell(const HGCalLayerTiles& lt, unsigned int numberOfCells, F&& f) const;
   void prepareDataStructures(const unsigned int layerId);
   void calculateLocalDensity(const HGCalLayerTiles& lt,
                              const unsigned int layerId,
                              float delta_c,
                              float delta_r);  // return max density
   void calculateDistanceToHigher(const HGCalLayerTiles& lt, const unsigned int layerId, float delta_c, float delta_r);
-  int findAndAssignClusters(const unsigned int layerId, float delta_c, float delta_r);
+  int findAndAssignClusters(const HGCalLayerTiles& lt, const unsigned int layerId, float delta_c, float delta_r);
   math::XYZPoint calculatePosition(const std::vector<int>& v, const unsigned int layerId) const;
   void setDensity(const unsigned int layerId);
 };
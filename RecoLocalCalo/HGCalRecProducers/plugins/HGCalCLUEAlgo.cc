@@ -69,14 +69,32 @@ void HGCalCLUEAlgo::populate(const HGCRecHitCollection& hits) {
   }
 }
 
+template <typename F>
+void HGCalCLUEAlgo::forEachCell(const HGCalLayerTiles& lt, unsigned int numberOfCells, F&& f) const {
+  if (numberOfCells < minCellsForParallelLayer_) {
+    for (unsigned int i = 0; i < numberOfCells; i++)
+      f(i);
+    return;
+  }
+  // each cell is in exactly one of the x-y tiles, whether it is silicon or scintillator
+  tbb::parallel_for(tbb::blocked_range<int>(0, hgcaltilesconstants::nRows), [&](const tbb::blocked_range<int>& rows) {
+    for (int yBin = rows.begin(); yBin < rows.end(); ++yBin) {
+      for (int xBin = 0; xBin < hgcaltilesconstants::nColumns; ++xBin) {
+        for (int i : lt[lt.getGlobalBinByBin(xBin, yBin)])
+          f(i);
+      }
+    }
+  });
+}
+
 void HGCalCLUEAlgo::prepareDataStructures(unsigned int l) {
   auto cellsSize = cells_[l].detid.size();
   cells_[l].rho.resize(cellsSize, 0.f);
   cells_[l].delta.resize(cellsSize, 9999999);
   cells_[l].nearestHigher.resize(cellsSize, -1);
   cells_[l].clusterIndex.resize(cellsSize, -1);
-  cells_[l].followers.resize(cellsSize);
-  cells_[l].isSeed.resize(cellsSize, false);
+  cells_[l].isSeed.resize(cellsSize, 0);
+  cells_[l].isOutlier.resize(cellsSize, 0);
   if (rhtools_.isOnlySilicon(l)) {
     cells_[l].isSi.resize(cellsSize, true);
     cells_[l].eta.resize(cellsSize, 0.f);
@@ -110,7 +128,7 @@ void HGCalCLUEAlgo::makeClusters() {
 
       calculateLocalDensity(lt, i, delta_c, delta_r);
       calculateDistanceToHigher(lt, i, delta_c, delta_r);
-      numberOfClustersPerLayer_[i] = findAndAssignClusters(i, delta_c, delta_r);
+      numberOfClustersPerLayer_[i] = findAndAssignClusters(lt, i, delta_c, delta_r);
     });
   });
   //Now that we have the density per point we can store it
@@ -240,7 +258,7 @@ void HGCalCLUEAlgo::calculateLocalDensity(const HGCalLayerTiles& lt,
   if (rhtools_.isOnlySilicon(layerId))
     isOnlySi = true;
 
-  for (unsigned int i = 0; i < numberOfCells; i++) {
+  forEachCell(lt, numberOfCells, [&](unsigned int i) {
     bool isSi = isOnlySi || cellsOnLayer.isSi[i];
     if (isSi) {
       float delta = delta_c;
@@ -328,7 +346,7 @@ void HGCalCLUEAlgo::calculateLocalDensity(const HGCalLayerTiles& lt,
                               << "  cell: " << i << " isSilicon: " << cellsOnLayer.isSi[i]
                               << " eta: " << cellsOnLayer.eta[i] << " phi: " << cellsOnLayer.phi[i]
                               << " energy: " << cellsOnLayer.weight[i] << " density: " << cellsOnLayer.rho[i] << "\n";
-  }
+  });
 }
 
 void HGCalCLUEAlgo::calculateDistanceToHigher(const HGCalLayerTiles& lt,
@@ -341,7 +359,7 @@ void HGCalCLUEAlgo::calculateDistanceToHigher(const HGCalLayerTiles& lt,
   if (rhtools_.isOnlySilicon(layerId))
     isOnlySi = true;
 
-  for (unsigned int i = 0; i < numberOfCells; i++) {
+  forEachCell(lt, numberOfCells, [&](unsigned int i) {
     bool isSi = isOnlySi || cellsOnLayer.isSi[i];
     // initialize delta and nearest higher for i
     float maxDelta = std::numeric_limits<float>::max();
@@ -446,10 +464,13 @@ void HGCalCLUEAlgo::calculateDistanceToHigher(const HGCalLayerTiles& lt,
                               << " energy: " << cellsOnLayer.weight[i] << " density: " << cellsOnLayer.rho[i]
                               << " nearest higher: " << cellsOnLayer.nearestHigher[i]
                               << " distance: " << cellsOnLayer.delta[i] << "\n";
-  }
+  });
 }
 
-int HGCalCLUEAlgo::findAndAssignClusters(const unsigned int layerId, float delta_c, float delta_r) {
+int HGCalCLUEAlgo::findAndAssignClusters(const HGCalLayerTiles& lt,
+                                         const unsigned int layerId,
+                                         float delta_c,
+                                         float delta_r) {
   // this is called once per layer and endcap...
   // so when filling the cluster temporary vector of Hexels we resize each time
   // by the number  of clusters found. This is always equal to the number of
@@ -457,42 +478,37 @@ int HGCalCLUEAlgo::findAndAssignClusters(const unsigned int layerId, float delta
   unsigned int nClustersOnLayer = 0;
   auto& cellsOnLayer = cells_[layerId];
   unsigned int numberOfCells = cellsOnLayer.detid.size();
-  std::vector<int> localStack;
+  bool isOnlySi = rhtools_.isOnlySilicon(layerId);
   // find cluster seeds and outlier
-  for (unsigned int i = 0; i < numberOfCells; i++) {
+  forEachCell(lt, numberOfCells, [&](unsigned int i) {
     float rho_c = kappa_ * cellsOnLayer.sigmaNoise[i];
-    bool isSi = rhtools_.isOnlySilicon(layerId) || cellsOnLayer.isSi[i];
+    bool isSi = isOnlySi || cellsOnLayer.isSi[i];
     float delta = isSi ? delta_c : delta_r;
 
     // initialize clusterIndex
     cellsOnLayer.clusterIndex[i] = -1;
-    bool isSeed = (cellsOnLayer.delta[i] > delta) && (cellsOnLayer.rho[i] >= rho_c);
-    bool isOutlier = (cellsOnLayer.delta[i] > outlierDeltaFactor_ * delta) && (cellsOnLayer.rho[i] < rho_c);
-    if (isSeed) {
+    cellsOnLayer.isSeed[i] = (cellsOnLayer.delta[i] > delta) && (cellsOnLayer.rho[i] >= rho_c);
+    cellsOnLayer.isOutlier[i] = (cellsOnLayer.delta[i] > outlierDeltaFactor_ * delta) && (cellsOnLayer.rho[i] < rho_c);
+  });
+
+  // number the seeds in the order of the cells, whatever the order in which they were found
+  for (unsigned int i = 0; i < numberOfCells; i++) {
+    if (cellsOnLayer.isSeed[i]) {
       cellsOnLayer.clusterIndex[i] = nClustersOnLayer;
-      cellsOnLayer.isSeed[i] = true;
       nClustersOnLayer++;
-      localStack.push_back(i);
-
-    } else if (!isOutlier) {
-      cellsOnLayer.followers[cellsOnLayer.nearestHigher[i]].push_back(i);
     }
   }
 
-  // need to pass clusterIndex to their followers
-  while (!localStack.empty()) {
-    int endStack = localStack.back();
-    auto& thisSeed = cellsOnLayer.followers[endStack];
-    localStack.pop_back();
-
-    // loop over followers
-    for (int j : thisSeed) {
-      // pass id to a follower
-      cellsOnLayer.clusterIndex[j] = cellsOnLayer.clusterIndex[endStack];
-      // push this follower to localStack
-      localStack.push_back(j);
-    }
-  }
+  // pass clusterIndex to the followers: each of them belongs to the cluster of the
+  // seed found by following the nearest highers, none if there is an outlier on the way
+  forEachCell(lt, numberOfCells, [&](unsigned int i) {
+    if (cellsOnLayer.isSeed[i] || cellsOnLayer.isOutlier[i])
+      return;
+    int higher = cellsOnLayer.nearestHigher[i];
+    while (!cellsOnLayer.isSeed[higher] && !cellsOnLayer.isOutlier[higher])
+      higher = cellsOnLayer.nearestHigher[higher];
+    cellsOnLayer.clusterIndex[i] = cellsOnLayer.isSeed[higher] ? cellsOnLayer.clusterIndex[higher] : -1;
+  });
   return nClustersOnLayer;
 }
 
@@ -6,6 +6,7 @@
 #include "CalibFormats/HcalObjects/interface/HcalCalibrations.h"
 #include "CalibFormats/HcalObjects/interface/HcalCoder.h"
 #include "RecoLocalCalo/HcalRecAlgos/interface/EigenMatrixTypes.h"
+#include "RecoLocalCalo/HcalRecAlgos/interface/MahiNnlsBatch.h"
 #include "DataFormats/HcalRecHit/interface/HBHEChannelInfo.h"
 
 #include "CalibCalorimetry/HcalAlgos/interface/HcalPulseShapes.h"
@@ -118,6 +119,19 @@ public:
 
   void phase1Debug(const HBHEChannelInfo& channelData, MahiDebugInfo& mdi) const;
 
+  // Batched version of phase1Apply: the channels are added one at a time, after
+  // setPulseShapeTemplate as for phase1Apply, and the fits with the configured
+  // BXs of all the channels are done together by fitBatch(). The channels which
+  // do not have the number of samples and the BXs of the first one are fitted
+  // when they are added.
+  void clearBatch();
+  // returns the index of the channel in the batch
+  unsigned int addToBatch(const HBHEChannelInfo& channelData);
+  void fitBatch();
+  // only after fitBatch(), same results as phase1Apply
+  void batchResult(
+      unsigned int i, float& reconstructedEnergy, float& reconstructedTime, bool& useTriple, float& chi2) const;
+
   void doFit(std::array<float, 3>& correctedOutput, const int nbx) const;
 
   void setPulseShapeTemplate(const HcalPulseShapes::Shape& ps,
@@ -130,7 +144,11 @@ public:
   const HcalPulseShapes::Shape* currentPulseShape_ = nullptr;
   const HcalTimeSlew* hcalTimeSlewDelay_ = nullptr;
 
+  static void solveSubmatrix(PulseMatrix& mat, PulseVector& invec, PulseVector& outvec, unsigned nP);
+
 private:
+  bool prepareFit(const HBHEChannelInfo& channelData) const;
+  void setupPulses(const int nbx) const;
   double minimize() const;
   void onePulseMinimize() const;
   void updateCov() const;
@@ -140,6 +158,11 @@ private:
                         FullSampleMatrix& pulseCov) const;
 
   float calculateArrivalTime() const;
+  static float calculateArrivalTime(const SamplePulseMatrix& pulseMat,
+                                    SamplePulseMatrix& pulseDerivMat,
+                                    const PulseVector& ampVec,
+                                    const SampleVector& amplitudes,
+                                    unsigned int itIndex);
   double calculateChiSq() const;
   void nnls() const;
   void resetWorkspace() const;
@@ -147,10 +170,22 @@ private:
   void nnlsUnconstrainParameter(Index idxp) const;
   void nnlsConstrainParameter(Index minratioidx) const;
 
-  void solveSubmatrix(PulseMatrix& mat, PulseVector& invec, PulseVector& outvec, unsigned nP) const;
-
   mutable MahiNnlsWorkspace nnlsWork_;
 
+  // for the batched fit
+  struct BatchChannel {
+    std::array<float, 3> reconstructedVals;
+    bool useTriple;
+    float gain;
+    int index;  // in batch_, -1 if the channel was fitted when added
+    // for the arrival time
+    SampleVector amplitudes;
+    SamplePulseMatrix pulseMat;
+    SamplePulseMatrix pulseDerivMat;
+  };
+  MahiNnlsBatch batch_;
+  std::vector<BatchChannel> batchChannels_;
+
   //hard coded in initializer
   static constexpr int pedestalBX_ = 100;
 
@@ -0,0 +1,108 @@
+#ifndef RecoLocalCalo_HcalRecAlgos_MahiNnlsBatch_h
+#define RecoLocalCalo_HcalRecAlgos_MahiNnlsBatch_h
+
+/** \class MahiNnlsBatch
+ *  Minimization of MahiFit for many channels at once.
+ *
+ *  All the channels have the same number of samples and the same bunch
+ *  crossings; their pulse templates and pulse covariances are built by
+ *  MahiFit beforehand. The channels are fitted W at a time: the
+ *  covariance, its Cholesky decomposition, the triangular solves, the
+ *  normal equations and the chi2 are computed for the W channels together
+ *  using compiler vector extensions, on arrays of fixed size. The NNLS
+ *  follows the active-set steps of MahiFit::nnls for each channel, the W
+ *  channels advancing in lockstep: the choices of the parameters to free or
+ *  to constrain are made channel by channel, the gradient and the solves for
+ *  the free parameters are vectorized. The free parameters are solved with
+ *  an LDLT decomposition without pivoting instead of the pivoting LDLT of
+ *  Eigen, so that the results agree with MahiFit up to rounding.
+ */
+
+#include "RecoLocalCalo/HcalRecAlgos/interface/EigenMatrixTypes.h"
+
+#include <array>
+#include <vector>
+
+class MahiNnlsBatch {
+public:
+  typedef BXVector::Index Index;
+
+  // packed lower triangle of a matrix of size n
+  static constexpr unsigned int symSize(unsigned int n) { return n * (n + 1) / 2; }
+  static constexpr unsigned int symIndex(unsigned int i, unsigned int j) {
+    return i >= j ? i * (i + 1) / 2 + j : j * (j + 1) / 2 + i;
+  }
+
+  void setParameters(int nMaxItersMin, int nMaxItersNNLS, double deltaChiSqThresh, double nnlsThresh);
+
+  /// Removes all the channels, sets the number of samples and the bunch crossings of the pulses
+  void reset(unsigned int nSamples, const BXVector& bxs);
+  /// Removes all the channels
+  void clear();
+  void reserve(unsigned int n);
+
+  /// Adds a channel, the columns of pulseMat are in the order of the bunch crossings given to reset()
+  void push_back(const SampleVector& amplitudes,
+                 const SampleVector& noiseTerms,
+                 float pedVal,
+                 const SamplePulseMatrix& pulseMat);
+  /// Sets the covariance of a pulse of the last channel added, zero if not set
+  void setPulseCov(unsigned int ipulse, const SampleMatrix& pulseCov);
+
+  unsigned int size() const { return chiSq_.size(); }
+  unsigned int nSamples() const { return nSamples_; }
+  const BXVector& BXs() const { return bxs_; }
+
+  /// Fits all channels
+  void fit();
+
+  /// Only after fit()
+  double X(unsigned int i, unsigned int ipulse) const { return amplitudes_[ipulse][i]; }
+  double ChiSq(unsigned int i) const { return chiSq_[i]; }
+
+private:
+  // state of the minimization of one channel
+  struct ChannelState {
+    PulseVector ampVec;                          // in the order of bxs_
+    std::array<unsigned char, MaxPVSize> perm;  // pulses ordered as in MahiFit
+    double chiSq;
+    double oldChiSq;
+    bool done;
+  };
+
+  template <int W>
+  void fitChannels(unsigned int first);
+  // aTa is packed, V holds the values of W channels
+  template <int W, typename V>
+  void nnls(const V* aTa, const V* aTb, ChannelState* states) const;
+
+  int nMaxItersMin_ = 500;
+  int nMaxItersNNLS_ = 500;
+  double deltaChiSqThresh_ = 1e-3;
+  double nnlsThresh_ = 1e-11;
+
+  unsigned int nSamples_ = 0;
+  BXVector bxs_;
+
+  // The inputs are stored by blocks of blockSize channels, all the values of a
+  // given kind being contiguous for the channels of a block. The offsets of
+  // each kind depend on the number of samples and pulses, see reset().
+  static constexpr unsigned int blockSize = 8;
+  unsigned int iNoise_ = 0;
+  unsigned int iPedVal_ = 0;
+  unsigned int iPulseMat_ = 0;
+  unsigned int iPulseCov_ = 0;
+  unsigned int nInputs_ = 0;
+  double& input(unsigned int k, unsigned int i) {
+    return inputs_[(i / blockSize * nInputs_ + k) * blockSize + i % blockSize];
+  }
+  const double& input(unsigned int k, unsigned int i) const {
+    return inputs_[(i / blockSize * nInputs_ + k) * blockSize + i % blockSize];
+  }
+  std::vector<double> inputs_;
+
+  std::vector<double> amplitudes_[MaxPVSize];
+  std::vector<double> chiSq_;
+};
+
+#endif
@@ -40,6 +40,8 @@ void MahiFit::setParameters(bool iDynamicPed,
 
   bxOffsetConf_ = -(*std::min_element(activeBXs_.begin(), activeBXs_.end()));
   bxSizeConf_ = activeBXs_.size();
+
+  batch_.setParameters(nMaxItersMin_, nMaxItersNNLS_, deltaChiSqThresh_, nnlsThresh_);
 }
 
 void MahiFit::phase1Apply(const HBHEChannelInfo& channelData,
@@ -49,12 +51,37 @@ void MahiFit::phase1Apply(const HBHEChannelInfo& channelData,
                           float& chi2) const {
   assert(channelData.nSamples() == 8 || channelData.nSamples() == 10);
 
+  std::array<float, 3> reconstructedVals{{0.0f, -9999.f, -9999.f}};
+
+  useTriple = false;
+  if (prepareFit(channelData)) {
+    // only do pre-fit with 1 pulse if chiSq threshold is positive
+    if (chiSqSwitch_ > 0) {
+      doFit(reconstructedVals, 1);
+      if (reconstructedVals[2] > chiSqSwitch_) {
+        doFit(reconstructedVals, 0);  //nbx=0 means use configured BXs
+        useTriple = true;
+      }
+    } else {
+      doFit(reconstructedVals, 0);
+      useTriple = true;
+    }
+  } else {
+    reconstructedVals.at(0) = 0.f;      //energy
+    reconstructedVals.at(1) = -9999.f;  //time
+    reconstructedVals.at(2) = -9999.f;  //chi2
+  }
+
+  reconstructedEnergy = reconstructedVals[0] * channelData.tsGain(0);
+  reconstructedTime = reconstructedVals[1];
+  chi2 = reconstructedVals[2];
+}
+
+bool MahiFit::prepareFit(const HBHEChannelInfo& channelData) const {
   resetWorkspace();
 
   nnlsWork_.tsOffset = channelData.soi();
 
-  std::array<float, 3> reconstructedVals{{0.0f, -9999.f, -9999.f}};
-
   auto norm = (1. / std::sqrt(12));
 
   double tsTOT = 0, tstrig = 0;  // in GeV
@@ -83,37 +110,48 @@ void MahiFit::phase1Apply(const HBHEChannelInfo& channelData,
   tsTOT *= channelData.tsGain(0);
   tstrig *= channelData.tsGain(0);
 
-  useTriple = false;
   if (tstrig >= ts4Thresh_ && tsTOT > 0) {
     //Average pedestal width (for covariance matrix constraint)
     nnlsWork_.pedVal = 0.25f * (channelData.tsPedestalWidth(0) * channelData.tsPedestalWidth(0) +
                                 channelData.tsPedestalWidth(1) * channelData.tsPedestalWidth(1) +
                                 channelData.tsPedestalWidth(2) * channelData.tsPedestalWidth(2) +
                                 channelData.tsPedestalWidth(3) * channelData.tsPedestalWidth(3));
+    return true;
+  }
+  return false;
+}
 
-    // only do pre-fit with 1 pulse if chiSq threshold is positive
-    if (chiSqSwitch_ > 0) {
-      doFit(reconstructedVals, 1);
-      if (reconstructedVals[2] > chiSqSwitch_) {
-        doFit(reconstructedVals, 0);  //nbx=0 means use configured BXs
-        useTriple = true;
-      }
-    } else {
-      doFit(reconstructedVals, 0);
-      useTriple = true;
+void MahiFit::doFit(std::array<float, 3>& correctedOutput, int nbx) const {
+  setupPulses(nbx);
+
+  double chiSq = minimize();
+
+  bool foundintime = false;
+  unsigned int ipulseintime = 0;
+
+  for (unsigned int iBX = 0; iBX < nnlsWork_.nPulseTot; ++iBX) {
+    if (nnlsWork_.bxs.coeff(iBX) == 0) {
+      ipulseintime = iBX;
+      foundintime = true;
     }
-  } else {
-    reconstructedVals.at(0) = 0.f;      //energy
-    reconstructedVals.at(1) = -9999.f;  //time
-    reconstructedVals.at(2) = -9999.f;  //chi2
   }
 
-  reconstructedEnergy = reconstructedVals[0] * channelData.tsGain(0);
-  reconstructedTime = reconstructedVals[1];
-  chi2 = reconstructedVals[2];
+  if (foundintime) {
+    correctedOutput.at(0) = nnlsWork_.ampVec.coeff(ipulseintime);  //charge
+    if (correctedOutput.at(0) != 0) {
+      // fixME store the timeslew
+      float arrivalTime = 0.f;
+      if (calculateArrivalTime_)
+        arrivalTime = calculateArrivalTime();
+      correctedOutput.at(1) = arrivalTime;  //time
+    } else
+      correctedOutput.at(1) = -9999.f;  //time
+
+    correctedOutput.at(2) = chiSq;  //chi2
+  }
 }
 
-void MahiFit::doFit(std::array<float, 3>& correctedOutput, int nbx) const {
+void MahiFit::setupPulses(const int nbx) const {
   unsigned int bxSize = 1;
 
   if (nbx == 1) {
@@ -173,32 +211,6 @@ void MahiFit::doFit(std::array<float, 3>& correctedOutput, int nbx) const {
           nnlsWork_.maxoffset - offset, nnlsWork_.maxoffset - offset, nnlsWork_.tsSize, nnlsWork_.tsSize);
     }
   }
-
-  double chiSq = minimize();
-
-  bool foundintime = false;
-  unsigned int ipulseintime = 0;
-
-  for (unsigned int iBX = 0; iBX < nnlsWork_.nPulseTot; ++iBX) {
-    if (nnlsWork_.bxs.coeff(iBX) == 0) {
-      ipulseintime = iBX;
-      foundintime = true;
-    }
-  }
-
-  if (foundintime) {
-    correctedOutput.at(0) = nnlsWork_.ampVec.coeff(ipulseintime);  //charge
-    if (correctedOutput.at(0) != 0) {
-      // fixME store the timeslew
-      float arrivalTime = 0.f;
-      if (calculateArrivalTime_)
-        arrivalTime = calculateArrivalTime();
-      correctedOutput.at(1) = arrivalTime;  //time
-    } else
-      correctedOutput.at(1) = -9999.f;  //time
-
-    correctedOutput.at(2) = chiSq;  //chi2
-  }
 }
 
 double MahiFit::minimize() const {
@@ -320,11 +332,22 @@ float MahiFit::calculateArrivalTime() const {
   for (unsigned int iBX = 0; iBX < nnlsWork_.nPulseTot; ++iBX) {
     if (nnlsWork_.bxs.coeff(iBX) == 0)
       itIndex = iBX;
-    nnlsWork_.pulseDerivMat.col(iBX) *= nnlsWork_.ampVec.coeff(iBX);
   }
 
-  SampleVector residuals = nnlsWork_.pulseMat * nnlsWork_.ampVec - nnlsWork_.amplitudes;
-  PulseVector solution = nnlsWork_.pulseDerivMat.colPivHouseholderQr().solve(residuals);
+  return calculateArrivalTime(
+      nnlsWork_.pulseMat, nnlsWork_.pulseDerivMat, nnlsWork_.ampVec, nnlsWork_.amplitudes, itIndex);
+}
+
+float MahiFit::calculateArrivalTime(const SamplePulseMatrix& pulseMat,
+                                    SamplePulseMatrix& pulseDerivMat,
+                                    const PulseVector& ampVec,
+                                    const SampleVector& amplitudes,
+                                    unsigned int itIndex) {
+  for (unsigned int iBX = 0; iBX < ampVec.rows(); ++iBX)
+    pulseDerivMat.col(iBX) *= ampVec.coeff(iBX);
+
+  SampleVector residuals = pulseMat * ampVec - amplitudes;
+  PulseVector solution = pulseDerivMat.colPivHouseholderQr().solve(residuals);
   float t = solution.coeff(itIndex);
   t = (t > timeLimit_) ? timeLimit_ : ((t < -timeLimit_) ? -timeLimit_ : t);
 
@@ -495,6 +518,106 @@ void MahiFit::nnlsConstrainParameter(Index minratioidx) const {
   --nnlsWork_.nP;
 }
 
+void MahiFit::clearBatch() {
+  batch_.clear();
+  batchChannels_.clear();
+}
+
+unsigned int MahiFit::addToBatch(const HBHEChannelInfo& channelData) {
+  assert(channelData.nSamples() == 8 || channelData.nSamples() == 10);
+
+  batchChannels_.emplace_back();
+  auto& channel = batchChannels_.back();
+  channel.reconstructedVals = {{0.0f, -9999.f, -9999.f}};
+  channel.useTriple = false;
+  channel.gain = channelData.tsGain(0);
+  channel.index = -1;
+
+  if (prepareFit(channelData)) {
+    // the pre-fit with 1 pulse is not batched, as in phase1Apply it decides if the full fit is needed
+    if (chiSqSwitch_ > 0)
+      doFit(channel.reconstructedVals, 1);
+    if (chiSqSwitch_ <= 0 || channel.reconstructedVals[2] > chiSqSwitch_) {
+      channel.useTriple = true;
+      setupPulses(0);
+      if (batch_.size() == 0)
+        batch_.reset(nnlsWork_.tsSize, nnlsWork_.bxs);
+
+      if (nnlsWork_.tsSize == batch_.nSamples() && nnlsWork_.bxs.rows() == batch_.BXs().rows() &&
+          nnlsWork_.bxs == batch_.BXs()) {
+        channel.index = batch_.size();
+        batch_.push_back(nnlsWork_.amplitudes, nnlsWork_.noiseTerms, nnlsWork_.pedVal, nnlsWork_.pulseMat);
+        // the covariances used by updateCov for each pulse
+        for (unsigned int iBX = 0; iBX < nnlsWork_.nPulseTot; ++iBX) {
+          int offset = nnlsWork_.bxs.coeff(iBX);
+          if (offset != pedestalBX_)
+            batch_.setPulseCov(iBX, nnlsWork_.pulseCovArray.at(offset + nnlsWork_.bxOffset));
+        }
+        if (calculateArrivalTime_) {
+          channel.amplitudes = nnlsWork_.amplitudes;
+          channel.pulseMat = nnlsWork_.pulseMat;
+          channel.pulseDerivMat = nnlsWork_.pulseDerivMat;
+        }
+      } else {
+        doFit(channel.reconstructedVals, 0);
+      }
+    }
+  }
+
+  return batchChannels_.size() - 1;
+}
+
+void MahiFit::fitBatch() {
+  if (batch_.size() == 0)
+    return;
+
+  batch_.fit();
+
+  const BXVector& bxs = batch_.BXs();
+  const unsigned int npulse = bxs.rows();
+  bool foundintime = false;
+  unsigned int ipulseintime = 0;
+  for (unsigned int iBX = 0; iBX < npulse; ++iBX) {
+    if (bxs.coeff(iBX) == 0) {
+      ipulseintime = iBX;
+      foundintime = true;
+    }
+  }
+  if (!foundintime)
+    return;
+
+  // as in doFit
+  PulseVector ampVec(npulse);
+  for (auto& channel : batchChannels_) {
+    if (channel.index < 0)
+      continue;
+    auto& correctedOutput = channel.reconstructedVals;
+    correctedOutput[0] = batch_.X(channel.index, ipulseintime);  //charge
+    if (correctedOutput[0] != 0) {
+      float arrivalTime = 0.f;
+      if (calculateArrivalTime_) {
+        for (unsigned int iBX = 0; iBX < npulse; ++iBX)
+          ampVec.coeffRef(iBX) = batch_.X(channel.index, iBX);
+        arrivalTime =
+            calculateArrivalTime(channel.pulseMat, channel.pulseDerivMat, ampVec, channel.amplitudes, ipulseintime);
+      }
+      correctedOutput[1] = arrivalTime;  //time
+    } else
+      correctedOutput[1] = -9999.f;  //time
+
+    correctedOutput[2] = batch_.ChiSq(channel.index);  //chi2
+  }
+}
+
+void MahiFit::batchResult(
+    unsigned int i, float& reconstructedEnergy, float& reconstructedTime, bool& useTriple, float& chi2) const {
+  const auto& channel = batchChannels_[i];
+  reconstructedEnergy = channel.reconstructedVals[0] * channel.gain;
+  reconstructedTime = channel.reconstructedVals[1];
+  useTriple = channel.useTriple;
+  chi2 = channel.reconstructedVals[2];
+}
+
 void MahiFit::phase1Debug(const HBHEChannelInfo& channelData, MahiDebugInfo& mdi) const {
   float recoEnergy, recoTime, chi2;
   bool use3;
@@ -561,7 +684,7 @@ void MahiFit::phase1Debug(const HBHEChannelInfo& channelData, MahiDebugInfo& mdi
   }
 }
 
-void MahiFit::solveSubmatrix(PulseMatrix& mat, PulseVector& invec, PulseVector& outvec, unsigned nP) const {
+void MahiFit::solveSubmatrix(PulseMatrix& mat, PulseVector& invec, PulseVector& outvec, unsigned nP) {
   using namespace Eigen;
   switch (nP) {  // pulse matrix is always square.
     case 10: {
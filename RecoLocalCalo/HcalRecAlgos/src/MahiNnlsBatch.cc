@@ -0,0 +1,520 @@
+#include "RecoLocalCalo/HcalRecAlgos/interface/MahiNnlsBatch.h"
+#include "RecoLocalCalo/HcalRecAlgos/interface/MahiFit.h"
+#include "DataFormats/Math/interface/ExtVec.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+#if defined(__AVX__)
+  constexpr int defaultWidth = 4;
+#else
+  constexpr int defaultWidth = 2;
+#endif
+
+  template <int W>
+  struct Lanes {
+    using type = ExtVec<double, W>;
+  };
+  template <>
+  struct Lanes<1> {
+    using type = double;
+  };
+
+  template <typename V>
+  inline V load(double const* p) {
+    V v;
+    std::memcpy(&v, p, sizeof(V));
+    return v;
+  }
+
+  // one of the channels processed together
+  template <typename V>
+  inline double lane(V const& v, int l) {
+    return v[l];
+  }
+  inline double lane(double v, int) { return v; }
+  template <typename V>
+  inline void setLane(V& v, int l, double x) {
+    v[l] = x;
+  }
+  inline void setLane(double& v, int, double x) { v = x; }
+
+  template <typename V>
+  inline V vsqrt(V v) {
+    for (unsigned int l = 0; l < sizeof(V) / sizeof(double); ++l)
+      v[l] = std::sqrt(v[l]);
+    return v;
+  }
+  inline double vsqrt(double v) { return std::sqrt(v); }
+
+}  // namespace
+
+void MahiNnlsBatch::setParameters(int nMaxItersMin, int nMaxItersNNLS, double deltaChiSqThresh, double nnlsThresh) {
+  nMaxItersMin_ = nMaxItersMin;
+  nMaxItersNNLS_ = nMaxItersNNLS;
+  deltaChiSqThresh_ = deltaChiSqThresh;
+  nnlsThresh_ = nnlsThresh;
+}
+
+void MahiNnlsBatch::reset(unsigned int nSamples, const BXVector& bxs) {
+  if (nSamples == 0 || nSamples > MaxSVSize || bxs.rows() == 0 || bxs.rows() > MaxPVSize)
+    throw cms::Exception("HcalMahiWeirdState")
+        << "Weird number of samples or pulses encountered in Mahi, module is configured incorrectly!";
+  nSamples_ = nSamples;
+  bxs_ = bxs;
+
+  const unsigned int npulse = bxs.rows();
+  iNoise_ = nSamples;
+  iPedVal_ = iNoise_ + nSamples;
+  iPulseMat_ = iPedVal_ + 1;
+  iPulseCov_ = iPulseMat_ + npulse * nSamples;
+  nInputs_ = iPulseCov_ + npulse * symSize(nSamples);
+
+  clear();
+}
+
+void MahiNnlsBatch::clear() {
+  inputs_.clear();
+  for (auto& v : amplitudes_)
+    v.clear();
+  chiSq_.clear();
+}
+
+void MahiNnlsBatch::reserve(unsigned int n) {
+  inputs_.reserve((n + blockSize - 1) / blockSize * nInputs_ * blockSize);
+  for (auto& v : amplitudes_)
+    v.reserve(n);
+  chiSq_.reserve(n);
+}
+
+void MahiNnlsBatch::push_back(const SampleVector& amplitudes,
+                              const SampleVector& noiseTerms,
+                              float pedVal,
+                              const SamplePulseMatrix& pulseMat) {
+  const unsigned int n = size();
+  const unsigned int nsample = nSamples_;
+  const unsigned int npulse = bxs_.rows();
+  if (n % blockSize == 0)
+    inputs_.resize(inputs_.size() + nInputs_ * blockSize);
+  for (unsigned int i = 0; i < nsample; ++i) {
+    input(i, n) = amplitudes.coeff(i);
+    input(iNoise_ + i, n) = noiseTerms.coeff(i);
+  }
+  input(iPedVal_, n) = pedVal;
+  for (unsigned int ipulse = 0; ipulse < npulse; ++ipulse)
+    for (unsigned int i = 0; i < nsample; ++i)
+      input(iPulseMat_ + ipulse * nsample + i, n) = pulseMat.coeff(i, ipulse);
+
+  for (auto& v : amplitudes_)
+    v.push_back(0.);
+  chiSq_.push_back(0.);
+}
+
+void MahiNnlsBatch::setPulseCov(unsigned int ipulse, const SampleMatrix& pulseCov) {
+  const unsigned int n = size() - 1;
+  const unsigned int nsample = nSamples_;
+  const unsigned int k0 = iPulseCov_ + ipulse * symSize(nsample);
+  for (unsigned int i = 0; i < nsample; ++i)
+    for (unsigned int j = 0; j <= i; ++j)
+      input(k0 + symIndex(i, j), n) = pulseCov.coeff(i, j);
+}
+
+void MahiNnlsBatch::fit() {
+  static_assert(blockSize % defaultWidth == 0, "the channels fitted together must be in the same block");
+  const unsigned int n = size();
+  unsigned int first = 0;
+  for (; first + defaultWidth <= n; first += defaultWidth)
+    fitChannels<defaultWidth>(first);
+  for (; first < n; ++first)
+    fitChannels<1>(first);
+}
+
+template <int W>
+void MahiNnlsBatch::fitChannels(unsigned int first) {
+  using V = typename Lanes<W>::type;
+  const unsigned int nsample = nSamples_;
+  const unsigned int npulse = bxs_.rows();
+  const unsigned int pulseCovSize = symSize(nsample);
+
+  V amplitudes[MaxSVSize];
+  V noiseTerms[MaxSVSize];
+  for (unsigned int i = 0; i < nsample; ++i) {
+    amplitudes[i] = load<V>(&input(i, first));
+    noiseTerms[i] = load<V>(&input(iNoise_ + i, first));
+  }
+  const V pedVal = load<V>(&input(iPedVal_, first));
+
+  V pulseMat[MaxSVSize][MaxPVSize];
+  for (unsigned int ipulse = 0; ipulse < npulse; ++ipulse)
+    for (unsigned int i = 0; i < nsample; ++i)
+      pulseMat[i][ipulse] = load<V>(&input(iPulseMat_ + ipulse * nsample + i, first));
+
+  ChannelState states[W];
+  for (int l = 0; l < W; ++l) {
+    auto& state = states[l];
+    state.ampVec = PulseVector::Zero(npulse);
+    for (unsigned int ipulse = 0; ipulse < npulse; ++ipulse)
+      state.perm[ipulse] = ipulse;
+    state.chiSq = 9999;
+    state.oldChiSq = 9999;
+    state.done = false;
+  }
+
+  for (int iter = 1; iter < nMaxItersMin_; ++iter) {
+    //covariance, see MahiFit::updateCov
+    V invCov[symSize(MaxSVSize)];
+    for (unsigned int i = 0; i < nsample; ++i) {
+      for (unsigned int j = 0; j < i; ++j)
+        invCov[symIndex(i, j)] = pedVal;
+      invCov[symIndex(i, i)] = pedVal + noiseTerms[i];
+    }
+    for (unsigned int ipulse = 0; ipulse < npulse; ++ipulse) {
+      V ampsq;
+      bool zero = true;
+      for (int l = 0; l < W; ++l) {
+        const double amp = states[l].ampVec.coeff(ipulse);
+        setLane(ampsq, l, amp * amp);
+        zero &= amp == 0.;
+      }
+      if (zero)
+        continue;
+      const unsigned int k0 = iPulseCov_ + ipulse * pulseCovSize;
+      for (unsigned int k = 0; k < pulseCovSize; ++k)
+        invCov[k] += ampsq * load<V>(&input(k0 + k, first));
+    }
+
+    //Cholesky decomposition, the inverse of the diagonal is kept for the solves
+    V covL[symSize(MaxSVSize)];
+    V covLinvdiag[MaxSVSize];
+    for (unsigned int j = 0; j < nsample; ++j) {
+      V d = invCov[symIndex(j, j)];
+      for (unsigned int k = 0; k < j; ++k)
+        d -= covL[symIndex(j, k)] * covL[symIndex(j, k)];
+      d = vsqrt(d);
+      covL[symIndex(j, j)] = d;
+      covLinvdiag[j] = 1. / d;
+      for (unsigned int i = j + 1; i < nsample; ++i) {
+        V e = invCov[symIndex(i, j)];
+        for (unsigned int k = 0; k < j; ++k)
+          e -= covL[symIndex(i, k)] * covL[symIndex(j, k)];
+        covL[symIndex(i, j)] = e * covLinvdiag[j];
+      }
+    }
+    auto solveL = [&](V* vec) {
+      for (unsigned int i = 0; i < nsample; ++i) {
+        V e = vec[i];
+        for (unsigned int k = 0; k < i; ++k)
+          e -= covL[symIndex(i, k)] * vec[k];
+        vec[i] = e * covLinvdiag[i];
+      }
+    };
+
+    //normal equations, see MahiFit::nnls and MahiFit::onePulseMinimize
+    V invcovp[MaxPVSize][MaxSVSize];
+    for (unsigned int ipulse = 0; ipulse < npulse; ++ipulse) {
+      for (unsigned int i = 0; i < nsample; ++i)
+        invcovp[ipulse][i] = pulseMat[i][ipulse];
+      solveL(invcovp[ipulse]);
+    }
+    V invcovs[MaxSVSize];
+    for (unsigned int i = 0; i < nsample; ++i)
+      invcovs[i] = amplitudes[i];
+    solveL(invcovs);
+
+    V aTa[symSize(MaxPVSize)];
+    V aTb[MaxPVSize];
+    for (unsigned int ipulse = 0; ipulse < npulse; ++ipulse) {
+      for (unsigned int jpulse = 0; jpulse <= ipulse; ++jpulse) {
+        V e = invcovp[ipulse][0] * invcovp[jpulse][0];
+        for (unsigned int i = 1; i < nsample; ++i)
+          e += invcovp[ipulse][i] * invcovp[jpulse][i];
+        aTa[symIndex(ipulse, jpulse)] = e;
+      }
+      V e = invcovp[ipulse][0] * invcovs[0];
+      for (unsigned int i = 1; i < nsample; ++i)
+        e += invcovp[ipulse][i] * invcovs[i];
+      aTb[ipulse] = e;
+    }
+
+    //minimization of the channels not converged yet
+    if (npulse > 1) {
+      nnls<W>(aTa, aTb, states);
+    } else {
+      for (int l = 0; l < W; ++l) {
+        if (!states[l].done)
+          states[l].ampVec.coeffRef(0) = std::max(0., lane(aTb[0], l) / lane(aTa[0], l));
+      }
+    }
+
+    //chi2 with the new amplitudes, but the covariance of the previous ones, see MahiFit::calculateChiSq
+    V ampVec[MaxPVSize];
+    for (unsigned int ipulse = 0; ipulse < npulse; ++ipulse)
+      for (int l = 0; l < W; ++l)
+        setLane(ampVec[ipulse], l, states[l].ampVec.coeff(ipulse));
+    V resvec[MaxSVSize];
+    for (unsigned int i = 0; i < nsample; ++i) {
+      V e = pulseMat[i][0] * ampVec[0];
+      for (unsigned int ipulse = 1; ipulse < npulse; ++ipulse)
+        e += pulseMat[i][ipulse] * ampVec[ipulse];
+      resvec[i] = e - amplitudes[i];
+    }
+    solveL(resvec);
+    V chiSq = resvec[0] * resvec[0];
+    for (unsigned int i = 1; i < nsample; ++i)
+      chiSq += resvec[i] * resvec[i];
+
+    //convergence, see MahiFit::minimize
+    bool done = true;
+    for (int l = 0; l < W; ++l) {
+      auto& state = states[l];
+      if (!state.done) {
+        const double newChiSq = lane(chiSq, l);
+        const double deltaChiSq = newChiSq - state.chiSq;
+        if (newChiSq == state.oldChiSq && newChiSq < state.chiSq) {
+          state.done = true;
+        } else {
+          state.oldChiSq = state.chiSq;
+          state.chiSq = newChiSq;
+          state.done = std::abs(deltaChiSq) < deltaChiSqThresh_;
+        }
+      }
+      done &= state.done;
+    }
+    if (done)
+      break;
+  }
+
+  for (int l = 0; l < W; ++l) {
+    chiSq_[first + l] = states[l].chiSq;
+    for (unsigned int ipulse = 0; ipulse < npulse; ++ipulse)
+      amplitudes_[ipulse][first + l] = states[l].ampVec.coeff(ipulse);
+  }
+}
+
+template <int W, typename V>
+void MahiNnlsBatch::nnls(const V* aTa, const V* aTb, ChannelState* states) const {
+  //Fast NNLS as in MahiFit::nnls, for the W channels in lockstep. The
+  //parameters of each channel are kept in the order of its permutation, the
+  //first nP being free. The decisions of the active-set method are taken
+  //channel by channel, the products and the solves of the free parameters
+  //are done for all the channels together.
+  const unsigned int npulse = bxs_.rows();
+  const unsigned int nmax = std::min(npulse, nSamples_);
+
+  V aTaPerm[MaxPVSize][MaxPVSize];
+  V aTbPerm[MaxPVSize];
+  V ampVecPerm[MaxPVSize];
+  for (int l = 0; l < W; ++l) {
+    const auto& perm = states[l].perm;
+    for (unsigned int i = 0; i < npulse; ++i) {
+      for (unsigned int j = 0; j < npulse; ++j)
+        setLane(aTaPerm[i][j], l, lane(aTa[symIndex(perm[i], perm[j])], l));
+      setLane(aTbPerm[i], l, lane(aTb[perm[i]], l));
+      setLane(ampVecPerm[i], l, states[l].ampVec.coeff(perm[i]));
+    }
+  }
+
+  auto swapParameters = [&](int l, unsigned int i, unsigned int j) {
+    for (unsigned int k = 0; k < npulse; ++k) {
+      const double tmp = lane(aTaPerm[k][i], l);
+      setLane(aTaPerm[k][i], l, lane(aTaPerm[k][j], l));
+      setLane(aTaPerm[k][j], l, tmp);
+    }
+    for (unsigned int k = 0; k < npulse; ++k) {
+      const double tmp = lane(aTaPerm[i][k], l);
+      setLane(aTaPerm[i][k], l, lane(aTaPerm[j][k], l));
+      setLane(aTaPerm[j][k], l, tmp);
+    }
+    double tmp = lane(aTbPerm[i], l);
+    setLane(aTbPerm[i], l, lane(aTbPerm[j], l));
+    setLane(aTbPerm[j], l, tmp);
+    tmp = lane(ampVecPerm[i], l);
+    setLane(ampVecPerm[i], l, lane(ampVecPerm[j], l));
+    setLane(ampVecPerm[j], l, tmp);
+    std::swap(states[l].perm[i], states[l].perm[j]);
+  };
+
+  unsigned int nP[W];
+  int iter[W];
+  Index idxwmax[W];
+  double wmax[W];
+  double threshold[W];
+  bool active[W];    // the minimization of the channel is not finished
+  bool freeStep[W];  // the channel is in the loop over the free parameters
+  for (int l = 0; l < W; ++l) {
+    nP[l] = 0;
+    iter[l] = 0;
+    idxwmax[l] = 0;
+    wmax[l] = 0.0;
+    threshold[l] = nnlsThresh_;
+    active[l] = !states[l].done;
+    freeStep[l] = false;
+  }
+
+  auto nextIteration = [&](int l) {
+    freeStep[l] = false;
+    ++iter[l];
+
+    //adaptive convergence threshold to avoid infinite loops but still
+    //ensure best value is used
+    if (iter[l] % 10 == 0) {
+      threshold[l] *= 10.;
+    }
+  };
+
+  while (true) {
+    bool anyUpdate = false;
+    for (int l = 0; l < W; ++l)
+      anyUpdate |= active[l] && !freeStep[l];
+
+    if (anyUpdate) {
+      V updateWork[MaxPVSize];
+      for (unsigned int i = 0; i < npulse; ++i) {
+        V e = aTaPerm[i][0] * ampVecPerm[0];
+        for (unsigned int j = 1; j < npulse; ++j)
+          e += aTaPerm[i][j] * ampVecPerm[j];
+        updateWork[i] = aTbPerm[i] - e;
+      }
+
+      for (int l = 0; l < W; ++l) {
+        if (!active[l] || freeStep[l])
+          continue;
+
+        if (nP[l] == nmax) {
+          active[l] = false;
+          continue;
+        }
+
+        Index idxwmaxprev = idxwmax[l];
+        double wmaxprev = wmax[l];
+        idxwmax[l] = 0;
+        wmax[l] = lane(updateWork[nP[l]], l);
+        for (unsigned int i = nP[l] + 1; i < npulse; ++i) {
+          if (lane(updateWork[i], l) > wmax[l]) {
+            wmax[l] = lane(updateWork[i], l);
+            idxwmax[l] = i - nP[l];
+          }
+        }
+
+        if (wmax[l] < threshold[l] || (idxwmax[l] == idxwmaxprev && wmax[l] == wmaxprev) ||
+            iter[l] >= nMaxItersNNLS_) {
+          active[l] = false;
+          continue;
+        }
+
+        //unconstrain parameter
+        idxwmax[l] += nP[l];
+        swapParameters(l, nP[l], idxwmax[l]);
+        ++nP[l];
+        freeStep[l] = true;
+      }
+    }
+
+    bool anyFree = false;
+    for (int l = 0; l < W; ++l)
+      anyFree |= freeStep[l];
+    if (!anyFree) {
+      bool anyActive = false;
+      for (int l = 0; l < W; ++l)
+        anyActive |= active[l];
+      if (anyActive)
+        continue;
+      break;
+    }
+
+    //solve for the free parameters, the others up to the largest nP are
+    //replaced by the identity
+    unsigned int nFree = 0;
+    for (int l = 0; l < W; ++l)
+      if (freeStep[l])
+        nFree = std::max(nFree, nP[l]);
+    V isFree[MaxPVSize];
+    for (unsigned int i = 0; i < nFree; ++i)
+      for (int l = 0; l < W; ++l)
+        setLane(isFree[i], l, freeStep[l] && i < nP[l] ? 1. : 0.);
+
+    //LDLT decomposition without pivoting, the inverse of D is kept
+    V mL[MaxPVSize][MaxPVSize];
+    V dinv[MaxPVSize];
+    for (unsigned int j = 0; j < nFree; ++j) {
+      V dj = isFree[j] * aTaPerm[j][j] + (1. - isFree[j]);
+      for (unsigned int k = 0; k < j; ++k)
+        dj -= mL[j][k] * mL[j][k] * dinv[k];
+      dinv[j] = 1. / dj;
+      for (unsigned int i = j + 1; i < nFree; ++i) {
+        V e = isFree[i] * isFree[j] * aTaPerm[i][j];
+        for (unsigned int k = 0; k < j; ++k)
+          e -= mL[i][k] * mL[j][k] * dinv[k];
+        mL[i][j] = e;
+      }
+    }
+    V ampvecpermtest[MaxPVSize];
+    for (unsigned int i = 0; i < nFree; ++i) {
+      V e = isFree[i] * aTbPerm[i];
+      for (unsigned int k = 0; k < i; ++k)
+        e -= mL[i][k] * dinv[k] * ampvecpermtest[k];
+      ampvecpermtest[i] = e;
+    }
+    for (unsigned int i = nFree; i-- > 0;) {
+      V e = ampvecpermtest[i] * dinv[i];
+      for (unsigned int k = i + 1; k < nFree; ++k)
+        e -= mL[k][i] * dinv[i] * ampvecpermtest[k];
+      ampvecpermtest[i] = e;
+    }
+
+    for (int l = 0; l < W; ++l) {
+      if (!freeStep[l])
+        continue;
+
+      //check solution
+      bool positive = true;
+      for (unsigned int i = 0; i < nP[l]; ++i)
+        positive &= (lane(ampvecpermtest[i], l) > 0);
+      if (positive) {
+        for (unsigned int i = 0; i < nP[l]; ++i)
+          setLane(ampVecPerm[i], l, lane(ampvecpermtest[i], l));
+        nextIteration(l);
+        continue;
+      }
+
+      //update parameter vector
+      Index minratioidx = 0;
+      double minratio = std::numeric_limits<double>::max();
+      for (unsigned int ipulse = 0; ipulse < nP[l]; ++ipulse) {
+        if (lane(ampvecpermtest[ipulse], l) <= 0.) {
+          const double c_ampvec = lane(ampVecPerm[ipulse], l);
+          const double ratio = c_ampvec / (c_ampvec - lane(ampvecpermtest[ipulse], l));
+          if (ratio < minratio) {
+            minratio = ratio;
+            minratioidx = ipulse;
+          }
+        }
+      }
+      for (unsigned int i = 0; i < nP[l]; ++i) {
+        const double c_ampvec = lane(ampVecPerm[i], l);
+        setLane(ampVecPerm[i], l, c_ampvec + minratio * (lane(ampvecpermtest[i], l) - c_ampvec));
+      }
+
+      //avoid numerical problems with later ==0. check
+      setLane(ampVecPerm[minratioidx], l, 0.);
+
+      //constrain parameter
+      swapParameters(l, nP[l] - 1, minratioidx);
+      --nP[l];
+      if (nP[l] == 0)
+        nextIteration(l);
+    }
+  }
+
+  for (int l = 0; l < W; ++l) {
+    if (states[l].done)
+      continue;
+    for (unsigned int i = 0; i < npulse; ++i)
+      states[l].ampVec.coeffRef(states[l].perm[i]) = lane(ampVecPerm[i], l);
+  }
+}
@@ -0,0 +1,108 @@
+// Compares the batched fit of MahiFit with phase1Apply and times both.
+// Usage: testMahiFitBatch [number of channels]
+
+#include "RecoLocalCalo/HcalRecAlgos/interface/MahiFit.h"
+#include "CalibCalorimetry/HcalAlgos/interface/HcalPulseShapes.h"
+#include "CalibCalorimetry/HcalAlgos/interface/HcalTimeSlew.h"
+#include "DataFormats/HcalRecHit/interface/HBHEChannelInfo.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+int main(int argc, char** argv) {
+  const unsigned int nChannels = argc > 1 ? std::atoi(argv[1]) : 5000;
+  const unsigned int nSamples = 8;
+  const unsigned int soi = 3;
+
+  HcalPulseShapes pulseShapes;
+  HcalTimeSlew timeSlew;
+  timeSlew.addM2ParameterSet(23.960177, -3.178648, 16);
+  timeSlew.addM2ParameterSet(11.977461, -1.5610227, 10);
+  timeSlew.addM2ParameterSet(9.109694, -1.075824, 6.25);
+
+  // parameters of HBHEMahiParameters_cfi
+  MahiFit mahi;
+  mahi.setParameters(false,
+                     0.,
+                     15.,
+                     true,
+                     HcalTimeSlew::Medium,
+                     true,
+                     0.,
+                     5.,
+                     2.5,
+                     {-3, -2, -1, 0, 1, 2, 3, 4},
+                     500,
+                     500,
+                     1e-3,
+                     1e-11);
+  mahi.setPulseShapeTemplate(pulseShapes.hbShape(), false, &timeSlew, nSamples);
+
+  // in-time pulse over a wide range of amplitudes, out-of-time pileup in some of the bunch crossings
+  const double fraction[nSamples] = {0.02, 0.6, 0.3, 0.06, 0.02, 0., 0., 0.};
+  const double ped = 20., pedWidth = 1.5, gain = 0.2;
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> flat(0., 1.);
+  std::normal_distribution<double> gauss(0., 1.);
+  std::vector<HBHEChannelInfo> channels(nChannels, HBHEChannelInfo(false, false));
+  for (auto& channel : channels) {
+    channel.setChannelInfo(HcalDetId(HcalBarrel, 1, 1, 1), 105, nSamples, soi, 0, 0., 0.3, 0., false, false, false);
+    double charge[nSamples] = {};
+    const double amplitude = 2000. * std::pow(flat(gen), 4);
+    for (int bx = -3; bx <= 4; ++bx) {
+      const double pileup = flat(gen) < 0.3 ? 50. * std::pow(flat(gen), 2) : 0.;
+      for (int ts = std::max(0, int(soi) + bx); ts < int(nSamples); ++ts)
+        charge[ts] += (bx == 0 ? amplitude : pileup) * fraction[ts - soi - bx];
+    }
+    for (unsigned int ts = 0; ts < nSamples; ++ts) {
+      const double q = ped + charge[ts] + std::sqrt(pedWidth * pedWidth + 0.5 * charge[ts]) * gauss(gen);
+      channel.setSample(ts, 0, 1.f, q, ped, pedWidth, gain, 0., -100.f);
+    }
+  }
+
+  std::vector<float> energy(nChannels), time(nChannels), chi2(nChannels);
+  std::vector<bool> useTriple(nChannels);
+  const auto start = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < nChannels; ++i) {
+    bool triple;
+    mahi.phase1Apply(channels[i], energy[i], time[i], triple, chi2[i]);
+    useTriple[i] = triple;
+  }
+  const auto stop = std::chrono::steady_clock::now();
+
+  std::vector<float> batchEnergy(nChannels), batchTime(nChannels), batchChi2(nChannels);
+  std::vector<bool> batchUseTriple(nChannels);
+  const auto batchStart = std::chrono::steady_clock::now();
+  mahi.clearBatch();
+  for (unsigned int i = 0; i < nChannels; ++i)
+    mahi.addToBatch(channels[i]);
+  mahi.fitBatch();
+  for (unsigned int i = 0; i < nChannels; ++i) {
+    bool triple;
+    mahi.batchResult(i, batchEnergy[i], batchTime[i], triple, batchChi2[i]);
+    batchUseTriple[i] = triple;
+  }
+  const auto batchStop = std::chrono::steady_clock::now();
+
+  unsigned int nBad = 0;
+  for (unsigned int i = 0; i < nChannels; ++i) {
+    if (useTriple[i] != batchUseTriple[i] || std::abs(energy[i] - batchEnergy[i]) > 1e-4 * (1. + energy[i]) ||
+        std::abs(time[i] - batchTime[i]) > 1e-3 || std::abs(chi2[i] - batchChi2[i]) > 1e-4 * (1. + chi2[i])) {
+      std::cout << "channel " << i << ": energy " << energy[i] << " " << batchEnergy[i] << ", time " << time[i] << " "
+                << batchTime[i] << ", chi2 " << chi2[i] << " " << batchChi2[i] << std::endl;
+      ++nBad;
+    }
+  }
+
+  std::cout << "phase1Apply " << std::chrono::duration<double, std::micro>(stop - start).count() / nChannels
+            << " us/channel, batch "
+            << std::chrono::duration<double, std::micro>(batchStop - batchStart).count() / nChannels << " us/channel, "
+            << nBad << " channels differ" << std::endl;
+
+  return nBad == 0 ? 0 : 1;
+}
@@ -249,6 +249,7 @@ def addL3ToHLT(process):
 	    useHitsSplitting = cms.bool(True),
 	    doSeedingRegionRebuilding = cms.bool(True),
 	    maxNSeeds = cms.uint32(500000),
+	    seedsPerParallelChunk = cms.uint32(0),
 	    maxSeedsBeforeCleaning = cms.uint32(5000),
 	    src = cms.InputTag('hltIterL3OISeedsFromL2Muons'),
 	    SimpleMagneticField = cms.string(''),
@@ -543,6 +544,7 @@ def addL3ToHLT(process):
 	    RedundantSeedCleaner = cms.string( "CachingSeedCleanerBySharedInput" ),
 	    doSeedingRegionRebuilding = cms.bool( False ),
 	    maxNSeeds = cms.uint32( 100000 ),
+	    seedsPerParallelChunk = cms.uint32( 0 ),
 	    TrajectoryBuilderPSet = cms.PSet(  refToPSet_ = cms.string( "HLTIter0HighPtTkMuPSetTrajectoryBuilderIT" ) ),
 	    NavigationSchool = cms.string( "SimpleNavigationSchool" ),
 	    TrajectoryBuilder = cms.string( "" ),
@@ -707,6 +709,7 @@ def addL3ToHLT(process):
 	    RedundantSeedCleaner = cms.string( "CachingSeedCleanerBySharedInput" ),
 	    doSeedingRegionRebuilding = cms.bool( False ),
 	    maxNSeeds = cms.uint32( 100000 ),
+	    seedsPerParallelChunk = cms.uint32( 0 ),
 	    TrajectoryBuilderPSet = cms.PSet(  refToPSet_ = cms.string( "HLTIter2HighPtTkMuPSetTrajectoryBuilderIT" ) ),
 	    NavigationSchool = cms.string( "SimpleNavigationSchool" ),
 	    TrajectoryBuilder = cms.string( "" ),
@@ -5,8 +5,7 @@
 #include "CondFormats/PhysicsToolsObjects/interface/PerformancePayloadFromTFormula.h"
 
 #include "CondFormats/ESObjects/interface/ESEEIntercalibConstants.h"
-
-class TF1;
+#include "CommonTools/Utils/interface/FormulaEvaluator.h"
 
 // -*- C++ -*-
 //
@@ -84,31 +83,45 @@ protected:
   const PerformancePayloadFromTFormula* pfCalibrations;
   const ESEEIntercalibConstants* esEEInterCalib_;
 
+  // Default calibration function. Unlike TF1::Eval, eval() does not modify
+  // any state, so PFAlgo can call it from several tasks at once.
+  class CalibrationFunction {
+  public:
+    CalibrationFunction(const std::string& formula, std::vector<double> parameters);
+    double eval(double x) const;
+    void print(std::ostream& out) const;
+
+  private:
+    std::string formula_;
+    reco::FormulaEvaluator evaluator_;
+    std::vector<double> parameters_;
+  };
+
   // Barrel calibration (eta 0.00 -> 1.48)
-  std::unique_ptr<TF1> faBarrel;
-  std::unique_ptr<TF1> fbBarrel;
-  std::unique_ptr<TF1> fcBarrel;
-  std::unique_ptr<TF1> faEtaBarrelEH;
-  std::unique_ptr<TF1> fbEtaBarrelEH;
-  std::unique_ptr<TF1> faEtaBarrelH;
-  std::unique_ptr<TF1> fbEtaBarrelH;
+  std::unique_ptr<CalibrationFunction> faBarrel;
+  std::unique_ptr<CalibrationFunction> fbBarrel;
+  std::unique_ptr<CalibrationFunction> fcBarrel;
+  std::unique_ptr<CalibrationFunction> faEtaBarrelEH;
+  std::unique_ptr<CalibrationFunction> fbEtaBarrelEH;
+  std::unique_ptr<CalibrationFunction> faEtaBarrelH;
+  std::unique_ptr<CalibrationFunction> fbEtaBarrelH;
 
   // Endcap calibration (eta 1.48 -> 3.xx)
-  std::unique_ptr<TF1> faEndcap;
-  std::unique_ptr<TF1> fbEndcap;
-  std::unique_ptr<TF1> fcEndcap;
-  std::unique_ptr<TF1> faEtaEndcapEH;
-  std::unique_ptr<TF1> fbEtaEndcapEH;
-  std::unique_ptr<TF1> faEtaEndcapH;
-  std::unique_ptr<TF1> fbEtaEndcapH;
+  std::unique_ptr<CalibrationFunction> faEndcap;
+  std::unique_ptr<CalibrationFunction> fbEndcap;
+  std::unique_ptr<CalibrationFunction> fcEndcap;
+  std::unique_ptr<CalibrationFunction> faEtaEndcapEH;
+  std::unique_ptr<CalibrationFunction> fbEtaEndcapEH;
+  std::unique_ptr<CalibrationFunction> faEtaEndcapH;
+  std::unique_ptr<CalibrationFunction> fbEtaEndcapH;
 
   //added by Bhumika on 2 august 2018
-  std::unique_ptr<TF1> fcEtaBarrelEH;
-  std::unique_ptr<TF1> fcEtaEndcapEH;
-  std::unique_ptr<TF1> fdEtaEndcapEH;
-  std::unique_ptr<TF1> fcEtaBarrelH;
-  std::unique_ptr<TF1> fcEtaEndcapH;
-  std::unique_ptr<TF1> fdEtaEndcapH;
+  std::unique_ptr<CalibrationFunction> fcEtaBarrelEH;
+  std::unique_ptr<CalibrationFunction> fcEtaEndcapEH;
+  std::unique_ptr<CalibrationFunction> fdEtaEndcapEH;
+  std::unique_ptr<CalibrationFunction> fcEtaBarrelH;
+  std::unique_ptr<CalibrationFunction> fcEtaEndcapH;
+  std::unique_ptr<CalibrationFunction> fdEtaEndcapH;
 
 private:
   double minimum(double a, double b) const;
@@ -5,15 +5,39 @@
 #include "CondFormats/ESObjects/interface/ESEEIntercalibConstants.h"
 
 #include <TMath.h>
+#include <array>
 #include <cmath>
 #include <vector>
-#include <TF1.h>
 #include <map>
 #include <algorithm>
 #include <numeric>
 
 using namespace std;
 
+namespace {
+  // functional forms of the default calibration functions
+  const std::string kEnergyForm = "[0]+((([1]+([2]/sqrt(x)))*exp(-(x^[6]/[3])))-([4]*exp(-(x^[7]/[5]))))";
+  const std::string kExpForm = "[0]+[1]*exp(-x/[2])";
+  const std::string kLinearForm = "[0]+[1]*x";
+  const std::string kExpGausForm = "[0]+[1]*exp(-x/[2])+[3]*[3]*exp(-x*x/([4]*[4]))";
+  const std::string kPowerForm = "[3]*((x-[0])^[1])+[2]";
+}  // namespace
+
+PFEnergyCalibration::CalibrationFunction::CalibrationFunction(const std::string& formula,
+                                                              std::vector<double> parameters)
+    : formula_(formula), evaluator_(formula), parameters_(std::move(parameters)) {}
+
+double PFEnergyCalibration::CalibrationFunction::eval(double x) const {
+  return evaluator_.evaluate(std::array<double, 1>{{x}}, parameters_);
+}
+
+void PFEnergyCalibration::CalibrationFunction::print(std::ostream& out) const {
+  out << formula_ << " with parameters";
+  for (auto p : parameters_)
+    out << " " << p;
+  out << std::endl;
+}
+
 PFEnergyCalibration::PFEnergyCalibration() : pfCalibrations(nullptr), esEEInterCalib_(nullptr) {
   initializeCalibrationFunctions();
 }
@@ -25,140 +49,46 @@ void PFEnergyCalibration::initializeCalibrationFunctions() {
   threshH = 2.5;
 
   //calibChrisClean.C calibration parameters bhumika Nov, 2018
-  faBarrel = std::make_unique<TF1>(
-      "faBarrel", "[0]+((([1]+([2]/sqrt(x)))*exp(-(x^[6]/[3])))-([4]*exp(-(x^[7]/[5]))))", 0., 1000.);
-  faBarrel->SetParameter(0, -30.7141);
-  faBarrel->SetParameter(1, 31.7583);
-  faBarrel->SetParameter(2, 4.40594);
-  faBarrel->SetParameter(3, 1.70914);
-  faBarrel->SetParameter(4, 0.0613696);
-  faBarrel->SetParameter(5, 0.000104857);
-  faBarrel->SetParameter(6, -1.38927);
-  faBarrel->SetParameter(7, -0.743082);
-  fbBarrel = std::make_unique<TF1>(
-      "fbBarrel", "[0]+((([1]+([2]/sqrt(x)))*exp(-(x^[6]/[3])))-([4]*exp(-(x^[7]/[5]))))", 0., 1000.);
-  fbBarrel->SetParameter(0, 2.25366);
-  fbBarrel->SetParameter(1, 0.537715);
-  fbBarrel->SetParameter(2, -4.81375);
-  fbBarrel->SetParameter(3, 12.109);
-  fbBarrel->SetParameter(4, 1.80577);
-  fbBarrel->SetParameter(5, 0.187919);
-  fbBarrel->SetParameter(6, -6.26234);
-  fbBarrel->SetParameter(7, -0.607392);
-  fcBarrel = std::make_unique<TF1>(
-      "fcBarrel", "[0]+((([1]+([2]/sqrt(x)))*exp(-(x^[6]/[3])))-([4]*exp(-(x^[7]/[5]))))", 0., 1000.);
-  fcBarrel->SetParameter(0, 1.5125962);
-  fcBarrel->SetParameter(1, 0.855057);
-  fcBarrel->SetParameter(2, -6.04199);
-  fcBarrel->SetParameter(3, 2.08229);
-  fcBarrel->SetParameter(4, 0.592266);
-  fcBarrel->SetParameter(5, 0.0291232);
-  fcBarrel->SetParameter(6, 0.364802);
-  fcBarrel->SetParameter(7, -1.50142);
-  faEtaBarrelEH = std::make_unique<TF1>("faEtaBarrelEH", "[0]+[1]*exp(-x/[2])", 0., 1000.);
-  faEtaBarrelEH->SetParameter(0, 0.0185555);
-  faEtaBarrelEH->SetParameter(1, -0.0470674);
-  faEtaBarrelEH->SetParameter(2, 396.959);
-  fbEtaBarrelEH = std::make_unique<TF1>("fbEtaBarrelEH", "[0]+[1]*exp(-x/[2])", 0., 1000.);
-  fbEtaBarrelEH->SetParameter(0, 0.0396458);
-  fbEtaBarrelEH->SetParameter(1, 0.114128);
-  fbEtaBarrelEH->SetParameter(2, 251.405);
-  faEtaBarrelH = std::make_unique<TF1>("faEtaBarrelH", "[0]+[1]*x", 0., 1000.);
-  faEtaBarrelH->SetParameter(0, 0.00434994);
-  faEtaBarrelH->SetParameter(1, -5.16564e-06);
-  fbEtaBarrelH = std::make_unique<TF1>("fbEtaBarrelH", "[0]+[1]*exp(-x/[2])", 0., 1000.);
-  fbEtaBarrelH->SetParameter(0, -0.0232604);
-  fbEtaBarrelH->SetParameter(1, 0.0937525);
-  fbEtaBarrelH->SetParameter(2, 34.9935);
-
-  faEndcap = std::make_unique<TF1>(
-      "faEndcap", "[0]+((([1]+([2]/sqrt(x)))*exp(-(x^[6]/[3])))-([4]*exp(-(x^[7]/[5]))))", 0., 1000.);
-  faEndcap->SetParameter(0, 1.17227);
-  faEndcap->SetParameter(1, 13.1489);
-  faEndcap->SetParameter(2, -29.1672);
-  faEndcap->SetParameter(3, 0.604223);
-  faEndcap->SetParameter(4, 0.0426363);
-  faEndcap->SetParameter(5, 3.30898e-15);
-  faEndcap->SetParameter(6, 0.165293);
-  faEndcap->SetParameter(7, -7.56786);
-  fbEndcap = std::make_unique<TF1>(
-      "fbEndcap", "[0]+((([1]+([2]/sqrt(x)))*exp(-(x^[6]/[3])))-([4]*exp(-(x^[7]/[5]))))", 0., 1000.);
-  fbEndcap->SetParameter(0, -0.974251);
-  fbEndcap->SetParameter(1, 1.61733);
-  fbEndcap->SetParameter(2, 0.0629183);
-  fbEndcap->SetParameter(3, 7.78495);
-  fbEndcap->SetParameter(4, -0.774289);
-  fbEndcap->SetParameter(5, 7.81399e-05);
-  fbEndcap->SetParameter(6, 0.139116);
-  fbEndcap->SetParameter(7, -4.25551);
-  fcEndcap = std::make_unique<TF1>(
-      "fcEndcap", "[0]+((([1]+([2]/sqrt(x)))*exp(-(x^[6]/[3])))-([4]*exp(-(x^[7]/[5]))))", 0., 1000.);
-  fcEndcap->SetParameter(0, 1.01863);
-  fcEndcap->SetParameter(1, 1.29787);
-  fcEndcap->SetParameter(2, -3.97293);
-  fcEndcap->SetParameter(3, 21.7805);
-  fcEndcap->SetParameter(4, 0.810195);
-  fcEndcap->SetParameter(5, 0.234134);
-  fcEndcap->SetParameter(6, 1.42226);
-  fcEndcap->SetParameter(7, -0.0997326);
-  faEtaEndcapEH = std::make_unique<TF1>("faEtaEndcapEH", "[0]+[1]*exp(-x/[2])", 0., 1000.);
-  faEtaEndcapEH->SetParameter(0, 0.0112692);
-  faEtaEndcapEH->SetParameter(1, -2.68063);
-  faEtaEndcapEH->SetParameter(2, 2.90973);
-  fbEtaEndcapEH = std::make_unique<TF1>("fbEtaEndcapEH", "[0]+[1]*exp(-x/[2])", 0., 1000.);
-  fbEtaEndcapEH->SetParameter(0, -0.0192991);
-  fbEtaEndcapEH->SetParameter(1, -0.265);
-  fbEtaEndcapEH->SetParameter(2, 80.5502);
-  faEtaEndcapH = std::make_unique<TF1>("faEtaEndcapH", "[0]+[1]*exp(-x/[2])+[3]*[3]*exp(-x*x/([4]*[4]))", 0., 1000.);
-  faEtaEndcapH->SetParameter(0, -0.0106029);
-  faEtaEndcapH->SetParameter(1, -0.692207);
-  faEtaEndcapH->SetParameter(2, 0.0542991);
-  faEtaEndcapH->SetParameter(3, -0.171435);
-  faEtaEndcapH->SetParameter(4, -61.2277);
-  fbEtaEndcapH = std::make_unique<TF1>("fbEtaEndcapH", "[0]+[1]*exp(-x/[2])+[3]*[3]*exp(-x*x/([4]*[4]))", 0., 1000.);
-  fbEtaEndcapH->SetParameter(0, 0.0214894);
-  fbEtaEndcapH->SetParameter(1, -0.266704);
-  fbEtaEndcapH->SetParameter(2, 5.2112);
-  fbEtaEndcapH->SetParameter(3, 0.303578);
-  fbEtaEndcapH->SetParameter(4, -104.367);
+  faBarrel = std::make_unique<CalibrationFunction>(
+      kEnergyForm,
+      std::vector<double>{-30.7141, 31.7583, 4.40594, 1.70914, 0.0613696, 0.000104857, -1.38927, -0.743082});
+  fbBarrel = std::make_unique<CalibrationFunction>(
+      kEnergyForm, std::vector<double>{2.25366, 0.537715, -4.81375, 12.109, 1.80577, 0.187919, -6.26234, -0.607392});
+  fcBarrel = std::make_unique<CalibrationFunction>(
+      kEnergyForm,
+      std::vector<double>{1.5125962, 0.855057, -6.04199, 2.08229, 0.592266, 0.0291232, 0.364802, -1.50142});
+  faEtaBarrelEH = std::make_unique<CalibrationFunction>(kExpForm, std::vector<double>{0.0185555, -0.0470674, 396.959});
+  fbEtaBarrelEH = std::make_unique<CalibrationFunction>(kExpForm, std::vector<double>{0.0396458, 0.114128, 251.405});
+  faEtaBarrelH = std::make_unique<CalibrationFunction>(kLinearForm, std::vector<double>{0.00434994, -5.16564e-06});
+  fbEtaBarrelH = std::make_unique<CalibrationFunction>(kExpForm, std::vector<double>{-0.0232604, 0.0937525, 34.9935});
+
+  faEndcap = std::make_unique<CalibrationFunction>(
+      kEnergyForm,
+      std::vector<double>{1.17227, 13.1489, -29.1672, 0.604223, 0.0426363, 3.30898e-15, 0.165293, -7.56786});
+  fbEndcap = std::make_unique<CalibrationFunction>(
+      kEnergyForm,
+      std::vector<double>{-0.974251, 1.61733, 0.0629183, 7.78495, -0.774289, 7.81399e-05, 0.139116, -4.25551});
+  fcEndcap = std::make_unique<CalibrationFunction>(
+      kEnergyForm, std::vector<double>{1.01863, 1.29787, -3.97293, 21.7805, 0.810195, 0.234134, 1.42226, -0.0997326});
+  faEtaEndcapEH = std::make_unique<CalibrationFunction>(kExpForm, std::vector<double>{0.0112692, -2.68063, 2.90973});
+  fbEtaEndcapEH = std::make_unique<CalibrationFunction>(kExpForm, std::vector<double>{-0.0192991, -0.265, 80.5502});
+  faEtaEndcapH = std::make_unique<CalibrationFunction>(
+      kExpGausForm, std::vector<double>{-0.0106029, -0.692207, 0.0542991, -0.171435, -61.2277});
+  fbEtaEndcapH = std::make_unique<CalibrationFunction>(
+      kExpGausForm, std::vector<double>{0.0214894, -0.266704, 5.2112, 0.303578, -104.367});
 
   //added by Bhumika on 2 august 2018
+  fcEtaBarrelH = std::make_unique<CalibrationFunction>(kPowerForm, std::vector<double>{0, 2, 0, 1});
+
+  fcEtaEndcapH = std::make_unique<CalibrationFunction>(kPowerForm, std::vector<double>{0, 0, 0.05, 0});
+
+  fdEtaEndcapH = std::make_unique<CalibrationFunction>(kPowerForm, std::vector<double>{1.5, 4, -1.1, 1.0});
+
+  fcEtaBarrelEH = std::make_unique<CalibrationFunction>(kPowerForm, std::vector<double>{0, 2, 0, 1});
+
+  fcEtaEndcapEH = std::make_unique<CalibrationFunction>(kPowerForm, std::vector<double>{0, 0, 0, 0});
 
-  fcEtaBarrelH = std::make_unique<TF1>("fcEtaBarrelH", "[3]*((x-[0])^[1])+[2]", 0., 1000.);
-  fcEtaBarrelH->SetParameter(0, 0);
-  fcEtaBarrelH->SetParameter(1, 2);
-  fcEtaBarrelH->SetParameter(2, 0);
-  fcEtaBarrelH->SetParameter(3, 1);
-
-  fcEtaEndcapH = std::make_unique<TF1>("fcEtaEndcapH", "[3]*((x-[0])^[1])+[2]", 0., 1000.);
-  fcEtaEndcapH->SetParameter(0, 0);
-  fcEtaEndcapH->SetParameter(1, 0);
-  fcEtaEndcapH->SetParameter(2, 0.05);
-  fcEtaEndcapH->SetParameter(3, 0);
-
-  fdEtaEndcapH = std::make_unique<TF1>("fdEtaEndcapH", "[3]*((x-[0])^[1])+[2]", 0., 1000.);
-  fdEtaEndcapH->SetParameter(0, 1.5);
-  fdEtaEndcapH->SetParameter(1, 4);
-  fdEtaEndcapH->SetParameter(2, -1.1);
-  fdEtaEndcapH->SetParameter(3, 1.0);
-
-  fcEtaBarrelEH = std::make_unique<TF1>("fcEtaBarrelEH", "[3]*((x-[0])^[1])+[2]", 0., 1000.);
-  fcEtaBarrelEH->SetParameter(0, 0);
-  fcEtaBarrelEH->SetParameter(1, 2);
-  fcEtaBarrelEH->SetParameter(2, 0);
-  fcEtaBarrelEH->SetParameter(3, 1);
-
-  fcEtaEndcapEH = std::make_unique<TF1>("fcEtaEndcapEH", "[3]*((x-[0])^[1])+[2]", 0., 1000.);
-  fcEtaEndcapEH->SetParameter(0, 0);
-  fcEtaEndcapEH->SetParameter(1, 0);
-  fcEtaEndcapEH->SetParameter(2, 0);
-  fcEtaEndcapEH->SetParameter(3, 0);
-
-  fdEtaEndcapEH = std::make_unique<TF1>("fdEtaEndcapEH", "[3]*((x-[0])^[1])+[2]", 0., 1000.);
-  fdEtaEndcapEH->SetParameter(0, 1.5);
-  fdEtaEndcapEH->SetParameter(1, 2.0);
-  fdEtaEndcapEH->SetParameter(2, 0.6);
-  fdEtaEndcapEH->SetParameter(3, 1.0);
+  fdEtaEndcapEH = std::make_unique<CalibrationFunction>(kPowerForm, std::vector<double>{1.5, 2.0, 0.6, 1.0});
 }
 
 void PFEnergyCalibration::energyEmHad(double t, double& e, double& h, double eta, double phi) const {
@@ -273,7 +203,7 @@ double PFEnergyCalibration::aBarrel(double x) const {
     return pfCalibrations->getResult(PerformanceResult::PFfa_BARREL, point);
 
   } else {
-    return faBarrel->Eval(x);
+    return faBarrel->eval(x);
   }
 }
 
@@ -284,7 +214,7 @@ double PFEnergyCalibration::bBarrel(double x) const {
     return pfCalibrations->getResult(PerformanceResult::PFfb_BARREL, point);
 
   } else {
-    return fbBarrel->Eval(x);
+    return fbBarrel->eval(x);
   }
 }
 
@@ -295,7 +225,7 @@ double PFEnergyCalibration::cBarrel(double x) const {
     return pfCalibrations->getResult(PerformanceResult::PFfc_BARREL, point);
 
   } else {
-    return fcBarrel->Eval(x);
+    return fcBarrel->eval(x);
   }
 }
 
@@ -306,7 +236,7 @@ double PFEnergyCalibration::aEtaBarrelEH(double x) const {
     return pfCalibrations->getResult(PerformanceResult::PFfaEta_BARRELEH, point);
 
   } else {
-    return faEtaBarrelEH->Eval(x);
+    return faEtaBarrelEH->eval(x);
   }
 }
 
@@ -317,7 +247,7 @@ double PFEnergyCalibration::bEtaBarrelEH(double x) const {
     return pfCalibrations->getResult(PerformanceResult::PFfbEta_BARRELEH, point);
 
   } else {
-    return fbEtaBarrelEH->Eval(x);
+    return fbEtaBarrelEH->eval(x);
   }
 }
 
@@ -328,7 +258,7 @@ double PFEnergyCalibration::aEtaBarrelH(double x) const {
     return pfCalibrations->getResult(PerformanceResult::PFfaEta_BARRELH, point);
 
   } else {
-    return faEtaBarrelH->Eval(x);
+    return faEtaBarrelH->eval(x);
   }
 }
 
@@ -339,7 +269,7 @@ double PFEnergyCalibration::bEtaBarrelH(double x) const {
     return pfCalibrations->getResult(PerformanceResult::PFfbEta_BARRELH, point);
 
   } else {
-    return fbEtaBarrelH->Eval(x);
+    return fbEtaBarrelH->eval(x);
   }
 }
 
@@ -350,7 +280,7 @@ double PFEnergyCalibration::aEndcap(double x) const {
     return pfCalibrations->getResult(PerformanceResult::PFfa_ENDCAP, point);
 
   } else {
-    return faEndcap->Eval(x);
+    return faEndcap->eval(x);
   }
 }
 
@@ -361,7 +291,7 @@ double PFEnergyCalibration::bEndcap(double x) const {
     return pfCalibrations->getResult(PerformanceResult::PFfb_ENDCAP, point);
 
   } else {
-    return fbEndcap->Eval(x);
+    return fbEndcap->eval(x);
   }
 }
 
@@ -372,7 +302,7 @@ double PFEnergyCalibration::cEndcap(double x) const {
     return pfCalibrations->getResult(PerformanceResult::PFfc_ENDCAP, point);
 
   } else {
-    return fcEndcap->Eval(x);
+    return fcEndcap->eval(x);
   }
 }
 
@@ -383,7 +313,7 @@ double PFEnergyCalibration::aEtaEndcapEH(double x) const {
     return pfCalibrations->getResult(PerformanceResult::PFfaEta_ENDCAPEH, point);
 
   } else {
-    return faEtaEndcapEH->Eval(x);
+    return faEtaEndcapEH->eval(x);
   }
 }
 
@@ -394,7 +324,7 @@ double PFEnergyCalibration::bEtaEndcapEH(double x) const {
     return pfCalibrations->getResult(PerformanceResult::PFfbEta_ENDCAPEH, point);
 
   } else {
-    return fbEtaEndcapEH->Eval(x);
+    return fbEtaEndcapEH->eval(x);
   }
 }
 
@@ -405,7 +335,7 @@ double PFEnergyCalibration::aEtaEndcapH(double x) const {
     return pfCalibrations->getResult(PerformanceResult::PFfaEta_ENDCAPH, point);
 
   } else {
-    return faEtaEndcapH->Eval(x);
+    return faEtaEndcapH->eval(x);
   }
 }
 
@@ -415,7 +345,7 @@ double PFEnergyCalibration::bEtaEndcapH(double x) const {
     point.insert(BinningVariables::JetEt, x);
     return pfCalibrations->getResult(PerformanceResult::PFfbEta_ENDCAPH, point);
   } else {
-    return fbEtaEndcapH->Eval(x);
+    return fbEtaEndcapH->eval(x);
   }
 }
 
@@ -428,7 +358,7 @@ double PFEnergyCalibration::cEtaBarrelH(double x) const {
     return pfCalibrations->getResult(PerformanceResult::PFfcEta_BARRELH, point);
 
   } else {
-    return fcEtaBarrelH->Eval(x);
+    return fcEtaBarrelH->eval(x);
   }
 }
 double PFEnergyCalibration::cEtaEndcapH(double x) const {
@@ -438,7 +368,7 @@ double PFEnergyCalibration::cEtaEndcapH(double x) const {
     return pfCalibrations->getResult(PerformanceResult::PFfcEta_ENDCAPH, point);
 
   } else {
-    return fcEtaEndcapH->Eval(x);
+    return fcEtaEndcapH->eval(x);
   }
 }
 
@@ -449,7 +379,7 @@ double PFEnergyCalibration::dEtaEndcapH(double x) const {
     return pfCalibrations->getResult(PerformanceResult::PFfdEta_ENDCAPH, point);
 
   } else {
-    return fdEtaEndcapH->Eval(x);
+    return fdEtaEndcapH->eval(x);
   }
 }
 
@@ -460,7 +390,7 @@ double PFEnergyCalibration::cEtaBarrelEH(double x) const {
     return pfCalibrations->getResult(PerformanceResult::PFfcEta_BARRELEH, point);
 
   } else {
-    return fcEtaBarrelEH->Eval(x);
+    return fcEtaBarrelEH->eval(x);
   }
 }
 
@@ -471,7 +401,7 @@ double PFEnergyCalibration::cEtaEndcapEH(double x) const {
     return pfCalibrations->getResult(PerformanceResult::PFfcEta_ENDCAPEH, point);
 
   } else {
-    return fcEtaEndcapEH->Eval(x);
+    return fcEtaEndcapEH->eval(x);
   }
 }
 
@@ -482,7 +412,7 @@ double PFEnergyCalibration::dEtaEndcapEH(double x) const {
     return pfCalibrations->getResult(PerformanceResult::PFfdEta_ENDCAPEH, point);
 
   } else {
-    return fdEtaEndcapEH->Eval(x);
+    return fdEtaEndcapEH->eval(x);
   }
 }
 //
@@ -579,22 +509,22 @@ std::ostream& operator<<(std::ostream& out, const PFEnergyCalibration& calib) {
     }
 
   } else {
-    std::cout << "Default calibration functions : " << std::endl;
-
-    calib.faBarrel->Print();
-    calib.fbBarrel->Print();
-    calib.fcBarrel->Print();
-    calib.faEtaBarrelEH->Print();
-    calib.fbEtaBarrelEH->Print();
-    calib.faEtaBarrelH->Print();
-    calib.fbEtaBarrelH->Print();
-    calib.faEndcap->Print();
-    calib.fbEndcap->Print();
-    calib.fcEndcap->Print();
-    calib.faEtaEndcapEH->Print();
-    calib.fbEtaEndcapEH->Print();
-    calib.faEtaEndcapH->Print();
-    calib.fbEtaEndcapH->Print();
+    out << "Default calibration functions : " << std::endl;
+
+    calib.faBarrel->print(out);
+    calib.fbBarrel->print(out);
+    calib.fcBarrel->print(out);
+    calib.faEtaBarrelEH->print(out);
+    calib.fbEtaBarrelEH->print(out);
+    calib.faEtaBarrelH->print(out);
+    calib.fbEtaBarrelH->print(out);
+    calib.faEndcap->print(out);
+    calib.fbEndcap->print(out);
+    calib.fcEndcap->print(out);
+    calib.faEtaEndcapEH->print(out);
+    calib.fbEtaEndcapEH->print(out);
+    calib.faEtaEndcapH->print(out);
+    calib.fbEtaEndcapH->print(out);
     //
   }
 
@@ -14,6 +14,7 @@ using RecHitSet = std::set<const reco::PFRecHit *>;
 
 using RecHit2BlockEltMap = std::map<const reco::PFRecHit *, BlockEltSet>;
 using BlockElt2BlockEltMap = std::map<reco::PFBlockElement *, BlockEltSet>;
+using BlockEltPairs = std::vector<std::pair<const reco::PFBlockElement *, const reco::PFBlockElement *>>;
 
 class KDTreeLinkerBase {
 public:
@@ -53,7 +54,7 @@ public:
   virtual void searchLinks() = 0;
 
   // Here, we will store all target/cluster founded links in the PFBlockElement class
-  // of each target in the PFmultilinks field.
+  // of each target in the PFmultilinks field, and in linkCandidates_.
   virtual void updatePFBlockEltWithLinks() = 0;
 
   // Here we free all allocated structures.
@@ -62,12 +63,17 @@ public:
   // This method calls is the good order buildTree(), searchLinks(),
   // updatePFBlockEltWithLinks() and clear()
   inline void process() {
+    linkCandidates_.clear();
     buildTree();
     searchLinks();
     updatePFBlockEltWithLinks();
     clear();
   }
 
+  // The (target, cluster) pairs linked by the last call to process(). Only these
+  // pairs need to be tested by the corresponding BlockElementLinker.
+  const BlockEltPairs &linkCandidates() const { return linkCandidates_; }
+
 protected:
   // target and field
   reco::PFBlockElement::Type _targetType, _fieldType;
@@ -83,6 +89,9 @@ protected:
 
   // Debug boolean. Not used until now.
   bool debug_ = false;
+
+  // Links found by the last search, see linkCandidates().
+  BlockEltPairs linkCandidates_;
 };
 
 #include "FWCore/PluginManager/interface/PluginFactory.h"
@@ -60,6 +60,10 @@ public:
          const edm::ParameterSet& pset);
 
   void setHOTag(bool ho) { useHO_ = ho; }
+
+  /// also process the blocks in a serial loop and throw if the candidates
+  /// differ from the parallel processing (validation only, doubles the cost)
+  void setCheckParallelBlocks(bool check) { checkParallelBlocks_ = check; }
   void setMuonHandle(const edm::Handle<reco::MuonCollection>&);
 
   void setCandConnectorParameters(const edm::ParameterSet& iCfgCandConnector) {
@@ -120,9 +124,13 @@ public:
   friend std::ostream& operator<<(std::ostream& out, const PFAlgo& algo);
 
 private:
-  void egammaFilters(const reco::PFBlockRef& blockref, std::vector<bool>& active, PFEGammaFilters const* pfegamma);
+  void egammaFilters(reco::PFCandidateCollection& pfCandidates,
+                     const reco::PFBlockRef& blockref,
+                     std::vector<bool>& active,
+                     PFEGammaFilters const* pfegamma);
   void conversionAlgo(const edm::OwnVector<reco::PFBlockElement>& elements, std::vector<bool>& active);
-  bool checkAndReconstructSecondaryInteraction(const reco::PFBlockRef& blockref,
+  bool checkAndReconstructSecondaryInteraction(reco::PFCandidateCollection& pfCandidates,
+                                               const reco::PFBlockRef& blockref,
                                                const edm::OwnVector<reco::PFBlockElement>& elements,
                                                bool isActive,
                                                int iElement);
@@ -134,7 +142,8 @@ private:
                          reco::PFBlock::LinkData& linkData,
                          unsigned int iTrack);
   bool checkGoodTrackDeadHcal(const reco::TrackRef& trackRef, bool hasDeadHcal);
-  void elementLoop(const reco::PFBlock& block,
+  void elementLoop(reco::PFCandidateCollection& pfCandidates,
+                   const reco::PFBlock& block,
                    reco::PFBlock::LinkData& linkData,
                    const edm::OwnVector<reco::PFBlockElement>& elements,
                    std::vector<bool>& active,
@@ -147,7 +156,8 @@ private:
                  ElementIndices& inds,
                  std::vector<bool>& deadArea,
                  unsigned int iEle);
-  bool recoTracksNotHCAL(const reco::PFBlock& block,
+  bool recoTracksNotHCAL(reco::PFCandidateCollection& pfCandidates,
+                         const reco::PFBlock& block,
                          reco::PFBlock::LinkData& linkData,
                          const edm::OwnVector<reco::PFBlockElement>& elements,
                          const reco::PFBlockRef& blockref,
@@ -159,19 +169,22 @@ private:
                          reco::TrackRef& trackRef);
 
   //Looks for a HF-associated element in the block and produces a PFCandidate from it with HF_EM and/or HF_HAD calibrations
-  void createCandidateHF(const reco::PFBlock& block,
+  void createCandidateHF(reco::PFCandidateCollection& pfCandidates,
+                         const reco::PFBlock& block,
                          const reco::PFBlockRef& blockref,
                          const edm::OwnVector<reco::PFBlockElement>& elements,
                          ElementIndices& inds);
 
-  void createCandidatesHCAL(const reco::PFBlock& block,
+  void createCandidatesHCAL(reco::PFCandidateCollection& pfCandidates,
+                            const reco::PFBlock& block,
                             reco::PFBlock::LinkData& linkData,
                             const edm::OwnVector<reco::PFBlockElement>& elements,
                             std::vector<bool>& active,
                             const reco::PFBlockRef& blockref,
                             ElementIndices& inds,
                             std::vector<bool>& deadArea);
-  void createCandidatesHCALUnlinked(const reco::PFBlock& block,
+  void createCandidatesHCALUnlinked(reco::PFCandidateCollection& pfCandidates,
+                                    const reco::PFBlock& block,
                                     reco::PFBlock::LinkData& linkData,
                                     const edm::OwnVector<reco::PFBlockElement>& elements,
                                     std::vector<bool>& active,
@@ -179,7 +192,8 @@ private:
                                     ElementIndices& inds,
                                     std::vector<bool>& deadArea);
 
-  void createCandidatesECAL(const reco::PFBlock& block,
+  void createCandidatesECAL(reco::PFCandidateCollection& pfCandidates,
+                            const reco::PFBlock& block,
                             reco::PFBlock::LinkData& linkData,
                             const edm::OwnVector<reco::PFBlockElement>& elements,
                             std::vector<bool>& active,
@@ -187,17 +201,19 @@ private:
                             ElementIndices& inds,
                             std::vector<bool>& deadArea);
 
-  /// process one block. can be reimplemented in more sophisticated
-  /// algorithms
-  void processBlock(const reco::PFBlockRef& blockref,
-                    std::list<reco::PFBlockRef>& hcalBlockRefs,
-                    std::list<reco::PFBlockRef>& ecalBlockRefs,
+  /// process one block, adding the candidates to pfCandidates.
+  /// Blocks are independent: this only reads the shared state of PFAlgo,
+  /// so that several blocks can be processed concurrently.
+  void processBlock(reco::PFCandidateCollection& pfCandidates,
+                    const reco::PFBlockRef& blockref,
                     PFEGammaFilters const* pfegamma);
 
   /// Reconstruct a charged particle from a track
-  /// Returns the index of the newly created candidate in pfCandidates_
+  /// Returns the index of the newly created candidate in pfCandidates
   /// Michalis added a flag here to treat muons inside jets
-  unsigned reconstructTrack(const reco::PFBlockElement& elt, bool allowLoose = false);
+  unsigned reconstructTrack(reco::PFCandidateCollection& pfCandidates,
+                            const reco::PFBlockElement& elt,
+                            bool allowLoose = false);
 
   /// Reconstruct a neutral particle from a cluster.
   /// If chargedEnergy is specified, the neutral
@@ -205,7 +221,8 @@ private:
   /// larger than the chargedEnergy. In this case, the energy of the
   /// neutral particle is cluster energy - chargedEnergy
 
-  unsigned reconstructCluster(const reco::PFCluster& cluster,
+  unsigned reconstructCluster(reco::PFCandidateCollection& pfCandidates,
+                              const reco::PFCluster& cluster,
                               double particleEnergy,
                               bool useDirection = false,
                               double particleX = 0.,
@@ -317,6 +334,8 @@ private:
   reco::Vertex primaryVertex_;
   bool useVertices_ = false;
 
+  bool checkParallelBlocks_ = false;
+
   edm::Handle<reco::MuonCollection> muonHandle_;
 };
 
@@ -35,7 +35,7 @@ class PFBlockAlgo {
 public:
   // the element list should **always** be a list of (smart) pointers
   typedef std::vector<std::unique_ptr<reco::PFBlockElement>> ElementList;
-  //for skipping ranges
+  //for skipping ranges: [first, second) positions of the elements of each type
   typedef std::array<std::pair<unsigned int, unsigned int>, reco::PFBlockElement::kNBETypes> ElementRanges;
 
   PFBlockAlgo();
@@ -58,7 +58,14 @@ public:
   /// sets debug printout flag
   void setDebug(bool debug) { debug_ = debug; }
 
+  /// build the blocks with the algorithm used before the KDTree pre-selection of the
+  /// pairs of elements to test (slow, to validate the blocks against this baseline)
+  void setLegacyFindBlocks(bool legacy) { legacyFindBlocks_ = legacy; }
+
 private:
+  /// baseline algorithm: tests all pairs of elements that are not connected yet
+  reco::PFBlockCollection findBlocksLegacy();
+
   /// compute missing links in the blocks
   /// (the recursive procedure does not build all links)
   void packLinks(reco::PFBlock& block,
@@ -74,6 +81,8 @@ private:
   /// if true, debug printouts activated
   bool debug_;
 
+  bool legacyFindBlocks_ = false;
+
   friend std::ostream& operator<<(std::ostream&, const PFBlockAlgo&);
   bool useHO_;
 
@@ -81,7 +90,6 @@ private:
 
   const std::unordered_map<std::string, reco::PFBlockElement::Type> elementTypes_;
   std::vector<std::unique_ptr<BlockElementLinkerBase>> linkTests_;
-  unsigned int linkTestSquare_[reco::PFBlockElement::kNBETypes][reco::PFBlockElement::kNBETypes];
 
   std::vector<std::unique_ptr<KDTreeLinkerBase>> kdtrees_;
 };
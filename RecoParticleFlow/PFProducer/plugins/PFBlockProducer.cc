@@ -44,6 +44,7 @@ PFBlockProducer::PFBlockProducer(const edm::ParameterSet& iConfig)
     : verbose_{iConfig.getUntrackedParameter<bool>("verbose", false)}, putToken_{produces<reco::PFBlockCollection>()} {
   bool debug_ = iConfig.getUntrackedParameter<bool>("debug", false);
   pfBlockAlgo_.setDebug(debug_);
+  pfBlockAlgo_.setLegacyFindBlocks(iConfig.getUntrackedParameter<bool>("legacyFindBlocks", false));
 
   edm::ConsumesCollector coll = consumesCollector();
   const std::vector<edm::ParameterSet>& importers = iConfig.getParameterSetVector("elementImporters");
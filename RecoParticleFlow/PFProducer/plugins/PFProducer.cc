@@ -239,6 +239,9 @@ PFProducer::PFProducer(const edm::ParameterSet& iConfig)
   pfAlgo_.setHOTag(useHO_);
 
   verbose_ = iConfig.getUntrackedParameter<bool>("verbose", false);
+
+  // validation of the parallel block processing against a serial loop
+  pfAlgo_.setCheckParallelBlocks(iConfig.getUntrackedParameter<bool>("checkParallelBlocks", false));
 }
 
 void PFProducer::beginRun(const edm::Run& run, const edm::EventSetup& es) {
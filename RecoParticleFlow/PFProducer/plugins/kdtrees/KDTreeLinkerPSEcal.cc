@@ -242,6 +242,7 @@ void KDTreeLinkerPSEcal::updatePFBlockEltWithLinks() {
       double clustereta = (*jt)->clusterRef()->positionREP().eta();
 
       multitracks.linkedClusters.push_back(std::make_pair(clusterphi, clustereta));
+      linkCandidates_.emplace_back(it->first, *jt);
     }
 
     it->first->setMultilinks(multitracks);
@@ -222,6 +222,7 @@ void KDTreeLinkerTrackHcal::updatePFBlockEltWithLinks() {
       double trackphi = atHCAL.positionREP().phi();
 
       multitracks.linkedClusters.push_back(std::make_pair(trackphi, tracketa));
+      linkCandidates_.emplace_back(*jt, it->first);
     }
 
     it->first->setMultilinks(multitracks);
@@ -6,6 +6,8 @@ particleFlowBlock = cms.EDProducer(
     verbose = cms.untracked.bool(False),
     # Debug flag
     debug = cms.untracked.bool(False),
+    # Build the blocks testing all pairs of elements, as before the KDTree pre-selection (validation only)
+    legacyFindBlocks = cms.untracked.bool(False),
     
     #define what we are importing into particle flow
     #from the various subdetectors
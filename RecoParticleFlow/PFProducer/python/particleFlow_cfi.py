@@ -19,6 +19,8 @@ particleFlowTmp = cms.EDProducer("PFProducer",
     # Verbose and debug flags
     verbose = cms.untracked.bool(False),
     debug = cms.untracked.bool(False),
+    # Check that the parallel block processing gives the same candidates as a serial loop
+    checkParallelBlocks = cms.untracked.bool(False),
 
     # Use HO clusters in PF hadron reconstruction
     useHO = cms.bool(True),                                 
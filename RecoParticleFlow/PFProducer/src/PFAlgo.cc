@@ -1,4 +1,5 @@
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/Exception.h"
 #include "RecoParticleFlow/PFProducer/interface/PFAlgo.h"
 #include "RecoParticleFlow/PFProducer/interface/PFMuonAlgo.h"
 #include "RecoParticleFlow/PFProducer/interface/PFElectronExtraEqual.h"
@@ -6,12 +7,26 @@
 
 #include "TDecompChol.h"
 
+#include "tbb/parallel_for.h"
+
+#include <algorithm>
+#include <iterator>
 #include <numeric>
 #include <fstream>
 
 using namespace std;
 using namespace reco;
 
+namespace {
+  bool sameCandidate(const reco::PFCandidate& a, const reco::PFCandidate& b) {
+    return a.particleId() == b.particleId() && a.charge() == b.charge() && a.p4() == b.p4() &&
+           a.rawEcalEnergy() == b.rawEcalEnergy() && a.ecalEnergy() == b.ecalEnergy() &&
+           a.rawHcalEnergy() == b.rawHcalEnergy() && a.hcalEnergy() == b.hcalEnergy() &&
+           a.rawHoEnergy() == b.rawHoEnergy() && a.hoEnergy() == b.hoEnergy() &&
+           a.elementsInBlocks() == b.elementsInBlocks();
+  }
+}  // namespace
+
 PFAlgo::PFAlgo(double nSigmaECAL,
                double nSigmaHCAL,
                PFEnergyCalibration& calibration,
@@ -134,10 +149,10 @@ void PFAlgo::reconstructParticles(const reco::PFBlockHandle& blockHandle, PFEGam
       << "start of function PFAlgo::reconstructParticles, blocks.size()=" << blocks.size();
 
   // sort elements in three lists:
-  std::list<reco::PFBlockRef> hcalBlockRefs;
-  std::list<reco::PFBlockRef> ecalBlockRefs;
-  std::list<reco::PFBlockRef> hoBlockRefs;
-  std::list<reco::PFBlockRef> otherBlockRefs;
+  std::vector<reco::PFBlockRef> hcalBlockRefs;
+  std::vector<reco::PFBlockRef> ecalBlockRefs;
+  std::vector<reco::PFBlockRef> hoBlockRefs;
+  std::vector<reco::PFBlockRef> otherBlockRefs;
 
   for (unsigned i = 0; i < blocks.size(); ++i) {
     reco::PFBlockRef blockref = reco::PFBlockRef(blockHandle, i);
@@ -171,29 +186,52 @@ void PFAlgo::reconstructParticles(const reco::PFBlockHandle& blockHandle, PFEGam
       << "# Ecal blocks: " << ecalBlockRefs.size() << ", # Hcal blocks: " << hcalBlockRefs.size()
       << ", # HO blocks: " << hoBlockRefs.size() << ", # Other blocks: " << otherBlockRefs.size();
 
-  // loop on blocks that are not single ecal,
-  // and not single hcal.
-
-  unsigned nblcks = 0;
-  for (auto const& other : otherBlockRefs) {
-    LogTrace("PFAlgo|reconstructParticles") << "processBlock, Block number " << nblcks++;
-    processBlock(other, hcalBlockRefs, ecalBlockRefs, pfegamma);
-  }
-
-  std::list<reco::PFBlockRef> empty;
-
-  unsigned hblcks = 0;
-  // process remaining single hcal blocks
-  for (auto const& hcal : hcalBlockRefs) {
-    LogTrace("PFAlgo|reconstructParticles") << "processBlock, HCAL block number " << hblcks++;
-    processBlock(hcal, empty, empty, pfegamma);
-  }
-
-  unsigned eblcks = 0;
-  // process remaining single ecal blocks
-  for (auto const& ecal : ecalBlockRefs) {
-    LogTrace("PFAlgo|reconstructParticles") << "processBlock, ECAL block number " << eblcks++;
-    processBlock(ecal, empty, empty, pfegamma);
+  // blocks that are not single ecal, and not single hcal,
+  // then the remaining single hcal blocks and single ecal blocks.
+  std::vector<reco::PFBlockRef> orderedBlockRefs;
+  orderedBlockRefs.reserve(otherBlockRefs.size() + hcalBlockRefs.size() + ecalBlockRefs.size());
+  orderedBlockRefs.insert(orderedBlockRefs.end(), otherBlockRefs.begin(), otherBlockRefs.end());
+  orderedBlockRefs.insert(orderedBlockRefs.end(), hcalBlockRefs.begin(), hcalBlockRefs.end());
+  orderedBlockRefs.insert(orderedBlockRefs.end(), ecalBlockRefs.begin(), ecalBlockRefs.end());
+
+  // The blocks are disconnected by construction, so they are processed as
+  // independent tasks. Each task handles a few consecutive blocks and fills
+  // its own candidate buffer; the buffers are concatenated in block order,
+  // which gives the same candidates, in the same order, as a serial loop.
+  constexpr unsigned int blocksPerTask = 16;
+  const unsigned int nBlocks = orderedBlockRefs.size();
+  const unsigned int nTasks = (nBlocks + blocksPerTask - 1) / blocksPerTask;
+  std::vector<reco::PFCandidateCollection> taskCandidates(nTasks);
+  tbb::parallel_for(0u, nTasks, [&](unsigned int iTask) {
+    const unsigned int end = std::min(nBlocks, (iTask + 1) * blocksPerTask);
+    for (unsigned int iBlock = iTask * blocksPerTask; iBlock < end; ++iBlock) {
+      LogTrace("PFAlgo|reconstructParticles") << "processBlock, Block number " << iBlock;
+      processBlock(taskCandidates[iTask], orderedBlockRefs[iBlock], pfegamma);
+    }
+  });
+
+  unsigned int nCandidates = 0;
+  for (auto const& cands : taskCandidates)
+    nCandidates += cands.size();
+  pfCandidates_->reserve(nCandidates);
+  for (auto& cands : taskCandidates)
+    pfCandidates_->insert(
+        pfCandidates_->end(), std::make_move_iterator(cands.begin()), std::make_move_iterator(cands.end()));
+
+  // validation: process the blocks again in a serial loop and require the same candidates
+  if (checkParallelBlocks_) {
+    reco::PFCandidateCollection serialCandidates;
+    for (auto const& blockref : orderedBlockRefs)
+      processBlock(serialCandidates, blockref, pfegamma);
+    if (serialCandidates.size() != pfCandidates_->size())
+      throw cms::Exception("PFAlgo") << "parallel block processing gave " << pfCandidates_->size()
+                                     << " candidates, the serial loop " << serialCandidates.size();
+    for (unsigned int i = 0; i < serialCandidates.size(); ++i) {
+      if (!sameCandidate(serialCandidates[i], (*pfCandidates_)[i]))
+        throw cms::Exception("PFAlgo") << "parallel block processing gave a different candidate " << i << ":\n"
+                                       << (*pfCandidates_)[i] << "\nthe serial loop:\n"
+                                       << serialCandidates[i];
+    }
   }
 
   // Post HF Cleaning
@@ -214,7 +252,8 @@ void PFAlgo::reconstructParticles(const reco::PFBlockHandle& blockHandle, PFEGam
       << "end of function PFAlgo::reconstructParticles, pfCandidates_->size()=" << pfCandidates_->size();
 }
 
-void PFAlgo::egammaFilters(const reco::PFBlockRef& blockref,
+void PFAlgo::egammaFilters(reco::PFCandidateCollection& pfCandidates,
+                           const reco::PFBlockRef& blockref,
                            std::vector<bool>& active,
                            PFEGammaFilters const* pfegamma) {
   // const edm::ValueMap<reco::GsfElectronRef> & myGedElectronValMap(*valueMapGedElectrons_);
@@ -313,7 +352,7 @@ void PFAlgo::egammaFilters(const reco::PFBlockRef& blockref,
 
         LogTrace("PFAlgo|egammaFilters") << "Creating PF electron: pt=" << myPFElectron.pt()
                                          << " eta=" << myPFElectron.eta() << " phi=" << myPFElectron.phi();
-        pfCandidates_->push_back(myPFElectron);
+        pfCandidates.push_back(myPFElectron);
 
       } else {
         LogTrace("PFAlgo|egammaFilters") << "PFAlgo: Electron DISCARDED, NOT SAFE FOR JETMET ";
@@ -348,7 +387,7 @@ void PFAlgo::egammaFilters(const reco::PFBlockRef& blockref,
         }
         LogTrace("PFAlgo|egammaFilters") << "Creating PF photon: pt=" << myPFPhoton.pt() << " eta=" << myPFPhoton.eta()
                                          << " phi=" << myPFPhoton.phi();
-        pfCandidates_->push_back(myPFPhoton);
+        pfCandidates.push_back(myPFPhoton);
 
       }  // end isSafe
     }    // end isGoodPhoton
@@ -385,7 +424,8 @@ void PFAlgo::conversionAlgo(const edm::OwnVector<reco::PFBlockElement>& elements
   LogTrace("PFAlgo|conversionAlgo") << "end of function PFAlgo::conversionAlgo";
 }
 
-bool PFAlgo::recoTracksNotHCAL(const reco::PFBlock& block,
+bool PFAlgo::recoTracksNotHCAL(reco::PFCandidateCollection& pfCandidates,
+                               const reco::PFBlock& block,
                                reco::PFBlock::LinkData& linkData,
                                const edm::OwnVector<reco::PFBlockElement>& elements,
                                const reco::PFBlockRef& blockref,
@@ -486,19 +526,19 @@ bool PFAlgo::recoTracksNotHCAL(const reco::PFBlock& block,
     return true;
   }  //rejectTracks_Step45_ && ...
 
-  tmpi.push_back(reconstructTrack(elements[iTrack]));
+  tmpi.push_back(reconstructTrack(pfCandidates, elements[iTrack]));
 
   kTrack.push_back(iTrack);
   active[iTrack] = false;
 
   // No ECAL cluster either ... continue...
   if (ecalElems.empty()) {
-    (*pfCandidates_)[tmpi[0]].setEcalEnergy(0., 0.);
-    (*pfCandidates_)[tmpi[0]].setHcalEnergy(0., 0.);
-    (*pfCandidates_)[tmpi[0]].setHoEnergy(0., 0.);
-    (*pfCandidates_)[tmpi[0]].setPs1Energy(0);
-    (*pfCandidates_)[tmpi[0]].setPs2Energy(0);
-    (*pfCandidates_)[tmpi[0]].addElementInBlock(blockref, kTrack[0]);
+    pfCandidates[tmpi[0]].setEcalEnergy(0., 0.);
+    pfCandidates[tmpi[0]].setHcalEnergy(0., 0.);
+    pfCandidates[tmpi[0]].setHoEnergy(0., 0.);
+    pfCandidates[tmpi[0]].setPs1Energy(0);
+    pfCandidates[tmpi[0]].setPs2Energy(0);
+    pfCandidates[tmpi[0]].addElementInBlock(blockref, kTrack[0]);
     return true;
   }
 
@@ -509,12 +549,12 @@ bool PFAlgo::recoTracksNotHCAL(const reco::PFBlock& block,
 
   // Set ECAL energy for muons
   if (thisIsAMuon) {
-    (*pfCandidates_)[tmpi[0]].setEcalEnergy(clusterRef->energy(), std::min(clusterRef->energy(), muonECAL_[0]));
-    (*pfCandidates_)[tmpi[0]].setHcalEnergy(0., 0.);
-    (*pfCandidates_)[tmpi[0]].setHoEnergy(0., 0.);
-    (*pfCandidates_)[tmpi[0]].setPs1Energy(0);
-    (*pfCandidates_)[tmpi[0]].setPs2Energy(0);
-    (*pfCandidates_)[tmpi[0]].addElementInBlock(blockref, kTrack[0]);
+    pfCandidates[tmpi[0]].setEcalEnergy(clusterRef->energy(), std::min(clusterRef->energy(), muonECAL_[0]));
+    pfCandidates[tmpi[0]].setHcalEnergy(0., 0.);
+    pfCandidates[tmpi[0]].setHoEnergy(0., 0.);
+    pfCandidates[tmpi[0]].setPs1Energy(0);
+    pfCandidates[tmpi[0]].setPs2Energy(0);
+    pfCandidates[tmpi[0]].addElementInBlock(blockref, kTrack[0]);
   }
 
   double slopeEcal = 1.;
@@ -539,12 +579,12 @@ bool PFAlgo::recoTracksNotHCAL(const reco::PFBlock& block,
       LogTrace("PFAlgo|recoTracksNotHCAL")
           << " the closest track to ECAL " << thisEcal << " is " << sortedTracks.begin()->second
           << " which is not the one being processed. Will skip ECAL linking for this track";
-      (*pfCandidates_)[tmpi[0]].setEcalEnergy(0., 0.);
-      (*pfCandidates_)[tmpi[0]].setHcalEnergy(0., 0.);
-      (*pfCandidates_)[tmpi[0]].setHoEnergy(0., 0.);
-      (*pfCandidates_)[tmpi[0]].setPs1Energy(0);
-      (*pfCandidates_)[tmpi[0]].setPs2Energy(0);
-      (*pfCandidates_)[tmpi[0]].addElementInBlock(blockref, kTrack[0]);
+      pfCandidates[tmpi[0]].setEcalEnergy(0., 0.);
+      pfCandidates[tmpi[0]].setHcalEnergy(0., 0.);
+      pfCandidates[tmpi[0]].setHoEnergy(0., 0.);
+      pfCandidates[tmpi[0]].setPs1Energy(0);
+      pfCandidates[tmpi[0]].setPs2Energy(0);
+      pfCandidates[tmpi[0]].addElementInBlock(blockref, kTrack[0]);
       return true;
     } else {
       LogTrace("PFAlgo|recoTracksNotHCAL")
@@ -622,18 +662,18 @@ bool PFAlgo::recoTracksNotHCAL(const reco::PFBlock& block,
 
     // And create a charged particle candidate !
 
-    tmpi.push_back(reconstructTrack(elements[jTrack]));
+    tmpi.push_back(reconstructTrack(pfCandidates, elements[jTrack]));
 
     kTrack.push_back(jTrack);
     active[jTrack] = false;
 
     if (thatIsAMuon) {
-      (*pfCandidates_)[tmpi.back()].setEcalEnergy(clusterRef->energy(), std::min(clusterRef->energy(), muonECAL_[0]));
-      (*pfCandidates_)[tmpi.back()].setHcalEnergy(0., 0.);
-      (*pfCandidates_)[tmpi.back()].setHoEnergy(0., 0.);
-      (*pfCandidates_)[tmpi.back()].setPs1Energy(0);
-      (*pfCandidates_)[tmpi.back()].setPs2Energy(0);
-      (*pfCandidates_)[tmpi.back()].addElementInBlock(blockref, kTrack.back());
+      pfCandidates[tmpi.back()].setEcalEnergy(clusterRef->energy(), std::min(clusterRef->energy(), muonECAL_[0]));
+      pfCandidates[tmpi.back()].setHcalEnergy(0., 0.);
+      pfCandidates[tmpi.back()].setHoEnergy(0., 0.);
+      pfCandidates[tmpi.back()].setPs1Energy(0);
+      pfCandidates[tmpi.back()].setPs2Energy(0);
+      pfCandidates[tmpi.back()].addElementInBlock(blockref, kTrack.back());
     }
   }
 
@@ -714,8 +754,8 @@ bool PFAlgo::recoTracksNotHCAL(const reco::PFBlock& block,
       std::multimap<double, unsigned> assTracks;
       block.associatedElements(index, linkData, assTracks, reco::PFBlockElement::TRACK, reco::PFBlock::LINKTEST_ALL);
 
-      auto& ecalCand = (*pfCandidates_)[reconstructCluster(
-          *clusterRef, ecalEnergyCalibrated)];  // KH: use the PF ECAL cluster calibrated energy
+      auto& ecalCand = pfCandidates[reconstructCluster(
+          pfCandidates, *clusterRef, ecalEnergyCalibrated)];  // KH: use the PF ECAL cluster calibrated energy
       ecalCand.setEcalEnergy(clusterRef->energy(), ecalEnergyCalibrated);
       ecalCand.setHcalEnergy(0., 0.);
       ecalCand.setHoEnergy(0., 0.);
@@ -740,7 +780,7 @@ bool PFAlgo::recoTracksNotHCAL(const reco::PFBlock& block,
     iEcal = index;
     active[index] = false;
     for (unsigned ic : tmpi)
-      (*pfCandidates_)[ic].addElementInBlock(blockref, iEcal);
+      pfCandidates[ic].addElementInBlock(blockref, iEcal);
 
   }  // Loop ecal elements
 
@@ -790,48 +830,48 @@ bool PFAlgo::recoTracksNotHCAL(const reco::PFBlock& block,
     resol *= trackMomentum;
     if (neutralEnergy > std::max(0.5, nSigmaECAL_ * resol)) {
       neutralEnergy /= slopeEcal;
-      unsigned tmpj = reconstructCluster(*pivotalRef, neutralEnergy);
-      (*pfCandidates_)[tmpj].setEcalEnergy(pivotalRef->energy(), neutralEnergy);
-      (*pfCandidates_)[tmpj].setHcalEnergy(0., 0.);
-      (*pfCandidates_)[tmpj].setHoEnergy(0., 0.);
-      (*pfCandidates_)[tmpj].setPs1Energy(0.);
-      (*pfCandidates_)[tmpj].setPs2Energy(0.);
-      (*pfCandidates_)[tmpj].addElementInBlock(blockref, iEcal);
+      unsigned tmpj = reconstructCluster(pfCandidates, *pivotalRef, neutralEnergy);
+      pfCandidates[tmpj].setEcalEnergy(pivotalRef->energy(), neutralEnergy);
+      pfCandidates[tmpj].setHcalEnergy(0., 0.);
+      pfCandidates[tmpj].setHoEnergy(0., 0.);
+      pfCandidates[tmpj].setPs1Energy(0.);
+      pfCandidates[tmpj].setPs2Energy(0.);
+      pfCandidates[tmpj].addElementInBlock(blockref, iEcal);
       bNeutralProduced = true;
       for (unsigned ic = 0; ic < kTrack.size(); ++ic)
-        (*pfCandidates_)[tmpj].addElementInBlock(blockref, kTrack[ic]);
+        pfCandidates[tmpj].addElementInBlock(blockref, kTrack[ic]);
     }  // End neutral energy
 
     // Set elements in blocks and ECAL energies to all tracks
     for (unsigned ic = 0; ic < tmpi.size(); ++ic) {
       // Skip muons
-      if ((*pfCandidates_)[tmpi[ic]].particleId() == reco::PFCandidate::mu)
+      if (pfCandidates[tmpi[ic]].particleId() == reco::PFCandidate::mu)
         continue;
 
-      double fraction = trackMomentum > 0 ? (*pfCandidates_)[tmpi[ic]].trackRef()->p() / trackMomentum : 0;
+      double fraction = trackMomentum > 0 ? pfCandidates[tmpi[ic]].trackRef()->p() / trackMomentum : 0;
       double ecalCal = bNeutralProduced ? (calibEcal - neutralEnergy * slopeEcal) * fraction : calibEcal * fraction;
       double ecalRaw = totalEcal * fraction;
 
       LogTrace("PFAlgo|recoTracksNotHCAL")
           << "The fraction after photon supression is " << fraction << " calibrated ecal = " << ecalCal;
 
-      (*pfCandidates_)[tmpi[ic]].setEcalEnergy(ecalRaw, ecalCal);
-      (*pfCandidates_)[tmpi[ic]].setHcalEnergy(0., 0.);
-      (*pfCandidates_)[tmpi[ic]].setHoEnergy(0., 0.);
-      (*pfCandidates_)[tmpi[ic]].setPs1Energy(0);
-      (*pfCandidates_)[tmpi[ic]].setPs2Energy(0);
-      (*pfCandidates_)[tmpi[ic]].addElementInBlock(blockref, kTrack[ic]);
+      pfCandidates[tmpi[ic]].setEcalEnergy(ecalRaw, ecalCal);
+      pfCandidates[tmpi[ic]].setHcalEnergy(0., 0.);
+      pfCandidates[tmpi[ic]].setHoEnergy(0., 0.);
+      pfCandidates[tmpi[ic]].setPs1Energy(0);
+      pfCandidates[tmpi[ic]].setPs2Energy(0);
+      pfCandidates[tmpi[ic]].addElementInBlock(blockref, kTrack[ic]);
     }
 
   }  // End connected ECAL
 
   // Fill the element_in_block for tracks that are eventually linked to no ECAL clusters at all.
   for (unsigned ic = 0; ic < tmpi.size(); ++ic) {
-    const PFCandidate& pfc = (*pfCandidates_)[tmpi[ic]];
+    const PFCandidate& pfc = pfCandidates[tmpi[ic]];
     const PFCandidate::ElementsInBlocks& eleInBlocks = pfc.elementsInBlocks();
     if (eleInBlocks.empty()) {
       LogTrace("PFAlgo|recoTracksNotHCAL") << "Single track / Fill element in block! ";
-      (*pfCandidates_)[tmpi[ic]].addElementInBlock(blockref, kTrack[ic]);
+      pfCandidates[tmpi[ic]].addElementInBlock(blockref, kTrack[ic]);
     }
   }
   LogTrace("PFAlgo|recoTracksNotHCAL") << "end of function PFAlgo::recoTracksNotHCAL";
@@ -841,7 +881,8 @@ bool PFAlgo::recoTracksNotHCAL(const reco::PFBlock& block,
 //Check if the track is a primary track of a secondary interaction
 //If that is the case reconstruct a charged hadron only using that
 //track
-bool PFAlgo::checkAndReconstructSecondaryInteraction(const reco::PFBlockRef& blockref,
+bool PFAlgo::checkAndReconstructSecondaryInteraction(reco::PFCandidateCollection& pfCandidates,
+                                                     const reco::PFBlockRef& blockref,
                                                      const edm::OwnVector<reco::PFBlockElement>& elements,
                                                      bool isActive,
                                                      int iElement) {
@@ -852,8 +893,8 @@ bool PFAlgo::checkAndReconstructSecondaryInteraction(const reco::PFBlockRef& blo
     if (isPrimaryTrack) {
       LogTrace("PFAlgo|elementLoop") << "Primary Track reconstructed alone";
 
-      unsigned tmpi = reconstructTrack(elements[iElement]);
-      (*pfCandidates_)[tmpi].addElementInBlock(blockref, iElement);
+      unsigned tmpi = reconstructTrack(pfCandidates, elements[iElement]);
+      pfCandidates[tmpi].addElementInBlock(blockref, iElement);
       ret = false;
     }
   }
@@ -983,7 +1024,8 @@ void PFAlgo::relinkTrackToHcal(const reco::PFBlock& block,
     LogTrace("PFAlgo|elementLoop") << "Track linked back to HCAL due to ECAL sharing with other tracks";
 }
 
-void PFAlgo::elementLoop(const reco::PFBlock& block,
+void PFAlgo::elementLoop(reco::PFCandidateCollection& pfCandidates,
+                         const reco::PFBlock& block,
                          reco::PFBlock::LinkData& linkData,
                          const edm::OwnVector<reco::PFBlockElement>& elements,
                          std::vector<bool>& active,
@@ -1005,7 +1047,7 @@ void PFAlgo::elementLoop(const reco::PFBlock& block,
     }
     LogTrace("PFAlgo|elementLoop") << "ret_decideType=" << ret_decideType << " type=" << type;
 
-    active[iEle] = checkAndReconstructSecondaryInteraction(blockref, elements, active[iEle], iEle);
+    active[iEle] = checkAndReconstructSecondaryInteraction(pfCandidates, blockref, elements, active[iEle], iEle);
 
     if (!active[iEle]) {
       LogTrace("PFAlgo|elementLoop") << "Already used by electrons, muons, conversions";
@@ -1103,8 +1145,17 @@ void PFAlgo::elementLoop(const reco::PFBlock& block,
     // are reconstructed now.
 
     if (hcalElems.empty()) {
-      auto ret_continue = recoTracksNotHCAL(
-          block, linkData, elements, blockref, active, goodTrackDeadHcal, hasDeadHcal, iEle, ecalElems, trackRef);
+      auto ret_continue = recoTracksNotHCAL(pfCandidates,
+                                            block,
+                                            linkData,
+                                            elements,
+                                            blockref,
+                                            active,
+                                            goodTrackDeadHcal,
+                                            hasDeadHcal,
+                                            iEle,
+                                            ecalElems,
+                                            trackRef);
       if (ret_continue) {
         continue;
       }
@@ -1204,7 +1255,8 @@ int PFAlgo::decideType(const edm::OwnVector<reco::PFBlockElement>& elements,
   return 0;
 }
 
-void PFAlgo::createCandidateHF(const reco::PFBlock& block,
+void PFAlgo::createCandidateHF(reco::PFCandidateCollection& pfCandidates,
+                               const reco::PFBlock& block,
                                const reco::PFBlockRef& blockref,
                                const edm::OwnVector<reco::PFBlockElement>& elements,
                                ElementIndices& inds) {
@@ -1228,13 +1280,13 @@ void PFAlgo::createCandidateHF(const reco::PFBlock& block,
           energyHF = thepfEnergyCalibrationHF_.energyEm(
               uncalibratedenergyHF, clusterRef->positionREP().Eta(), clusterRef->positionREP().Phi());
         }
-        tmpi = reconstructCluster(*clusterRef, energyHF);
-        (*pfCandidates_)[tmpi].setEcalEnergy(uncalibratedenergyHF, energyHF);
-        (*pfCandidates_)[tmpi].setHcalEnergy(0., 0.);
-        (*pfCandidates_)[tmpi].setHoEnergy(0., 0.);
-        (*pfCandidates_)[tmpi].setPs1Energy(0.);
-        (*pfCandidates_)[tmpi].setPs2Energy(0.);
-        (*pfCandidates_)[tmpi].addElementInBlock(blockref, inds.hfEmIs[0]);
+        tmpi = reconstructCluster(pfCandidates, *clusterRef, energyHF);
+        pfCandidates[tmpi].setEcalEnergy(uncalibratedenergyHF, energyHF);
+        pfCandidates[tmpi].setHcalEnergy(0., 0.);
+        pfCandidates[tmpi].setHoEnergy(0., 0.);
+        pfCandidates[tmpi].setPs1Energy(0.);
+        pfCandidates[tmpi].setPs2Energy(0.);
+        pfCandidates[tmpi].addElementInBlock(blockref, inds.hfEmIs[0]);
         LogTrace("PFAlgo|createCandidateHF") << "HF EM alone ! " << energyHF;
         break;
       case PFLayer::HF_HAD:
@@ -1245,13 +1297,13 @@ void PFAlgo::createCandidateHF(const reco::PFBlock& block,
           energyHF = thepfEnergyCalibrationHF_.energyHad(
               uncalibratedenergyHF, clusterRef->positionREP().Eta(), clusterRef->positionREP().Phi());
         }
-        tmpi = reconstructCluster(*clusterRef, energyHF);
-        (*pfCandidates_)[tmpi].setHcalEnergy(uncalibratedenergyHF, energyHF);
-        (*pfCandidates_)[tmpi].setEcalEnergy(0., 0.);
-        (*pfCandidates_)[tmpi].setHoEnergy(0., 0.);
-        (*pfCandidates_)[tmpi].setPs1Energy(0.);
-        (*pfCandidates_)[tmpi].setPs2Energy(0.);
-        (*pfCandidates_)[tmpi].addElementInBlock(blockref, inds.hfHadIs[0]);
+        tmpi = reconstructCluster(pfCandidates, *clusterRef, energyHF);
+        pfCandidates[tmpi].setHcalEnergy(uncalibratedenergyHF, energyHF);
+        pfCandidates[tmpi].setEcalEnergy(0., 0.);
+        pfCandidates[tmpi].setHoEnergy(0., 0.);
+        pfCandidates[tmpi].setPs1Energy(0.);
+        pfCandidates[tmpi].setPs2Energy(0.);
+        pfCandidates[tmpi].addElementInBlock(blockref, inds.hfHadIs[0]);
         LogTrace("PFAlgo|createCandidateHF") << "HF Had alone ! " << energyHF;
         break;
       default:
@@ -1283,7 +1335,7 @@ void PFAlgo::createCandidateHF(const reco::PFBlock& block,
       energyHfHad = thepfEnergyCalibrationHF_.energyEmHad(
           0.0, uncalibratedenergyHFHad, c1->positionREP().Eta(), c1->positionREP().Phi());
     }
-    auto& cand = (*pfCandidates_)[reconstructCluster(*chad, energyHfEm + energyHfHad)];
+    auto& cand = pfCandidates[reconstructCluster(pfCandidates, *chad, energyHfEm + energyHfHad)];
     cand.setEcalEnergy(uncalibratedenergyHFEm, energyHfEm);
     cand.setHcalEnergy(uncalibratedenergyHFHad, energyHfHad);
     cand.setHoEnergy(0., 0.);
@@ -1301,7 +1353,8 @@ void PFAlgo::createCandidateHF(const reco::PFBlock& block,
   LogTrace("PFAlgo|createCandidateHF") << "end of function PFAlgo::createCandidateHF";
 }
 
-void PFAlgo::createCandidatesHCAL(const reco::PFBlock& block,
+void PFAlgo::createCandidatesHCAL(reco::PFCandidateCollection& pfCandidates,
+                                  const reco::PFBlock& block,
                                   reco::PFBlock::LinkData& linkData,
                                   const edm::OwnVector<reco::PFBlockElement>& elements,
                                   std::vector<bool>& active,
@@ -1443,10 +1496,10 @@ void PFAlgo::createCandidatesHCAL(const reco::PFBlock& block,
 
         // Create a muon.
 
-        unsigned tmpi = reconstructTrack(elements[iTrack]);
+        unsigned tmpi = reconstructTrack(pfCandidates, elements[iTrack]);
 
-        (*pfCandidates_)[tmpi].addElementInBlock(blockref, iTrack);
-        (*pfCandidates_)[tmpi].addElementInBlock(blockref, iHcal);
+        pfCandidates[tmpi].addElementInBlock(blockref, iTrack);
+        pfCandidates[tmpi].addElementInBlock(blockref, iHcal);
         double muonHcal = std::min(muonHCAL_[0] + muonHCAL_[1], totalHcal);
 
         // if muon is isolated and muon momentum exceeds the calo energy, absorb the calo energy
@@ -1474,7 +1527,7 @@ void PFAlgo::createCandidatesHCAL(const reco::PFBlock& block,
             }
           }
 
-          if ((pfCandidates_->back()).p() > totalCaloEnergy)
+          if ((pfCandidates.back()).p() > totalCaloEnergy)
             letMuonEatCaloEnergy = true;
         }
 
@@ -1485,14 +1538,14 @@ void PFAlgo::createCandidatesHCAL(const reco::PFBlock& block,
         if (!sortedEcals.empty()) {
           iEcal = sortedEcals.begin()->second;
           PFClusterRef eclusterref = elements[iEcal].clusterRef();
-          (*pfCandidates_)[tmpi].addElementInBlock(blockref, iEcal);
+          pfCandidates[tmpi].addElementInBlock(blockref, iEcal);
           muonEcal = std::min(muonECAL_[0] + muonECAL_[1], eclusterref->energy());
           if (letMuonEatCaloEnergy)
             muonEcal = eclusterref->energy();
           // If the muon expected energy accounts for the whole ecal cluster energy, lock the ecal cluster
           if (eclusterref->energy() - muonEcal < 0.2)
             active[iEcal] = false;
-          (*pfCandidates_)[tmpi].setEcalEnergy(eclusterref->energy(), muonEcal);
+          pfCandidates[tmpi].setEcalEnergy(eclusterref->energy(), muonEcal);
         }
         unsigned iHO = 0;
         double muonHO = 0.;
@@ -1500,20 +1553,20 @@ void PFAlgo::createCandidatesHCAL(const reco::PFBlock& block,
           if (!sortedHOs.empty()) {
             iHO = sortedHOs.begin()->second;
             PFClusterRef hoclusterref = elements[iHO].clusterRef();
-            (*pfCandidates_)[tmpi].addElementInBlock(blockref, iHO);
+            pfCandidates[tmpi].addElementInBlock(blockref, iHO);
             muonHO = std::min(muonHO_[0] + muonHO_[1], hoclusterref->energy());
             if (letMuonEatCaloEnergy)
               muonHO = hoclusterref->energy();
             // If the muon expected energy accounts for the whole HO cluster energy, lock the HO cluster
             if (hoclusterref->energy() - muonHO < 0.2)
               active[iHO] = false;
-            (*pfCandidates_)[tmpi].setHcalEnergy(totalHcal, muonHcal);
-            (*pfCandidates_)[tmpi].setHoEnergy(hoclusterref->energy(), muonHO);
+            pfCandidates[tmpi].setHcalEnergy(totalHcal, muonHcal);
+            pfCandidates[tmpi].setHoEnergy(hoclusterref->energy(), muonHO);
           }
         } else {
-          (*pfCandidates_)[tmpi].setHcalEnergy(totalHcal, muonHcal);
+          pfCandidates[tmpi].setHcalEnergy(totalHcal, muonHcal);
         }
-        setHcalDepthInfo((*pfCandidates_)[tmpi], *hclusterref);
+        setHcalDepthInfo(pfCandidates[tmpi], *hclusterref);
 
         if (letMuonEatCaloEnergy) {
           muonHCALEnergy += totalHcal;
@@ -1815,7 +1868,7 @@ void PFAlgo::createCandidatesHCAL(const reco::PFBlock& block,
           block.associatedElements(iTrack, linkData, sortedHOs, reco::PFBlockElement::HO, reco::PFBlock::LINKTEST_ALL);
 
           //Here allow for loose muons!
-          auto& muon = (*pfCandidates_)[reconstructTrack(elements[iTrack], true)];
+          auto& muon = pfCandidates[reconstructTrack(pfCandidates, elements[iTrack], true)];
 
           muon.addElementInBlock(blockref, iTrack);
           muon.addElementInBlock(blockref, iHcal);
@@ -1999,17 +2052,17 @@ void PFAlgo::createCandidatesHCAL(const reco::PFBlock& block,
       reco::TrackRef trackRef = elements[iTrack].trackRef();
       double trackMomentum = trackRef->p();
       double Dp = trackRef->qoverpError() * trackMomentum * trackMomentum;
-      unsigned tmpi = reconstructTrack(elements[iTrack]);
+      unsigned tmpi = reconstructTrack(pfCandidates, elements[iTrack]);
 
-      (*pfCandidates_)[tmpi].addElementInBlock(blockref, iTrack);
-      (*pfCandidates_)[tmpi].addElementInBlock(blockref, iHcal);
-      setHcalDepthInfo((*pfCandidates_)[tmpi], *hclusterref);
+      pfCandidates[tmpi].addElementInBlock(blockref, iTrack);
+      pfCandidates[tmpi].addElementInBlock(blockref, iHcal);
+      setHcalDepthInfo(pfCandidates[tmpi], *hclusterref);
       auto myEcals = associatedEcals.equal_range(iTrack);
       for (auto ii = myEcals.first; ii != myEcals.second; ++ii) {
         unsigned iEcal = ii->second.second;
         if (active[iEcal])
           continue;
-        (*pfCandidates_)[tmpi].addElementInBlock(blockref, iEcal);
+        pfCandidates[tmpi].addElementInBlock(blockref, iEcal);
       }
 
       if (useHO_) {
@@ -2018,14 +2071,14 @@ void PFAlgo::createCandidatesHCAL(const reco::PFBlock& block,
           unsigned iHO = ii->second.second;
           if (active[iHO])
             continue;
-          (*pfCandidates_)[tmpi].addElementInBlock(blockref, iHO);
+          pfCandidates[tmpi].addElementInBlock(blockref, iHO);
         }
       }
 
       if (iTrack == corrTrack) {
         if (corrFact < 0.)
           corrFact = 0.;  // protect against negative scaling
-        (*pfCandidates_)[tmpi].rescaleMomentum(corrFact);
+        pfCandidates[tmpi].rescaleMomentum(corrFact);
         trackMomentum *= corrFact;
       }
       chargedHadronsIndices.push_back(tmpi);
@@ -2108,7 +2161,7 @@ void PFAlgo::createCandidatesHCAL(const reco::PFBlock& block,
             double rescaleFactor = x(i) / hcalP[i];
             if (rescaleFactor < 0.)
               rescaleFactor = 0.;  // protect against negative scaling
-            (*pfCandidates_)[ich].rescaleMomentum(rescaleFactor);
+            pfCandidates[ich].rescaleMomentum(rescaleFactor);
 
             LogTrace("PFAlgo|createCandidatesHCAL")
                 << "\t\t\told p " << hcalP[i] << " new p " << x(i) << " rescale " << rescaleFactor;
@@ -2279,12 +2332,13 @@ void PFAlgo::createCandidatesHCAL(const reco::PFBlock& block,
               << "ALARM = Negative energy for iPivot=" << iPivot << ", " << particleEnergy[iPivot];
 
         const bool useDirection = true;
-        auto& neutral = (*pfCandidates_)[reconstructCluster(*pivotalClusterRef[iPivot],
-                                                            particleEnergy[iPivot],
-                                                            useDirection,
-                                                            particleDirection[iPivot].X(),
-                                                            particleDirection[iPivot].Y(),
-                                                            particleDirection[iPivot].Z())];
+        auto& neutral = pfCandidates[reconstructCluster(pfCandidates,
+                                                        *pivotalClusterRef[iPivot],
+                                                        particleEnergy[iPivot],
+                                                        useDirection,
+                                                        particleDirection[iPivot].X(),
+                                                        particleDirection[iPivot].Y(),
+                                                        particleDirection[iPivot].Z())];
 
         neutral.setEcalEnergy(rawecalEnergy[iPivot], ecalEnergy[iPivot]);
         if (!useHO_) {
@@ -2342,12 +2396,12 @@ void PFAlgo::createCandidatesHCAL(const reco::PFBlock& block,
     // not exactly equal to sum p, this is sum E
     double chargedHadronsTotalEnergy = 0;
     for (unsigned index : chargedHadronsIndices) {
-      reco::PFCandidate& chargedHadron = (*pfCandidates_)[index];
+      reco::PFCandidate& chargedHadron = pfCandidates[index];
       chargedHadronsTotalEnergy += chargedHadron.energy();
     }
 
     for (unsigned index : chargedHadronsIndices) {
-      reco::PFCandidate& chargedHadron = (*pfCandidates_)[index];
+      reco::PFCandidate& chargedHadron = pfCandidates[index];
       float fraction = chargedHadron.energy() / chargedHadronsTotalEnergy;
 
       if (!useHO_) {
@@ -2387,7 +2441,7 @@ void PFAlgo::createCandidatesHCAL(const reco::PFBlock& block,
           sqrt(std::get<1>(ecalSatellite.second).Mag2()) *
           std::get<2>(
               ecalSatellite.second);  // KH: calibrated under the egamma hypothesis (rawEcalClusterEnergy * calibration)
-      auto& cand = (*pfCandidates_)[reconstructCluster(*eclusterref, ecalClusterEnergyCalibrated)];
+      auto& cand = pfCandidates[reconstructCluster(pfCandidates, *eclusterref, ecalClusterEnergyCalibrated)];
       cand.setEcalEnergy(eclusterref->energy(), ecalClusterEnergyCalibrated);
       cand.setHcalEnergy(0., 0.);
       cand.setHoEnergy(0., 0.);
@@ -2410,7 +2464,8 @@ void PFAlgo::createCandidatesHCAL(const reco::PFBlock& block,
   LogTrace("PFAlgo|createCandidatesHCAL") << "end of function PFAlgo::createCandidatesHCAL";
 }
 
-void PFAlgo::createCandidatesHCALUnlinked(const reco::PFBlock& block,
+void PFAlgo::createCandidatesHCALUnlinked(reco::PFCandidateCollection& pfCandidates,
+                                          const reco::PFBlock& block,
                                           reco::PFBlock::LinkData& linkData,
                                           const edm::OwnVector<reco::PFBlockElement>& elements,
                                           std::vector<bool>& active,
@@ -2586,7 +2641,7 @@ void PFAlgo::createCandidatesHCALUnlinked(const reco::PFBlock& block,
           -1., calibEcal, calibHcal, hclusterRef->positionREP().Eta(), hclusterRef->positionREP().Phi());
     }
 
-    auto& cand = (*pfCandidates_)[reconstructCluster(*hclusterRef, calibEcal + calibHcal)];
+    auto& cand = pfCandidates[reconstructCluster(pfCandidates, *hclusterRef, calibEcal + calibHcal)];
 
     cand.setEcalEnergy(totalEcal, calibEcal);
     if (!useHO_) {
@@ -2607,7 +2662,8 @@ void PFAlgo::createCandidatesHCALUnlinked(const reco::PFBlock& block,
   }  //loop hcal elements
 }
 
-void PFAlgo::createCandidatesECAL(const reco::PFBlock& block,
+void PFAlgo::createCandidatesECAL(reco::PFCandidateCollection& pfCandidates,
+                                  const reco::PFBlock& block,
                                   reco::PFBlock::LinkData& linkData,
                                   const edm::OwnVector<reco::PFBlockElement>& elements,
                                   std::vector<bool>& active,
@@ -2641,7 +2697,7 @@ void PFAlgo::createCandidatesECAL(const reco::PFBlock& block,
     // float ecalEnergy = calibration_.energyEm( clusterref->energy() );
     double particleEnergy = ecalEnergy;
 
-    auto& cand = (*pfCandidates_)[reconstructCluster(*clusterref, particleEnergy)];
+    auto& cand = pfCandidates[reconstructCluster(pfCandidates, *clusterref, particleEnergy)];
 
     cand.setEcalEnergy(clusterref->energy(), ecalEnergy);
     cand.setHcalEnergy(0., 0.);
@@ -2654,9 +2710,8 @@ void PFAlgo::createCandidatesECAL(const reco::PFBlock& block,
   LogTrace("PFAlgo|createCandidatesECAL") << "end of function PFALgo::createCandidatesECAL";
 }
 
-void PFAlgo::processBlock(const reco::PFBlockRef& blockref,
-                          std::list<reco::PFBlockRef>& hcalBlockRefs,
-                          std::list<reco::PFBlockRef>& ecalBlockRefs,
+void PFAlgo::processBlock(reco::PFCandidateCollection& pfCandidates,
+                          const reco::PFBlockRef& blockref,
                           PFEGammaFilters const* pfegamma) {
   assert(!blockref.isNull());
   const reco::PFBlock& block = *blockref;
@@ -2678,7 +2733,7 @@ void PFAlgo::processBlock(const reco::PFBlockRef& blockref,
 
   // New EGamma Reconstruction 10/10/2013
   if (useEGammaFilters_) {
-    egammaFilters(blockref, active, pfegamma);
+    egammaFilters(pfCandidates, blockref, active, pfegamma);
   }  // end if use EGammaFilters
 
   //Lock extra conversion tracks not used by Photon Algo
@@ -2712,23 +2767,25 @@ void PFAlgo::processBlock(const reco::PFBlockRef& blockref,
   // vectors to store element indices to ho, hcal and ecal elements, will be filled by elementLoop()
   ElementIndices inds;
 
-  elementLoop(block, linkData, elements, active, blockref, inds, deadArea);
+  elementLoop(pfCandidates, block, linkData, elements, active, blockref, inds, deadArea);
 
   // Reconstruct pfCandidate from HF (either EM-only, Had-only or both)
   if (!(inds.hfEmIs.empty() && inds.hfHadIs.empty())) {
-    createCandidateHF(block, blockref, elements, inds);
+    createCandidateHF(pfCandidates, block, blockref, elements, inds);
   }
 
-  createCandidatesHCAL(block, linkData, elements, active, blockref, inds, deadArea);
+  createCandidatesHCAL(pfCandidates, block, linkData, elements, active, blockref, inds, deadArea);
   // COLINFEB16: now dealing with the HCAL elements that are not linked to any track
-  createCandidatesHCALUnlinked(block, linkData, elements, active, blockref, inds, deadArea);
-  createCandidatesECAL(block, linkData, elements, active, blockref, inds, deadArea);
+  createCandidatesHCALUnlinked(pfCandidates, block, linkData, elements, active, blockref, inds, deadArea);
+  createCandidatesECAL(pfCandidates, block, linkData, elements, active, blockref, inds, deadArea);
 
   LogTrace("PFAlgo|processBlock") << "end of function PFAlgo::processBlock";
 }  // end processBlock
 
 /////////////////////////////////////////////////////////////////////
-unsigned PFAlgo::reconstructTrack(const reco::PFBlockElement& elt, bool allowLoose) {
+unsigned PFAlgo::reconstructTrack(reco::PFCandidateCollection& pfCandidates,
+                                  const reco::PFBlockElement& elt,
+                                  bool allowLoose) {
   const auto* eltTrack = dynamic_cast<const reco::PFBlockElementTrack*>(&elt);
 
   const reco::TrackRef& trackRef = eltTrack->trackRef();
@@ -2754,20 +2811,20 @@ unsigned PFAlgo::reconstructTrack(const reco::PFBlockElement& elt, bool allowLoo
   LogTrace("PFAlgo|reconstructTrack") << "Creating PFCandidate charge=" << charge << ", type=" << particleType
                                       << ", pt=" << momentum.pt() << ", eta=" << momentum.eta()
                                       << ", phi=" << momentum.phi();
-  pfCandidates_->push_back(PFCandidate(charge, momentum, particleType));
+  pfCandidates.push_back(PFCandidate(charge, momentum, particleType));
   //Set vertex and stuff like this
-  pfCandidates_->back().setVertexSource(PFCandidate::kTrkVertex);
-  pfCandidates_->back().setTrackRef(trackRef);
-  pfCandidates_->back().setPositionAtECALEntrance(eltTrack->positionAtECALEntrance());
+  pfCandidates.back().setVertexSource(PFCandidate::kTrkVertex);
+  pfCandidates.back().setTrackRef(trackRef);
+  pfCandidates.back().setPositionAtECALEntrance(eltTrack->positionAtECALEntrance());
   if (muonRef.isNonnull())
-    pfCandidates_->back().setMuonRef(muonRef);
+    pfCandidates.back().setMuonRef(muonRef);
 
   //Set time
   if (elt.isTimeValid())
-    pfCandidates_->back().setTime(elt.time(), elt.timeError());
+    pfCandidates.back().setTime(elt.time(), elt.timeError());
 
   //OK Now try to reconstruct the particle as a muon
-  bool isMuon = pfmu_->reconstructMuon(pfCandidates_->back(), muonRef, allowLoose);
+  bool isMuon = pfmu_->reconstructMuon(pfCandidates.back(), muonRef, allowLoose);
   bool isFromDisp = isFromSecInt(elt, "secondary");
 
   if ((!isMuon) && isFromDisp) {
@@ -2789,25 +2846,26 @@ unsigned PFAlgo::reconstructTrack(const reco::PFBlockElement& elt, bool allowLoo
       LogTrace("PFAlgo|reconstructTrack")
           << "Refitted px = " << px << " py = " << py << " pz = " << pz << " energy = " << energy;
     }
-    pfCandidates_->back().setFlag(reco::PFCandidate::T_FROM_DISP, true);
-    pfCandidates_->back().setDisplacedVertexRef(
+    pfCandidates.back().setFlag(reco::PFCandidate::T_FROM_DISP, true);
+    pfCandidates.back().setDisplacedVertexRef(
         eltTrack->displacedVertexRef(reco::PFBlockElement::T_FROM_DISP)->displacedVertexRef(),
         reco::PFCandidate::T_FROM_DISP);
   }
 
   // do not label as primary a track which would be recognised as a muon. A muon cannot produce NI. It is with high probability a fake
   if (isFromSecInt(elt, "primary") && !isMuon) {
-    pfCandidates_->back().setFlag(reco::PFCandidate::T_TO_DISP, true);
-    pfCandidates_->back().setDisplacedVertexRef(
+    pfCandidates.back().setFlag(reco::PFCandidate::T_TO_DISP, true);
+    pfCandidates.back().setDisplacedVertexRef(
         eltTrack->displacedVertexRef(reco::PFBlockElement::T_TO_DISP)->displacedVertexRef(),
         reco::PFCandidate::T_TO_DISP);
   }
 
   // returns index to the newly created PFCandidate
-  return pfCandidates_->size() - 1;
+  return pfCandidates.size() - 1;
 }
 
-unsigned PFAlgo::reconstructCluster(const reco::PFCluster& cluster,
+unsigned PFAlgo::reconstructCluster(reco::PFCandidateCollection& pfCandidates,
+                                    const reco::PFCluster& cluster,
                                     double particleEnergy,
                                     bool useDirection,
                                     double particleX,
@@ -2897,25 +2955,25 @@ unsigned PFAlgo::reconstructCluster(const reco::PFCluster& cluster,
   // The pf candidate
   LogTrace("PFAlgo|reconstructCluster") << "Creating PFCandidate charge=" << charge << ", type=" << particleType
                                         << ", pt=" << tmp.pt() << ", eta=" << tmp.eta() << ", phi=" << tmp.phi();
-  pfCandidates_->push_back(PFCandidate(charge, tmp, particleType));
+  pfCandidates.push_back(PFCandidate(charge, tmp, particleType));
 
   // The position at ECAL entrance (well: watch out, it is not true
   // for HCAL clusters... to be fixed)
-  pfCandidates_->back().setPositionAtECALEntrance(
+  pfCandidates.back().setPositionAtECALEntrance(
       ::math::XYZPointF(cluster.position().X(), cluster.position().Y(), cluster.position().Z()));
 
   //Set the cnadidate Vertex
-  pfCandidates_->back().setVertex(vertexPos);
+  pfCandidates.back().setVertex(vertexPos);
 
   // depth info
-  setHcalDepthInfo(pfCandidates_->back(), cluster);
+  setHcalDepthInfo(pfCandidates.back(), cluster);
 
   //*TODO* cluster time is not reliable at the moment, so only use track timing
 
-  LogTrace("PFAlgo|reconstructCluster") << "** candidate: " << pfCandidates_->back();
+  LogTrace("PFAlgo|reconstructCluster") << "** candidate: " << pfCandidates.back();
 
   // returns index to the newly created PFCandidate
-  return pfCandidates_->size() - 1;
+  return pfCandidates.size() - 1;
 }
 
 void PFAlgo::setHcalDepthInfo(reco::PFCandidate& cand, const reco::PFCluster& cluster) const {
@@ -3249,7 +3307,7 @@ void PFAlgo::checkCleaning(const reco::PFRecHitCollection& cleanedHits) {
     for (unsigned int hitIdx : hitsToBeAdded) {
       const PFRecHit& hit = cleanedHits[hitIdx];
       PFCluster cluster(hit.layer(), hit.energy(), hit.position().x(), hit.position().y(), hit.position().z());
-      reconstructCluster(cluster, hit.energy());
+      reconstructCluster(*pfCandidates_, cluster, hit.energy());
       LogTrace("PFAlgo|checkCleaning") << pfCandidates_->back() << ". time = " << hit.time();
     }
   }
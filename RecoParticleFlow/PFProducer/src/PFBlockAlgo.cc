@@ -20,6 +20,13 @@ using namespace reco;
   { #name, name }
 
 namespace {
+  // a link between the elements of indices first < second
+  struct ElementLink {
+    unsigned first;
+    unsigned second;
+    double dist;
+  };
+
   class QuickUnion {
     std::vector<unsigned> id_;
     std::vector<unsigned> size_;
@@ -48,6 +55,51 @@ namespace {
 
     bool connected(unsigned p, unsigned q) { return find(p) == find(q); }
 
+    void unite(unsigned p, unsigned q) {
+      unsigned rootP = find(p);
+      unsigned rootQ = find(q);
+
+      if (size_[rootP] < size_[rootQ]) {
+        id_[rootP] = rootQ;
+        size_[rootQ] += size_[rootP];
+      } else {
+        id_[rootQ] = rootP;
+        size_[rootP] += size_[rootQ];
+      }
+      --count_;
+    }
+  };
+
+  // union-find of the baseline algorithm, kept unchanged (including the
+  // reassignment of id_[p]) so that it forms the same blocks in the same order
+  class LegacyQuickUnion {
+    std::vector<unsigned> id_;
+    std::vector<unsigned> size_;
+    int count_;
+
+  public:
+    LegacyQuickUnion(const unsigned NBranches) {
+      count_ = NBranches;
+      id_.resize(NBranches);
+      size_.resize(NBranches);
+      for (unsigned i = 0; i < NBranches; ++i) {
+        id_[i] = i;
+        size_[i] = 1;
+      }
+    }
+
+    int count() const { return count_; }
+
+    unsigned find(unsigned p) {
+      while (p != id_[p]) {
+        id_[p] = id_[id_[p]];
+        p = id_[p];
+      }
+      return p;
+    }
+
+    bool connected(unsigned p, unsigned q) { return find(p) == find(q); }
+
     void unite(unsigned p, unsigned q) {
       unsigned rootP = find(p);
       unsigned rootQ = find(q);
@@ -85,11 +137,6 @@ PFBlockAlgo::PFBlockAlgo()
 
 void PFBlockAlgo::setLinkers(const std::vector<edm::ParameterSet>& confs) {
   constexpr unsigned rowsize = reco::PFBlockElement::kNBETypes;
-  for (unsigned i = 0; i < rowsize; ++i) {
-    for (unsigned j = 0; j < rowsize; ++j) {
-      linkTestSquare_[i][j] = 0;
-    }
-  }
   linkTests_.resize(rowsize * rowsize);
   const std::string prefix("PFBlockElement::");
   const std::string pfx_kdtree("KDTree");
@@ -111,8 +158,6 @@ void PFBlockAlgo::setLinkers(const std::vector<edm::ParameterSet>& confs) {
     const PFBlockElement::Type type2 = elementTypes_.at(link2);
     const unsigned index = rowsize * std::max(type1, type2) + std::min(type1, type2);
     linkTests_[index] = BlockElementLinkerFactory::get()->create(linkerName, conf);
-    linkTestSquare_[type1][type2] = index;
-    linkTestSquare_[type2][type1] = index;
     // setup KDtree if requested
     const bool useKDTree = conf.getParameter<bool>("useKDTree");
     if (useKDTree) {
@@ -139,6 +184,128 @@ PFBlockAlgo::~PFBlockAlgo() {
 }
 
 reco::PFBlockCollection PFBlockAlgo::findBlocks() {
+  if (legacyFindBlocks_)
+    return findBlocksLegacy();
+
+  constexpr unsigned rowsize = reco::PFBlockElement::kNBETypes;
+  // Glowinski & Gouzevitch
+  std::array<const KDTreeLinkerBase*, rowsize * rowsize> kdtreeOfLink{};
+  for (const auto& kdtree : kdtrees_) {
+    kdtree->process();
+    kdtreeOfLink[rowsize * kdtree->fieldType() + kdtree->targetType()] = kdtree.get();
+  }
+  // !Glowinski & Gouzevitch
+
+  const unsigned elem_size = elements_.size();
+
+  // position of each element in elements_, sorted by address, to translate the KDTree results
+  std::vector<std::pair<const PFBlockElement*, unsigned>> elementIndices;
+  if (!kdtrees_.empty()) {
+    elementIndices.reserve(elem_size);
+    for (unsigned i = 0; i < elem_size; ++i)
+      elementIndices.emplace_back(elements_[i].get(), i);
+    std::sort(elementIndices.begin(), elementIndices.end());
+  }
+  auto indexOf = [&elementIndices](const PFBlockElement* elem) {
+    return std::lower_bound(elementIndices.begin(),
+                            elementIndices.end(),
+                            std::make_pair(elem, 0u),
+                            [](const auto& a, const auto& b) { return a.first < b.first; })
+        ->second;
+  };
+
+  // Test each pair of elements at most once: only the element types for which a
+  // linker is defined are combined, and the pairs linked by a KDTree are taken from
+  // its results instead of testing all combinations of the two types.
+  // The linkers without a KDTree (ECAL-HCAL, HCAL-HO, track-HO, GSF-ECAL, HFEM-HFHAD, ...)
+  // are still tested over all the combinations of their two types.
+  auto testPair = [&](unsigned i, unsigned j, const BlockElementLinkerBase& linker, std::vector<ElementLink>& out) {
+    if (i > j)
+      std::swap(i, j);
+    const PFBlockElement* p1 = elements_[i].get();
+    const PFBlockElement* p2 = elements_[j].get();
+    if (linker.linkPrefilter(p1, p2)) {
+      const double dist = linker.testLink(p1, p2);
+      // compute linking info if it is possible
+      if (dist > -0.5)
+        out.push_back({i, j, dist});
+    }
+  };
+  auto testAllPairs = [&](unsigned type1, unsigned type2, std::vector<ElementLink>& out) {
+    const BlockElementLinkerBase& linker = *linkTests_[rowsize * type2 + type1];
+    for (unsigned i = ranges_[type1].first; i < ranges_[type1].second; ++i) {
+      for (unsigned j = (type1 == type2 ? i + 1 : ranges_[type2].first); j < ranges_[type2].second; ++j)
+        testPair(i, j, linker, out);
+    }
+  };
+  auto sortLinks = [](std::vector<ElementLink>& v) {
+    std::sort(v.begin(), v.end(), [](const ElementLink& a, const ElementLink& b) {
+      return a.first < b.first || (a.first == b.first && a.second < b.second);
+    });
+  };
+
+  std::vector<ElementLink> links;
+  for (unsigned type2 = 0; type2 < rowsize; ++type2) {
+    for (unsigned type1 = 0; type1 <= type2; ++type1) {
+      const unsigned index = rowsize * type2 + type1;
+      if (!linkTests_[index])
+        continue;
+      if (kdtreeOfLink[index] != nullptr) {
+        for (const auto& candidate : kdtreeOfLink[index]->linkCandidates())
+          testPair(indexOf(candidate.first), indexOf(candidate.second), *linkTests_[index], links);
+      } else {
+        testAllPairs(type1, type2, links);
+      }
+    }
+  }
+  // the KDTree results are not in a reproducible order
+  sortLinks(links);
+
+  QuickUnion qu(elem_size);
+  for (const auto& link : links) {
+    if (!qu.connected(link.first, link.second))
+      qu.unite(link.first, link.second);
+  }
+
+  // Blocks are ordered by their first element, elements in a block follow the order of elements_,
+  // so the order of the blocks (and of the PFAlgo candidates) does not depend on the union-find roots.
+  reco::PFBlockCollection blocks;
+  blocks.reserve(qu.count());
+  std::vector<unsigned> blockOfRoot(elem_size, elem_size);
+  std::vector<unsigned> blockOf(elem_size);
+  for (unsigned i = 0; i < elem_size; ++i) {
+    const unsigned root = qu.find(i);
+    if (blockOfRoot[root] == elem_size) {
+      blockOfRoot[root] = blocks.size();
+      blocks.emplace_back();
+    }
+    blockOf[i] = blockOfRoot[root];
+    // sets the index of the element in its block
+    blocks[blockOf[i]].addElement(elements_[i].get());
+  }
+
+  for (auto& block : blocks)
+    block.bookLinkData();
+  for (const auto& link : links) {
+    auto& block = blocks[blockOf[link.first]];
+    block.setLink(elements_[link.second]->index(), elements_[link.first]->index(), link.dist, block.linkData());
+  }
+
+  elements_.clear();
+
+  return blocks;
+}
+
+// The algorithm used before the KDTree pre-selection of the pairs to test. The blocks
+// are ordered by their union-find root and, within a block, the elements after the first
+// one follow the order of the unordered_multimap. The blocks should hold the same elements
+// and links as the ones of findBlocks(), in a different order.
+reco::PFBlockCollection PFBlockAlgo::findBlocksLegacy() {
+  constexpr unsigned rowsize = reco::PFBlockElement::kNBETypes;
+  auto linkIndex = [](PFBlockElement::Type type1, PFBlockElement::Type type2) {
+    return rowsize * std::max(type1, type2) + std::min(type1, type2);
+  };
+
   // Glowinski & Gouzevitch
   for (const auto& kdtree : kdtrees_) {
     kdtree->process();
@@ -148,20 +315,19 @@ reco::PFBlockCollection PFBlockAlgo::findBlocks() {
   // the blocks have not been passed to the event, and need to be cleared
   blocks.reserve(elements_.size());
 
-  QuickUnion qu(elements_.size());
+  LegacyQuickUnion qu(elements_.size());
   const auto elem_size = elements_.size();
   for (unsigned i = 0; i < elem_size; ++i) {
     for (unsigned j = 0; j < elem_size; ++j) {
       if (qu.connected(i, j) || j == i)
         continue;
-      if (!linkTests_[linkTestSquare_[elements_[i]->type()][elements_[j]->type()]]) {
-        j = ranges_[elements_[j]->type()].second;
+      if (!linkTests_[linkIndex(elements_[i]->type(), elements_[j]->type())]) {
+        // skip to the last element of this type, ranges_ are [first, second)
+        j = ranges_[elements_[j]->type()].second - 1;
         continue;
       }
       auto p1(elements_[i].get()), p2(elements_[j].get());
-      const PFBlockElement::Type type1 = p1->type();
-      const PFBlockElement::Type type2 = p2->type();
-      const unsigned index = linkTestSquare_[type1][type2];
+      const unsigned index = linkIndex(p1->type(), p2->type());
       if (linkTests_[index]->linkPrefilter(p1, p2)) {
         const double dist = linkTests_[index]->testLink(p1, p2);
         // compute linking info if it is possible
@@ -199,10 +365,8 @@ reco::PFBlockCollection PFBlockAlgo::findBlocks() {
     ++itr;
     for (; itr != range.second; ++itr) {
       ElementList::value_type::pointer p2(elements_[itr->second].get());
-      const PFBlockElement::Type type1 = p1->type();
-      const PFBlockElement::Type type2 = p2->type();
       the_block.addElement(p2);
-      const unsigned index = linkTestSquare_[type1][type2];
+      const unsigned index = linkIndex(p1->type(), p2->type());
       if (nullptr != linkTests_[index]) {
         const double dist = linkTests_[index]->testLink(p1, p2);
         links.emplace(std::make_pair(p1->index(), p2->index()), dist);
@@ -227,15 +391,11 @@ void PFBlockAlgo::packLinks(reco::PFBlock& block,
   //First Loop: update all link data
   for (unsigned i1 = 0; i1 < elsize; ++i1) {
     for (unsigned i2 = 0; i2 < i1; ++i2) {
-      // no reflexive link
-      //if( i1==i2 ) continue;
-
       double dist = -1;
 
       bool linked = false;
 
       // are these elements already linked ?
-      // this can be optimized
       const auto link_itr = links.find(std::make_pair(i2, i1));
       if (link_itr != links.end()) {
         dist = link_itr->second;
@@ -253,8 +413,6 @@ void PFBlockAlgo::packLinks(reco::PFBlock& block,
           link(&els[i1], &els[i2], dist);
       }
 
-      //loading link data according to link test used: RECHIT
-      //block.setLink( i1, i2, chi2, block.linkData() );
       block.setLink(i1, i2, dist, block.linkData());
     }
   }
@@ -294,17 +452,14 @@ void PFBlockAlgo::buildElements(const edm::Event& evt) {
   std::sort(elements_.begin(), elements_.end(), [](const auto& a, const auto& b) { return a->type() < b->type(); });
 
   // list is now partitioned, so mark the boundaries so we can efficiently skip chunks
-  unsigned current_type = (!elements_.empty() ? elements_[0]->type() : 0);
-  unsigned last_type = (!elements_.empty() ? elements_.back()->type() : 0);
-  ranges_[current_type].first = 0;
-  ranges_[last_type].second = elements_.size() - 1;
-  for (size_t i = 0; i < elements_.size(); ++i) {
-    const auto the_type = elements_[i]->type();
-    if (the_type != current_type) {
-      ranges_[the_type].first = i;
-      ranges_[current_type].second = i - 1;
-      current_type = the_type;
-    }
+  // as [first, second) intervals, empty for the types that are not present
+  unsigned begin = 0;
+  for (unsigned type = 0; type < ranges_.size(); ++type) {
+    unsigned end = begin;
+    while (end < elements_.size() && elements_[end]->type() == type)
+      ++end;
+    ranges_[type] = std::make_pair(begin, end);
+    begin = end;
   }
   // -------------- Loop over block elements ---------------------
 
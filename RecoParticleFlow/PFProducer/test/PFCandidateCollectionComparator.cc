@@ -0,0 +1,122 @@
+// -*- C++ -*-
+//
+// Package:     RecoParticleFlow/PFProducer
+// Class  :     PFCandidateCollectionComparator
+//
+// Implementation:
+//     Matches each PFCandidate of a reference collection to a candidate of a test
+//     collection with the same particle type and charge, and the same pt, eta and
+//     phi within the configured tolerances, independently of the order of the two
+//     collections. At the end of the job, throws if the fraction of unmatched
+//     candidates of either collection is above the configured limit.
+//
+
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidate.h"
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidateFwd.h"
+#include "DataFormats/Math/interface/deltaPhi.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/global/EDAnalyzer.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+class PFCandidateCollectionComparator : public edm::global::EDAnalyzer<> {
+public:
+  explicit PFCandidateCollectionComparator(edm::ParameterSet const& iConfig)
+      : referenceToken_{consumes<reco::PFCandidateCollection>(iConfig.getParameter<edm::InputTag>("reference"))},
+        testToken_{consumes<reco::PFCandidateCollection>(iConfig.getParameter<edm::InputTag>("test"))},
+        maxRelDeltaPt_{iConfig.getParameter<double>("maxRelDeltaPt")},
+        maxDeltaEta_{iConfig.getParameter<double>("maxDeltaEta")},
+        maxDeltaPhi_{iConfig.getParameter<double>("maxDeltaPhi")},
+        maxUnmatchedFraction_{iConfig.getParameter<double>("maxUnmatchedFraction")} {}
+
+  void analyze(edm::StreamID, edm::Event const& iEvent, edm::EventSetup const&) const override;
+  void endJob() override;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+    edm::ParameterSetDescription desc;
+    desc.add<edm::InputTag>("reference");
+    desc.add<edm::InputTag>("test");
+    desc.add<double>("maxRelDeltaPt", 1.e-5);
+    desc.add<double>("maxDeltaEta", 1.e-5);
+    desc.add<double>("maxDeltaPhi", 1.e-5);
+    desc.add<double>("maxUnmatchedFraction", 0.)
+        ->setComment("of the reference and of the test candidates, summed over the job");
+    descriptions.addDefault(desc);
+  }
+
+private:
+  bool matches(reco::PFCandidate const& ref, reco::PFCandidate const& tst) const {
+    return ref.particleId() == tst.particleId() and ref.charge() == tst.charge() and
+           std::abs(tst.pt() - ref.pt()) <= maxRelDeltaPt_ * ref.pt() and
+           std::abs(tst.eta() - ref.eta()) <= maxDeltaEta_ and
+           std::abs(reco::deltaPhi(tst.phi(), ref.phi())) <= maxDeltaPhi_;
+  }
+
+  edm::EDGetTokenT<reco::PFCandidateCollection> const referenceToken_;
+  edm::EDGetTokenT<reco::PFCandidateCollection> const testToken_;
+  double const maxRelDeltaPt_;
+  double const maxDeltaEta_;
+  double const maxDeltaPhi_;
+  double const maxUnmatchedFraction_;
+
+  mutable std::atomic<unsigned int> nReference_{0};
+  mutable std::atomic<unsigned int> nTest_{0};
+  mutable std::atomic<unsigned int> nMatched_{0};
+};
+
+void PFCandidateCollectionComparator::analyze(edm::StreamID,
+                                              edm::Event const& iEvent,
+                                              edm::EventSetup const&) const {
+  auto const& reference = iEvent.get(referenceToken_);
+  auto const& test = iEvent.get(testToken_);
+
+  std::vector<bool> used(test.size(), false);
+  unsigned int nMatched = 0;
+  for (auto const& ref : reference) {
+    bool found = false;
+    for (unsigned int i = 0; i < test.size() and not found; ++i) {
+      if (not used[i] and matches(ref, test[i])) {
+        used[i] = true;
+        found = true;
+      }
+    }
+    if (found) {
+      ++nMatched;
+    } else {
+      edm::LogPrint("PFCandidateCollectionComparator")
+          << "event " << iEvent.id() << ": reference candidate not found in the test collection: " << ref;
+    }
+  }
+  for (unsigned int i = 0; i < test.size(); ++i) {
+    if (not used[i])
+      edm::LogPrint("PFCandidateCollectionComparator")
+          << "event " << iEvent.id() << ": test candidate not found in the reference collection: " << test[i];
+  }
+
+  nReference_ += reference.size();
+  nTest_ += test.size();
+  nMatched_ += nMatched;
+}
+
+void PFCandidateCollectionComparator::endJob() {
+  if (nReference_ == 0) {
+    throw cms::Exception("PFCandidateMismatch") << "no reference candidate to compare";
+  }
+  double const unmatchedFraction = double(nReference_ + nTest_ - 2 * nMatched_) / (nReference_ + nTest_);
+  edm::LogPrint("PFCandidateCollectionComparator") << nReference_ << " reference candidates, " << nTest_
+                                                   << " test candidates, " << nMatched_ << " matched";
+  if (unmatchedFraction > maxUnmatchedFraction_) {
+    throw cms::Exception("PFCandidateMismatch") << "unmatched fraction " << unmatchedFraction << " (maximum "
+                                                << maxUnmatchedFraction_ << ")";
+  }
+}
+
+DEFINE_FWK_MODULE(PFCandidateCollectionComparator);
@@ -0,0 +1,40 @@
+import FWCore.ParameterSet.Config as cms
+from Configuration.Eras.Era_Run2_2018_cff import Run2_2018
+
+# Builds the PF blocks of the events of pfBlockTestTTbar.root with the KDTree
+# pre-selection of the pairs of elements to test and with the baseline algorithm
+# testing all pairs, runs the PF algorithm on both, and checks that the same
+# PFCandidates are found (the order of the blocks, hence of the candidates, differs)
+
+process = cms.Process("PFBLOCKTEST", Run2_2018)
+
+process.load("Configuration.StandardSequences.Services_cff")
+process.load("Configuration.StandardSequences.GeometryRecoDB_cff")
+process.load("Configuration.StandardSequences.MagneticField_cff")
+process.load("Configuration.StandardSequences.Reconstruction_cff")
+process.load("Configuration.StandardSequences.FrontierConditions_GlobalTag_cff")
+from Configuration.AlCa.GlobalTag import GlobalTag
+process.GlobalTag = GlobalTag(process.GlobalTag, "auto:phase1_2018_realistic", "")
+
+process.source = cms.Source("PoolSource",
+    fileNames = cms.untracked.vstring("file:pfBlockTestTTbar.root")
+)
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(-1))
+
+# each producer has its own importers and KDTrees
+process.pfBlocksKDTree = process.particleFlowBlock.clone()
+process.pfBlocksLegacy = process.particleFlowBlock.clone(legacyFindBlocks = True)
+
+process.pfCandidatesKDTree = process.particleFlowTmp.clone(blocks = "pfBlocksKDTree")
+process.pfCandidatesLegacy = process.particleFlowTmp.clone(blocks = "pfBlocksLegacy")
+
+process.comparePFCandidates = cms.EDAnalyzer("PFCandidateCollectionComparator",
+    reference = cms.InputTag("pfCandidatesLegacy"),
+    test = cms.InputTag("pfCandidatesKDTree")
+)
+
+process.p = cms.Path(process.pfBlocksKDTree +
+                     process.pfBlocksLegacy +
+                     process.pfCandidatesKDTree +
+                     process.pfCandidatesLegacy +
+                     process.comparePFCandidates)
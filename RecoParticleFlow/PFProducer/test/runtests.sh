@@ -0,0 +1,8 @@
+#!/bin/bash -ex
+
+function die { echo $1: status $2 ;  exit $2; }
+
+# keep everything, the test rebuilds the blocks and the PFCandidates from the RECO inputs
+cmsDriver.py TTbar_13TeV_TuneCUETP8M1_cfi --conditions auto:phase1_2018_realistic --era Run2_2018 -n 10 --eventcontent FEVTDEBUG -s GEN,SIM,DIGI,L1,DIGI2RAW,RAW2DIGI,L1Reco,RECO --beamspot Realistic25ns13TeVEarly2018Collision --geometry DB:Extended --fileout pfBlockTestTTbar.root --no_exec --python_filename pfBlockTestTTbar_cfg.py --customise_commands "process.FEVTDEBUGoutput.outputCommands = cms.untracked.vstring('keep *')" || die 'Failure running cmsDriver' $?
+cmsRun pfBlockTestTTbar_cfg.py || die 'Failure using pfBlockTestTTbar_cfg.py' $?
+cmsRun ${LOCAL_TEST_DIR}/legacyFindBlocks_cfg.py || die 'Failure using legacyFindBlocks_cfg.py' $?
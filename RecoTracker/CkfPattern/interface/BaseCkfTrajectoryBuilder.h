@@ -95,6 +95,9 @@ public:
 
   virtual void setDebugger(CkfDebugger* dbg) const { ; }
 
+  /** True if trajectories can be built from several seeds at the same time. */
+  virtual bool canBuildConcurrently() const { return false; }
+
   /** Maximum number of lost hits per trajectory candidate. */
   //  int 		maxLostHit()		{return theMaxLostHit;}
 
@@ -69,6 +69,9 @@ namespace cms {
     std::unique_ptr<RedundantSeedCleaner> theSeedCleaner;
 
     unsigned int maxSeedsBeforeCleaning_;
+    // number of seeds built concurrently before their seed cleaning, 0 to build one seed at a time;
+    // only used if the trajectory builder can build several seeds at the same time
+    unsigned int seedsPerParallelChunk_;
 
     edm::EDGetTokenT<edm::View<TrajectorySeed> > theSeedLabel;
     edm::EDGetTokenT<MeasurementTrackerEvent> theMTELabel;
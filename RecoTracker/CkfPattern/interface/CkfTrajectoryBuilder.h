@@ -56,6 +56,9 @@ public:
                            const TrajectorySeed&,
                            TrajectoryContainer& result) const override {}
 
+  /// the trajectories cached for the shared seed check are shared between seeds
+  bool canBuildConcurrently() const override { return !theSharedSeedCheck; }
+
   /// set Event for the internal MeasurementTracker data member
   //  virtual void setEvent(const edm::Event& event) const;
 
@@ -62,6 +62,9 @@ public:
                            const TrajectorySeed&,
                            TrajectoryContainer& result) const override;
 
+  /// all the state of the building of a seed is local
+  bool canBuildConcurrently() const override { return true; }
+
   // Access to lower level components
   const TrajectoryStateUpdator& updator() const { return *theUpdator; }
   const Chi2MeasurementEstimatorBase& estimator() const { return *theEstimator; }
@@ -7,6 +7,7 @@ ckfTrajectories = cms.EDProducer("CkfTrajectoryMaker",
     # these two needed by HLT
     cleanTrajectoryAfterInOut = cms.bool( False ),
     maxNSeeds = cms.uint32( 100000 ),
+    seedsPerParallelChunk = cms.uint32( 0 ),
     # set it as "none" to avoid redundant seed cleaner
     RedundantSeedCleaner = cms.string('CachingSeedCleanerBySharedInput'),
     TrajectoryCleaner = cms.string('TrajectoryCleanerBySharedHits'),
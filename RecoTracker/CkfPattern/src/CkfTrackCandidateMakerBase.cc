@@ -37,12 +37,9 @@
 
 // #define VI_SORTSEED
 // #define VI_REPRODUCIBLE
-// #define VI_TBB
 
-#include <thread>
-#ifdef VI_TBB
+#include "tbb/blocked_range.h"
 #include "tbb/parallel_for.h"
-#endif
 
 #include "RecoTracker/CkfPattern/interface/PrintoutHelper.h"
 
@@ -77,6 +74,7 @@ namespace cms {
         theNavigationSchoolName(conf.getParameter<std::string>("NavigationSchool")),
         theNavigationSchool(nullptr),
         maxSeedsBeforeCleaning_(0),
+        seedsPerParallelChunk_(conf.getParameter<unsigned int>("seedsPerParallelChunk")),
         theMTELabel(iC.consumes<MeasurementTrackerEvent>(conf.getParameter<edm::InputTag>("MeasurementTrackerEvent"))),
         skipClusters_(false),
         phase2skipClusters_(false) {
@@ -221,10 +219,6 @@ namespace cms {
       // method for debugging
       countSeedsDebugger();
 
-      // the mutex
-      std::mutex theMutex;
-      using Lock = std::unique_lock<std::mutex>;
-
       // Loop over seeds
       size_t collseed_size = collseed->size();
 
@@ -263,39 +257,31 @@ namespace cms {
       // std::cout << spt(indeces[0]) << ' ' << spt(indeces[collseed_size-1]) << std::endl;
 #endif
 
-      std::atomic<unsigned int> ntseed(0);
-      auto theLoop = [&](size_t ii) {
-        auto j = indeces[ii];
+      unsigned int ntseed = 0;
 
-        ntseed++;
+      // what building from one seed gave, before seed cleaning
+      struct SeedResult {
+        std::vector<Trajectory> trajectories;
+        unsigned int nCandPerSeed = 0;
+        SeedStopReason stopReason = SeedStopReason::NOT_STOPPED;
+        bool cleaned = false;
+      };
 
-        // to be moved inside a par section (how with tbb??)
-        std::vector<Trajectory> theTmpTrajectories;
+      // Check if seed hits already used by another track
+      auto seedIsClean = [&](unsigned int j) { return !theSeedCleaner || theSeedCleaner->good(&((*collseed)[j])); };
 
-        LogDebug("CkfPattern") << "======== Begin to look for trajectories from seed " << j << " ========\n";
+      // Does not touch any state shared between seeds, so it can run concurrently for several seeds
+      auto buildFromSeed = [&](unsigned int j, SeedResult& result) {
+        auto& theTmpTrajectories = result.trajectories;
 
-        {
-          Lock lock(theMutex);
-          // Check if seed hits already used by another track
-          if (theSeedCleaner && !theSeedCleaner->good(&((*collseed)[j]))) {
-            LogDebug("CkfTrackCandidateMakerBase") << " Seed cleaning kills seed " << j;
-            (*outputSeedStopInfos)[j].setStopReason(SeedStopReason::SEED_CLEANING);
-            return;  // from the lambda!
-          }
-        }
+        LogDebug("CkfPattern") << "======== Begin to look for trajectories from seed " << j << " ========\n";
 
         // Build trajectory from seed outwards
-        theTmpTrajectories.clear();
-        unsigned int nCandPerSeed = 0;
         auto const& startTraj =
-            theTrajectoryBuilder->buildTrajectories((*collseed)[j], theTmpTrajectories, nCandPerSeed, nullptr);
-        {
-          Lock lock(theMutex);
-          (*outputSeedStopInfos)[j].setCandidatesPerSeed(nCandPerSeed);
-          if (theTmpTrajectories.empty()) {
-            (*outputSeedStopInfos)[j].setStopReason(SeedStopReason::NO_TRAJECTORY);
-            return;  // from the lambda!
-          }
+            theTrajectoryBuilder->buildTrajectories((*collseed)[j], theTmpTrajectories, result.nCandPerSeed, nullptr);
+        if (theTmpTrajectories.empty()) {
+          result.stopReason = SeedStopReason::NO_TRAJECTORY;
+          return;
         }
 
         LogDebug("CkfPattern") << "======== In-out trajectory building found " << theTmpTrajectories.size()
@@ -321,8 +307,7 @@ namespace cms {
                                  << " valid/invalid trajectories from seed " << j << " ========\n"
                                  << PrintoutHelper::dumpCandidates(theTmpTrajectories);
           if (theTmpTrajectories.empty()) {
-            Lock lock(theMutex);
-            (*outputSeedStopInfos)[j].setStopReason(SeedStopReason::SEED_REGION_REBUILD);
+            result.stopReason = SeedStopReason::SEED_REGION_REBUILD;
             return;
           }
         }
@@ -333,51 +318,78 @@ namespace cms {
         LogDebug("CkfPattern") << "======== Trajectory cleaning gave the following " << theTmpTrajectories.size()
                                << " valid trajectories from seed " << j << " ========\n"
                                << PrintoutHelper::dumpCandidates(theTmpTrajectories);
+      };
 
-        {
-          Lock lock(theMutex);
-          for (vector<Trajectory>::iterator it = theTmpTrajectories.begin(); it != theTmpTrajectories.end(); it++) {
-            if (it->isValid()) {
-              it->setSeedRef(collseed->refAt(j));
-              (*outputSeedStopInfos)[j].setStopReason(SeedStopReason::NOT_STOPPED);
-              // Store trajectory
-              rawResult.push_back(std::move(*it));
-              // Tell seed cleaner which hits this trajectory used.
-              //TO BE FIXED: this cut should be configurable via cfi file
-              if (theSeedCleaner && rawResult.back().foundHits() > 3)
-                theSeedCleaner->add(&rawResult.back());
-              //if (theSeedCleaner ) theSeedCleaner->add( & (*it) );
-            }
-          }
+      // Seed cleaning and storing of the trajectories, must be called in seed order.
+      // recheck: trajectories may have been given to the seed cleaner since result.cleaned was set
+      auto storeSeedResult = [&](unsigned int j, SeedResult& result, bool recheck) {
+        ntseed++;
+        if (result.cleaned || (recheck && !seedIsClean(j))) {
+          LogDebug("CkfTrackCandidateMakerBase") << " Seed cleaning kills seed " << j;
+          (*outputSeedStopInfos)[j].setStopReason(SeedStopReason::SEED_CLEANING);
+          return;
         }
 
-        theTmpTrajectories.clear();
+        (*outputSeedStopInfos)[j].setCandidatesPerSeed(result.nCandPerSeed);
+        if (result.stopReason != SeedStopReason::NOT_STOPPED) {
+          (*outputSeedStopInfos)[j].setStopReason(result.stopReason);
+          return;
+        }
+
+        for (auto& traj : result.trajectories) {
+          if (traj.isValid()) {
+            traj.setSeedRef(collseed->refAt(j));
+            (*outputSeedStopInfos)[j].setStopReason(SeedStopReason::NOT_STOPPED);
+            // Store trajectory
+            rawResult.push_back(std::move(traj));
+            // Tell seed cleaner which hits this trajectory used.
+            //TO BE FIXED: this cut should be configurable via cfi file
+            if (theSeedCleaner && rawResult.back().foundHits() > 3)
+              theSeedCleaner->add(&rawResult.back());
+          }
+        }
 
         LogDebug("CkfPattern") << "rawResult trajectories found so far = " << rawResult.size();
 
-        {
-          Lock lock(theMutex);
-          if (maxSeedsBeforeCleaning_ > 0 && rawResult.size() > maxSeedsBeforeCleaning_ + lastCleanResult) {
-            theTrajectoryCleaner->clean(rawResult);
-            rawResult.erase(
-                std::remove_if(rawResult.begin() + lastCleanResult, rawResult.end(), std::not_fn(&Trajectory::isValid)),
-                rawResult.end());
-            lastCleanResult = rawResult.size();
-          }
+        if (maxSeedsBeforeCleaning_ > 0 && rawResult.size() > maxSeedsBeforeCleaning_ + lastCleanResult) {
+          theTrajectoryCleaner->clean(rawResult);
+          rawResult.erase(
+              std::remove_if(rawResult.begin() + lastCleanResult, rawResult.end(), std::not_fn(&Trajectory::isValid)),
+              rawResult.end());
+          lastCleanResult = rawResult.size();
         }
       };
-      // end of loop over seeds
 
-#ifdef VI_TBB
-      tbb::parallel_for(0UL, collseed_size, 1UL, theLoop);
-#else
-#ifdef VI_OMP
-#pragma omp parallel for schedule(dynamic, 4)
-#endif
-      for (size_t j = 0; j < collseed_size; j++) {
-        theLoop(j);
+      if (seedsPerParallelChunk_ == 0 || !theTrajectoryBuilder->canBuildConcurrently()) {
+        for (size_t ii = 0; ii < collseed_size; ++ii) {
+          auto j = indeces[ii];
+          SeedResult result;
+          result.cleaned = !seedIsClean(j);
+          if (!result.cleaned)
+            buildFromSeed(j, result);
+          storeSeedResult(j, result, false);
+        }
+      } else {
+        // Build the seeds of a chunk concurrently, skipping those already killed by the tracks of the previous
+        // chunks, then do the seed cleaning and store the trajectories serially in seed order.
+        // Each seed then sees the same seed cleaner content as in the serial loop and the output is identical.
+        std::vector<SeedResult> results(std::min<size_t>(seedsPerParallelChunk_, collseed_size));
+        for (size_t begin = 0; begin < collseed_size; begin += seedsPerParallelChunk_) {
+          size_t end = std::min<size_t>(begin + seedsPerParallelChunk_, collseed_size);
+          tbb::parallel_for(tbb::blocked_range<size_t>(begin, end), [&](tbb::blocked_range<size_t> const& range) {
+            for (size_t ii = range.begin(); ii != range.end(); ++ii) {
+              auto j = indeces[ii];
+              auto& result = results[ii - begin];
+              result = SeedResult();
+              result.cleaned = !seedIsClean(j);
+              if (!result.cleaned)
+                buildFromSeed(j, result);
+            }
+          });
+          for (size_t ii = begin; ii != end; ++ii)
+            storeSeedResult(indeces[ii], results[ii - begin], true);
+        }
       }
-#endif
       assert(ntseed == collseed_size);
       if (theSeedCleaner)
         theSeedCleaner->done();
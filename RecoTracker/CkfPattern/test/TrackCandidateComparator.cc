@@ -0,0 +1,81 @@
+// -*- C++ -*-
+//
+// Package:     RecoTracker/CkfPattern
+// Class  :     TrackCandidateComparator
+//
+// Implementation:
+//     Throws if two TrackCandidateCollections differ, comparing for each
+//     candidate its seed, its hits and its starting state.
+//
+
+#include "DataFormats/TrackCandidate/interface/TrackCandidateCollection.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/global/EDAnalyzer.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <iterator>
+
+class TrackCandidateComparator : public edm::global::EDAnalyzer<> {
+public:
+  explicit TrackCandidateComparator(edm::ParameterSet const& iConfig)
+      : referenceToken_{consumes<TrackCandidateCollection>(iConfig.getParameter<edm::InputTag>("reference"))},
+        testToken_{consumes<TrackCandidateCollection>(iConfig.getParameter<edm::InputTag>("test"))} {}
+
+  void analyze(edm::StreamID, edm::Event const& iEvent, edm::EventSetup const&) const override;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+    edm::ParameterSetDescription desc;
+    desc.add<edm::InputTag>("reference");
+    desc.add<edm::InputTag>("test");
+    descriptions.addDefault(desc);
+  }
+
+private:
+  edm::EDGetTokenT<TrackCandidateCollection> const referenceToken_;
+  edm::EDGetTokenT<TrackCandidateCollection> const testToken_;
+};
+
+void TrackCandidateComparator::analyze(edm::StreamID, edm::Event const& iEvent, edm::EventSetup const&) const {
+  auto const& reference = iEvent.get(referenceToken_);
+  auto const& test = iEvent.get(testToken_);
+
+  if (reference.size() != test.size()) {
+    throw cms::Exception("TrackCandidateMismatch")
+        << "event " << iEvent.id() << ": " << reference.size() << " reference candidates, " << test.size()
+        << " test candidates";
+  }
+  for (unsigned int i = 0; i < reference.size(); ++i) {
+    auto const& ref = reference[i];
+    auto const& tst = test[i];
+    auto const refHits = std::distance(ref.recHits().first, ref.recHits().second);
+    auto const tstHits = std::distance(tst.recHits().first, tst.recHits().second);
+    if (ref.seedRef().key() != tst.seedRef().key() or refHits != tstHits or
+        ref.stopReason() != tst.stopReason() or ref.nLoops() != tst.nLoops()) {
+      throw cms::Exception("TrackCandidateMismatch")
+          << "event " << iEvent.id() << ", candidate " << i << ": seed " << ref.seedRef().key() << " vs "
+          << tst.seedRef().key() << ", " << refHits << " vs " << tstHits << " hits";
+    }
+    auto refHit = ref.recHits().first;
+    auto tstHit = tst.recHits().first;
+    for (; refHit != ref.recHits().second; ++refHit, ++tstHit) {
+      if (refHit->geographicalId() != tstHit->geographicalId() or
+          not refHit->sharesInput(&*tstHit, TrackingRecHit::all)) {
+        throw cms::Exception("TrackCandidateMismatch")
+            << "event " << iEvent.id() << ", candidate " << i << ": different hits on "
+            << refHit->geographicalId().rawId() << " and " << tstHit->geographicalId().rawId();
+      }
+    }
+    auto const& refState = ref.trajectoryStateOnDet();
+    auto const& tstState = tst.trajectoryStateOnDet();
+    if (refState.detId() != tstState.detId() or refState.parameters().vector() != tstState.parameters().vector()) {
+      throw cms::Exception("TrackCandidateMismatch")
+          << "event " << iEvent.id() << ", candidate " << i << ": different starting states";
+    }
+  }
+}
+
+DEFINE_FWK_MODULE(TrackCandidateComparator);
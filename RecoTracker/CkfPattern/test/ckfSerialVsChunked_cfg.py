@@ -0,0 +1,38 @@
+import FWCore.ParameterSet.Config as cms
+from Configuration.Eras.Era_Run2_2018_cff import Run2_2018
+
+# Builds the initial step track candidates of the events of ckfTestTTbar.root
+# twice, one seed at a time and in parallel chunks of seeds, and checks that
+# the two collections are identical
+
+process = cms.Process("CKFTEST", Run2_2018)
+
+process.load("Configuration.StandardSequences.Services_cff")
+process.load("Configuration.StandardSequences.GeometryRecoDB_cff")
+process.load("Configuration.StandardSequences.MagneticField_cff")
+process.load("Configuration.StandardSequences.Reconstruction_cff")
+process.load("Configuration.StandardSequences.FrontierConditions_GlobalTag_cff")
+from Configuration.AlCa.GlobalTag import GlobalTag
+process.GlobalTag = GlobalTag(process.GlobalTag, "auto:phase1_2018_realistic", "")
+
+process.source = cms.Source("PoolSource",
+    fileNames = cms.untracked.vstring("file:ckfTestTTbar.root")
+)
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(-1))
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(4),
+    numberOfStreams = cms.untracked.uint32(1)
+)
+
+process.serialTrackCandidates = process.initialStepTrackCandidates.clone(seedsPerParallelChunk = 0)
+process.chunkedTrackCandidates = process.initialStepTrackCandidates.clone(seedsPerParallelChunk = 8)
+
+process.compareTrackCandidates = cms.EDAnalyzer("TrackCandidateComparator",
+    reference = cms.InputTag("serialTrackCandidates"),
+    test = cms.InputTag("chunkedTrackCandidates")
+)
+
+process.p = cms.Path(process.MeasurementTrackerEvent +
+                     process.serialTrackCandidates +
+                     process.chunkedTrackCandidates +
+                     process.compareTrackCandidates)
@@ -0,0 +1,8 @@
+#!/bin/bash -ex
+
+function die { echo $1: status $2 ;  exit $2; }
+
+# keep everything, including the initial step seeds and the clusters
+cmsDriver.py TTbar_13TeV_TuneCUETP8M1_cfi --conditions auto:phase1_2018_realistic --era Run2_2018 -n 5 --eventcontent FEVTDEBUG -s GEN,SIM,DIGI,L1,DIGI2RAW,RAW2DIGI,L1Reco,RECO --beamspot Realistic25ns13TeVEarly2018Collision --geometry DB:Extended --fileout ckfTestTTbar.root --no_exec --python_filename ckfTestTTbar_cfg.py --customise_commands "process.FEVTDEBUGoutput.outputCommands = cms.untracked.vstring('keep *')" || die 'Failure running cmsDriver' $?
+cmsRun ckfTestTTbar_cfg.py || die 'Failure using ckfTestTTbar_cfg.py' $?
+cmsRun ${LOCAL_TEST_DIR}/ckfSerialVsChunked_cfg.py || die 'Failure using ckfSerialVsChunked_cfg.py' $?
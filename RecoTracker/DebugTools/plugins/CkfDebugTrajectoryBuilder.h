@@ -16,6 +16,9 @@ public:
   void setDebugger(CkfDebugger* dbg) const override { theDbg = dbg; }
   virtual CkfDebugger* debugger() const { return theDbg; }
 
+  // the debugger is shared between seeds
+  bool canBuildConcurrently() const override { return false; }
+
 private:
   mutable CkfDebugger* theDbg;
   bool analyzeMeasurementsDebugger(TempTrajectory& traj,
@@ -4,6 +4,9 @@
 #include "FWCore/Framework/interface/MakerMacros.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 
+#include "DataFormats/Common/interface/ContainerMask.h"
+#include "DataFormats/SiPixelCluster/interface/SiPixelCluster.h"
+#include "DataFormats/SiStripCluster/interface/SiStripCluster.h"
 #include "DataFormats/SiStripCluster/interface/SiStripClusterTools.h"
 #include "DataFormats/TrajectorySeed/interface/TrajectorySeed.h"
 #include "DataFormats/TrackerRecHit2D/interface/SiPixelRecHitCollection.h"
@@ -49,7 +52,14 @@ private:
                    int& totalHits,
                    const TrackerTopology& ttopo,
                    const TransientTrackingRecHitBuilder& ttrhBuilder,
-                   const mkfit::LayerNumberConverter& lnc) const;
+                   const mkfit::LayerNumberConverter& lnc,
+                   const std::vector<bool>& clustersToSkip,
+                   const edm::ProductID& clustersToSkipID) const;
+
+  template <typename Cluster>
+  edm::ProductID fillClustersToSkip(const edm::Event& iEvent,
+                                    const edm::EDGetTokenT<edm::ContainerMask<edmNew::DetSetVector<Cluster>>>& token,
+                                    std::vector<bool>& clustersToSkip) const;
 
   bool passCCC(const SiStripRecHit2D& hit, const DetId hitId) const;
   bool passCCC(const SiPixelRecHit& hit, const DetId hitId) const;
@@ -67,6 +77,8 @@ private:
   edm::EDGetTokenT<SiStripRecHit2DCollection> stripRphiRecHitToken_;
   edm::EDGetTokenT<SiStripRecHit2DCollection> stripStereoRecHitToken_;
   edm::EDGetTokenT<edm::View<TrajectorySeed>> seedToken_;
+  edm::EDGetTokenT<edm::ContainerMask<edmNew::DetSetVector<SiPixelCluster>>> pixelClusterMaskToken_;
+  edm::EDGetTokenT<edm::ContainerMask<edmNew::DetSetVector<SiStripCluster>>> stripClusterMaskToken_;
   edm::ESGetToken<TransientTrackingRecHitBuilder, TransientRecHitRecord> ttrhBuilderToken_;
   edm::ESGetToken<TrackerTopology, TrackerTopologyRcd> ttopoToken_;
   edm::ESGetToken<MagneticField, IdealMagneticFieldRecord> mfToken_;
@@ -87,7 +99,16 @@ MkFitInputConverter::MkFitInputConverter(edm::ParameterSet const& iConfig)
       mfToken_{esConsumes<MagneticField, IdealMagneticFieldRecord>()},
       putToken_{produces<MkFitInputWrapper>()},
       minGoodStripCharge_{static_cast<float>(
-          iConfig.getParameter<edm::ParameterSet>("minGoodStripCharge").getParameter<double>("value"))} {}
+          iConfig.getParameter<edm::ParameterSet>("minGoodStripCharge").getParameter<double>("value"))} {
+  const auto pixelSkip = iConfig.getParameter<edm::InputTag>("pixelClustersToSkip");
+  if (not pixelSkip.label().empty()) {
+    pixelClusterMaskToken_ = consumes<edm::ContainerMask<edmNew::DetSetVector<SiPixelCluster>>>(pixelSkip);
+  }
+  const auto stripSkip = iConfig.getParameter<edm::InputTag>("stripClustersToSkip");
+  if (not stripSkip.label().empty()) {
+    stripClusterMaskToken_ = consumes<edm::ContainerMask<edmNew::DetSetVector<SiStripCluster>>>(stripSkip);
+  }
+}
 
 void MkFitInputConverter::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
   edm::ParameterSetDescription desc;
@@ -96,6 +117,10 @@ void MkFitInputConverter::fillDescriptions(edm::ConfigurationDescriptions& descr
   desc.add("stripRphiRecHits", edm::InputTag{"siStripMatchedRecHits", "rphiRecHit"});
   desc.add("stripStereoRecHits", edm::InputTag{"siStripMatchedRecHits", "stereoRecHit"});
   desc.add("seeds", edm::InputTag{"initialStepSeeds"});
+  desc.add("pixelClustersToSkip", edm::InputTag{})
+      ->setComment("Mask of the pixel clusters used by earlier iterations, whose hits are not given to mkFit");
+  desc.add("stripClustersToSkip", edm::InputTag{})
+      ->setComment("Mask of the strip clusters used by earlier iterations, whose hits are not given to mkFit");
   desc.add("ttrhBuilder", edm::ESInputTag{"", "WithTrackAngle"});
 
   edm::ParameterSetDescription descCCC;
@@ -112,13 +137,42 @@ void MkFitInputConverter::produce(edm::StreamID iID, edm::Event& iEvent, const e
   const auto& ttrhBuilder = iSetup.getData(ttrhBuilderToken_);
   const auto& ttopo = iSetup.getData(ttopoToken_);
 
+  std::vector<bool> pixelClustersToSkip;
+  std::vector<bool> stripClustersToSkip;
+  const auto pixelClustersToSkipID = fillClustersToSkip(iEvent, pixelClusterMaskToken_, pixelClustersToSkip);
+  const auto stripClustersToSkipID = fillClustersToSkip(iEvent, stripClusterMaskToken_, stripClustersToSkip);
+
   std::vector<mkfit::HitVec> mkFitHits(lnc.nLayers());
   MkFitHitIndexMap hitIndexMap;
   int totalHits = 0;  // I need to have a global hit index in order to have the hit remapping working?
   // Process strips first for better memory allocation pattern
-  convertHits(iEvent.get(stripRphiRecHitToken_), mkFitHits, hitIndexMap, totalHits, ttopo, ttrhBuilder, lnc);
-  convertHits(iEvent.get(stripStereoRecHitToken_), mkFitHits, hitIndexMap, totalHits, ttopo, ttrhBuilder, lnc);
-  convertHits(iEvent.get(pixelRecHitToken_), mkFitHits, hitIndexMap, totalHits, ttopo, ttrhBuilder, lnc);
+  convertHits(iEvent.get(stripRphiRecHitToken_),
+              mkFitHits,
+              hitIndexMap,
+              totalHits,
+              ttopo,
+              ttrhBuilder,
+              lnc,
+              stripClustersToSkip,
+              stripClustersToSkipID);
+  convertHits(iEvent.get(stripStereoRecHitToken_),
+              mkFitHits,
+              hitIndexMap,
+              totalHits,
+              ttopo,
+              ttrhBuilder,
+              lnc,
+              stripClustersToSkip,
+              stripClustersToSkipID);
+  convertHits(iEvent.get(pixelRecHitToken_),
+              mkFitHits,
+              hitIndexMap,
+              totalHits,
+              ttopo,
+              ttrhBuilder,
+              lnc,
+              pixelClustersToSkip,
+              pixelClustersToSkipID);
 
   // Then import seeds
   auto mkFitSeeds = convertSeeds(iEvent.get(seedToken_), hitIndexMap, ttrhBuilder, iSetup.getData(mfToken_));
@@ -126,6 +180,18 @@ void MkFitInputConverter::produce(edm::StreamID iID, edm::Event& iEvent, const e
   iEvent.emplace(putToken_, std::move(hitIndexMap), std::move(mkFitHits), std::move(mkFitSeeds), std::move(lnc));
 }
 
+template <typename Cluster>
+edm::ProductID MkFitInputConverter::fillClustersToSkip(
+    const edm::Event& iEvent,
+    const edm::EDGetTokenT<edm::ContainerMask<edmNew::DetSetVector<Cluster>>>& token,
+    std::vector<bool>& clustersToSkip) const {
+  if (token.isUninitialized())
+    return edm::ProductID();
+  const auto& mask = iEvent.get(token);
+  mask.copyMaskTo(clustersToSkip);
+  return mask.refProd().id();
+}
+
 bool MkFitInputConverter::passCCC(const SiStripRecHit2D& hit, const DetId hitId) const {
   return (siStripClusterTools::chargePerCM(hitId, hit.firstClusterRef().stripCluster()) > minGoodStripCharge_);
 }
@@ -139,32 +205,53 @@ void MkFitInputConverter::convertHits(const HitCollection& hits,
                                       int& totalHits,
                                       const TrackerTopology& ttopo,
                                       const TransientTrackingRecHitBuilder& ttrhBuilder,
-                                      const mkfit::LayerNumberConverter& lnc) const {
+                                      const mkfit::LayerNumberConverter& lnc,
+                                      const std::vector<bool>& clustersToSkip,
+                                      const edm::ProductID& clustersToSkipID) const {
   if (hits.empty())
     return;
   auto isPlusSide = [&ttopo](const DetId& detid) {
     return ttopo.side(detid) == static_cast<unsigned>(TrackerDetSide::PosEndcap);
   };
 
-  {
-    const DetId detid{hits.ids().back()};
+  // Count the hits of each layer first so that the mkFit hits are
+  // built in place in vectors of the final size, without reallocations
+  std::vector<int> detsetLayers;
+  detsetLayers.reserve(hits.ids().size());
+  std::vector<size_t> hitsPerLayer(mkFitHits.size(), 0);
+  for (const auto& detset : hits) {
+    const DetId detid = detset.detId();
     const auto ilay =
         lnc.convertLayerNumber(detid.subdetId(), ttopo.layer(detid), false, ttopo.isStereo(detid), isPlusSide(detid));
-    // Do initial reserves to minimize further memory allocations
-    const auto& lastClusterRef = hits.data().back().firstClusterRef();
-    hitIndexMap.resizeByClusterIndex(lastClusterRef.id(), lastClusterRef.index());
-    hitIndexMap.increaseLayerSize(ilay, hits.detsetSize(hits.ids().size() - 1));
+    detsetLayers.push_back(ilay);
+    hitsPerLayer[ilay] += detset.size();
+  }
+  const auto& lastClusterRef = hits.data().back().firstClusterRef();
+  hitIndexMap.resizeByClusterIndex(lastClusterRef.id(), lastClusterRef.index());
+  for (size_t ilay = 0; ilay < hitsPerLayer.size(); ++ilay) {
+    if (hitsPerLayer[ilay] == 0)
+      continue;
+    mkFitHits[ilay].reserve(mkFitHits[ilay].size() + hitsPerLayer[ilay]);
+    hitIndexMap.increaseLayerSize(ilay, hitsPerLayer[ilay]);
   }
 
+  auto ilayIt = detsetLayers.begin();
   for (const auto& detset : hits) {
     const DetId detid = detset.detId();
     const auto subdet = detid.subdetId();
-    const auto layer = ttopo.layer(detid);
-    const auto isStereo = ttopo.isStereo(detid);
-    const auto ilay = lnc.convertLayerNumber(subdet, layer, false, isStereo, isPlusSide(detid));
-    hitIndexMap.increaseLayerSize(ilay, detset.size());  // to minimize memory allocations
+    const auto ilay = *(ilayIt++);
 
     for (const auto& hit : detset) {
+      const auto& clusterRef = hit.firstClusterRef();
+      // the mask indices are meaningful only for the clusters the mask was made for
+      if (clustersToSkipID.isValid() and clusterRef.id() != clustersToSkipID) {
+        throw cms::Exception("Configuration")
+            << "The hits on detid " << detid.rawId() << " are built from the clusters of product " << clusterRef.id()
+            << ", but the mask of the clusters to skip refers to product " << clustersToSkipID;
+      }
+      const auto clusterIndex = clusterRef.index();
+      if (clusterIndex < clustersToSkip.size() and clustersToSkip[clusterIndex])
+        continue;
       if (!passCCC(hit, detid))
         continue;
 
@@ -180,11 +267,11 @@ void MkFitInputConverter::convertHits(const HitCollection& hits,
       err.At(1, 2) = gerr.czy();
 
       LogTrace("MkFitInputConverter") << "Adding hit detid " << detid.rawId() << " subdet " << subdet << " layer "
-                                      << layer << " isStereo " << isStereo << " zplus " << isPlusSide(detid) << " ilay "
-                                      << ilay;
+                                      << ttopo.layer(detid) << " isStereo " << ttopo.isStereo(detid) << " zplus "
+                                      << isPlusSide(detid) << " ilay " << ilay;
 
-      hitIndexMap.insert(hit.firstClusterRef().id(),
-                         hit.firstClusterRef().index(),
+      hitIndexMap.insert(clusterRef.id(),
+                         clusterIndex,
                          MkFitHitIndexMap::MkFitHit{static_cast<int>(mkFitHits[ilay].size()), ilay},
                          &hit);
       mkFitHits[ilay].emplace_back(pos, err, totalHits);
@@ -15,6 +15,7 @@
 #include "RecoTracker/MkFit/interface/MkFitOutputWrapper.h"
 
 // mkFit includes
+#include "Config.h"
 #include "ConfigWrapper.h"
 #include "Event.h"
 #include "mkFit/buildtestMPlex.h"
@@ -25,6 +26,82 @@
 
 // std includes
 #include <functional>
+#include <mutex>
+
+namespace {
+  // mkFit reads its configuration from variables global to the process.
+  // The MkFitProducers with the same configuration as the first one
+  // (usually all of them) build concurrently, since the event data and
+  // the builders are per instance and per stream. If some instance has a
+  // different seedCleaning or backwardFitInCMSSW, the building of all
+  // instances is serialized and each one sets its configuration first.
+  class MkFitGlobalConfig {
+  public:
+    struct Options {
+      mkfit::ConfigWrapper::SeedCleaningOpts seedCleaning;
+      bool backwardFitInCMSSW;
+
+      bool operator==(Options const& other) const {
+        return seedCleaning == other.seedCleaning and backwardFitInCMSSW == other.backwardFitInCMSSW;
+      }
+    };
+
+    static MkFitGlobalConfig& instance() {
+      static MkFitGlobalConfig config;
+      return config;
+    }
+
+    // called from the constructors, i.e. before any event is processed
+    void initialize(bool isFV, Options const& options, bool mkFitSilent) {
+      std::lock_guard<std::mutex> guard(mutex_);
+      if (not populated_[isFV]) {
+        mkfit::MkBuilderWrapper::populate(isFV);
+        populated_[isFV] = true;
+      }
+      if (initialized_) {
+        // mkFitSilent of the first instance wins, it affects only the printouts
+        if (not(options == current_)) {
+          serialize_ = true;
+        }
+        return;
+      }
+      mkfit::ConfigWrapper::initializeForCMSSW(options.seedCleaning, backwardFit(options), mkFitSilent);
+      current_ = options;
+      initialized_ = true;
+    }
+
+    template <typename F>
+    void build(Options const& options, F&& buildFunction) {
+      if (not serialize_) {
+        buildFunction();
+        return;
+      }
+      std::lock_guard<std::mutex> guard(mutex_);
+      if (not(options == current_)) {
+        // initializeForCMSSW() only switches the options on, so set them explicitly
+        mkfit::Config::seedCleaning = options.seedCleaning == mkfit::ConfigWrapper::SeedCleaningOpts::cleanSeedsN2
+                                          ? mkfit::cleanSeedsN2
+                                          : mkfit::noCleaning;
+        mkfit::Config::backwardFit = not options.backwardFitInCMSSW;
+        mkfit::Config::backwardSearch = not options.backwardFitInCMSSW;
+        current_ = options;
+      }
+      buildFunction();
+    }
+
+  private:
+    static mkfit::ConfigWrapper::BackwardFit backwardFit(Options const& options) {
+      return options.backwardFitInCMSSW ? mkfit::ConfigWrapper::BackwardFit::noFit
+                                        : mkfit::ConfigWrapper::BackwardFit::toFirstLayer;
+    }
+
+    std::mutex mutex_;
+    bool populated_[2] = {false, false};
+    bool initialized_ = false;
+    bool serialize_ = false;
+    Options current_;
+  };
+}  // namespace
 
 class MkFitProducer : public edm::global::EDProducer<edm::StreamCache<mkfit::MkBuilderWrapper> > {
 public:
@@ -44,6 +121,7 @@ private:
   std::function<double(mkfit::Event&, mkfit::MkBuilder&)> buildFunction_;
   bool backwardFitInCMSSW_;
   bool mkFitSilent_;
+  MkFitGlobalConfig::Options options_;
 };
 
 MkFitProducer::MkFitProducer(edm::ParameterSet const& iConfig)
@@ -79,12 +157,8 @@ MkFitProducer::MkFitProducer(edm::ParameterSet const& iConfig)
         << "Invalida value for parameter 'seedCleaning' " << seedClean << ", allowed are none, N2";
   }
 
-  auto backwardFitOpt =
-      backwardFitInCMSSW_ ? mkfit::ConfigWrapper::BackwardFit::noFit : mkfit::ConfigWrapper::BackwardFit::toFirstLayer;
-
-  // TODO: what to do when we have multiple instances of MkFitProducer in a job?
-  mkfit::MkBuilderWrapper::populate(isFV);
-  mkfit::ConfigWrapper::initializeForCMSSW(seedCleanOpt, backwardFitOpt, mkFitSilent_);
+  options_ = MkFitGlobalConfig::Options{seedCleanOpt, backwardFitInCMSSW_};
+  MkFitGlobalConfig::instance().initialize(isFV, options_, mkFitSilent_);
 }
 
 void MkFitProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
@@ -118,8 +192,8 @@ void MkFitProducer::produce(edm::StreamID iID, edm::Event& iEvent, const edm::Ev
   }
 
   // Initialize the number of layers, has to be done exactly once in
-  // the whole program.
-  // TODO: the mechanism needs to be improved...
+  // the whole program. It is the same for all instances since the
+  // tracker geometry is checked above.
   std::call_once(geometryFlag, [nlayers = hitsSeeds.nlayers()]() { mkfit::ConfigWrapper::setNTotalLayers(nlayers); });
 
   // CMSSW event ID (64-bit unsigned) does not fit in int
@@ -129,7 +203,9 @@ void MkFitProducer::produce(edm::StreamID iID, edm::Event& iEvent, const edm::Ev
 
   ev.setInputFromCMSSW(hitsSeeds.hits(), hitsSeeds.seeds());
 
-  tbb::this_task_arena::isolate([&]() { buildFunction_(ev, streamCache(iID)->get()); });
+  MkFitGlobalConfig::instance().build(options_, [&]() {
+    tbb::this_task_arena::isolate([&]() { buildFunction_(ev, streamCache(iID)->get()); });
+  });
 
   iEvent.emplace(putToken_, std::move(ev.candidateTracks_), std::move(ev.fitTracks_));
 }
@@ -0,0 +1,109 @@
+// -*- C++ -*-
+//
+// Package:     RecoTracker/MkFit
+// Class  :     TrackCandidateClusterMaskChecker
+//
+// Implementation:
+//     Throws if a track candidate has a hit on a cluster masked by the given
+//     pixel and strip cluster masks, or if no candidate was found in the job.
+//
+
+#include "DataFormats/Common/interface/ContainerMask.h"
+#include "DataFormats/Common/interface/DetSetVectorNew.h"
+#include "DataFormats/SiPixelCluster/interface/SiPixelCluster.h"
+#include "DataFormats/SiStripCluster/interface/SiStripCluster.h"
+#include "DataFormats/TrackCandidate/interface/TrackCandidateCollection.h"
+#include "DataFormats/TrackerRecHit2D/interface/BaseTrackerRecHit.h"
+#include "DataFormats/TrackerRecHit2D/interface/SiStripMatchedRecHit2D.h"
+#include "DataFormats/TrackerRecHit2D/interface/trackerHitRTTI.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/global/EDAnalyzer.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <atomic>
+
+class TrackCandidateClusterMaskChecker : public edm::global::EDAnalyzer<> {
+public:
+  using PixelMask = edm::ContainerMask<edmNew::DetSetVector<SiPixelCluster>>;
+  using StripMask = edm::ContainerMask<edmNew::DetSetVector<SiStripCluster>>;
+
+  explicit TrackCandidateClusterMaskChecker(edm::ParameterSet const& iConfig)
+      : candidatesToken_{consumes<TrackCandidateCollection>(iConfig.getParameter<edm::InputTag>("candidates"))},
+        pixelMaskToken_{consumes<PixelMask>(iConfig.getParameter<edm::InputTag>("pixelClustersToSkip"))},
+        stripMaskToken_{consumes<StripMask>(iConfig.getParameter<edm::InputTag>("stripClustersToSkip"))} {}
+
+  void analyze(edm::StreamID, edm::Event const& iEvent, edm::EventSetup const&) const override;
+  void endJob() override;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+    edm::ParameterSetDescription desc;
+    desc.add<edm::InputTag>("candidates");
+    desc.add<edm::InputTag>("pixelClustersToSkip");
+    desc.add<edm::InputTag>("stripClustersToSkip");
+    descriptions.addDefault(desc);
+  }
+
+private:
+  void check(edm::Event const& iEvent,
+             OmniClusterRef const& cluster,
+             PixelMask const& pixelMask,
+             StripMask const& stripMask) const;
+
+  edm::EDGetTokenT<TrackCandidateCollection> const candidatesToken_;
+  edm::EDGetTokenT<PixelMask> const pixelMaskToken_;
+  edm::EDGetTokenT<StripMask> const stripMaskToken_;
+
+  mutable std::atomic<unsigned int> nCandidates_{0};
+};
+
+void TrackCandidateClusterMaskChecker::check(edm::Event const& iEvent,
+                                             OmniClusterRef const& cluster,
+                                             PixelMask const& pixelMask,
+                                             StripMask const& stripMask) const {
+  auto const& maskID = cluster.isPixel() ? pixelMask.refProd().id() : stripMask.refProd().id();
+  if (cluster.id() != maskID) {
+    throw cms::Exception("ClusterMaskMismatch") << "event " << iEvent.id() << ": a candidate hit is built from product "
+                                                << cluster.id() << ", the mask refers to product " << maskID;
+  }
+  bool const masked = cluster.isPixel() ? pixelMask.mask(cluster.index()) : stripMask.mask(cluster.index());
+  if (masked) {
+    throw cms::Exception("ClusterMaskMismatch")
+        << "event " << iEvent.id() << ": a candidate uses the masked " << (cluster.isPixel() ? "pixel" : "strip")
+        << " cluster " << cluster.index();
+  }
+}
+
+void TrackCandidateClusterMaskChecker::analyze(edm::StreamID, edm::Event const& iEvent, edm::EventSetup const&) const {
+  auto const& candidates = iEvent.get(candidatesToken_);
+  auto const& pixelMask = iEvent.get(pixelMaskToken_);
+  auto const& stripMask = iEvent.get(stripMaskToken_);
+
+  for (auto const& candidate : candidates) {
+    for (auto hit = candidate.recHits().first; hit != candidate.recHits().second; ++hit) {
+      if (not trackerHitRTTI::isFromDet(*hit))
+        continue;
+      if (trackerHitRTTI::isMatched(*hit)) {
+        auto const& matched = static_cast<SiStripMatchedRecHit2D const&>(*hit);
+        check(iEvent, matched.monoClusterRef(), pixelMask, stripMask);
+        check(iEvent, matched.stereoClusterRef(), pixelMask, stripMask);
+      } else {
+        check(iEvent, static_cast<BaseTrackerRecHit const&>(*hit).firstClusterRef(), pixelMask, stripMask);
+      }
+    }
+  }
+  nCandidates_ += candidates.size();
+}
+
+void TrackCandidateClusterMaskChecker::endJob() {
+  edm::LogPrint("TrackCandidateClusterMaskChecker") << "checked " << nCandidates_ << " track candidates";
+  if (nCandidates_ == 0) {
+    throw cms::Exception("ClusterMaskMismatch") << "no track candidate to check";
+  }
+}
+
+DEFINE_FWK_MODULE(TrackCandidateClusterMaskChecker);
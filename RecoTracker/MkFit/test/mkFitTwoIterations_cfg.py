@@ -0,0 +1,62 @@
+import FWCore.ParameterSet.Config as cms
+from Configuration.Eras.Era_Run2_2018_cff import Run2_2018
+
+# Builds the initialStep and lowPtQuadStep track candidates of the events of
+# mkFitTestTTbar.root with two MkFitProducers of different configurations,
+# and checks that the lowPtQuadStep candidates use none of the clusters
+# masked by the initialStep
+
+process = cms.Process("MKFITTEST", Run2_2018)
+
+process.load("Configuration.StandardSequences.Services_cff")
+process.load("Configuration.StandardSequences.GeometryRecoDB_cff")
+process.load("Configuration.StandardSequences.MagneticField_cff")
+process.load("Configuration.StandardSequences.Reconstruction_cff")
+process.load("Configuration.StandardSequences.FrontierConditions_GlobalTag_cff")
+from Configuration.AlCa.GlobalTag import GlobalTag
+process.GlobalTag = GlobalTag(process.GlobalTag, "auto:phase1_2018_realistic", "")
+
+process.source = cms.Source("PoolSource",
+    fileNames = cms.untracked.vstring("file:mkFitTestTTbar.root")
+)
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(-1))
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(4),
+    numberOfStreams = cms.untracked.uint32(2)
+)
+
+from RecoTracker.MkFit.customizeInitialStepToMkFit import customizeInitialStepToMkFit
+process = customizeInitialStepToMkFit(process)
+
+import RecoTracker.MkFit.mkFitInputConverter_cfi as mkFitInputConverter_cfi
+import RecoTracker.MkFit.mkFitProducer_cfi as mkFitProducer_cfi
+import RecoTracker.MkFit.mkFitOutputConverter_cfi as mkFitOutputConverter_cfi
+process.lowPtQuadStepTrackCandidatesMkFitInput = mkFitInputConverter_cfi.mkFitInputConverter.clone(
+    seeds = "lowPtQuadStepSeeds",
+    pixelClustersToSkip = "lowPtQuadStepClusters",
+    stripClustersToSkip = "lowPtQuadStepClusters",
+)
+# a configuration different from the initialStep one
+process.lowPtQuadStepTrackCandidatesMkFit = mkFitProducer_cfi.mkFitProducer.clone(
+    hitsSeeds = "lowPtQuadStepTrackCandidatesMkFitInput",
+    seedCleaning = "none",
+)
+process.lowPtQuadStepTrackCandidates = mkFitOutputConverter_cfi.mkFitOutputConverter.clone(
+    seeds = "lowPtQuadStepSeeds",
+    hitsSeeds = "lowPtQuadStepTrackCandidatesMkFitInput",
+    tracks = "lowPtQuadStepTrackCandidatesMkFit",
+)
+process.LowPtQuadStepTask.add(process.lowPtQuadStepTrackCandidatesMkFitInput,
+                              process.lowPtQuadStepTrackCandidatesMkFit)
+
+process.checkLowPtQuadStepCandidates = cms.EDAnalyzer("TrackCandidateClusterMaskChecker",
+    candidates = cms.InputTag("lowPtQuadStepTrackCandidates"),
+    pixelClustersToSkip = cms.InputTag("lowPtQuadStepClusters"),
+    stripClustersToSkip = cms.InputTag("lowPtQuadStepClusters")
+)
+
+process.t = cms.Task(process.MeasurementTrackerEvent,
+                     process.trackerClusterCheck,
+                     process.InitialStepTask,
+                     process.LowPtQuadStepTask)
+process.p = cms.Path(process.checkLowPtQuadStepCandidates, process.t)
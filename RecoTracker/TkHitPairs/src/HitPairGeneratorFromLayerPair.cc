@@ -40,6 +40,7 @@ HitPairGeneratorFromLayerPair::HitPairGeneratorFromLayerPair(unsigned int inner,
 HitPairGeneratorFromLayerPair::~HitPairGeneratorFromLayerPair() {}
 
 // devirtualizer
+#include <algorithm>
 #include <tuple>
 namespace {
 
@@ -51,14 +52,15 @@ namespace {
       checkRZ = reinterpret_cast<Algo const*>(a);
     }
 
+    // branchless on the SoA columns, so that the loop vectorizes
     void operator()(int b, int e, const RecHitsSortedInPhi& innerHitsMap, bool* ok) const {
       constexpr float nSigmaRZ = 3.46410161514f;  // std::sqrt(12.f);
       for (int i = b; i != e; ++i) {
         Range allowed = checkRZ->range(innerHitsMap.u[i]);
         float vErr = nSigmaRZ * innerHitsMap.dv[i];
-        Range hitRZ(innerHitsMap.v[i] - vErr, innerHitsMap.v[i] + vErr);
-        Range crossRange = allowed.intersection(hitRZ);
-        ok[i - b] = !crossRange.empty();
+        // intersection of allowed and [v-vErr, v+vErr] not empty
+        ok[i - b] = !(std::min(allowed.max(), innerHitsMap.v[i] + vErr) <
+                      std::max(allowed.min(), innerHitsMap.v[i] - vErr));
       }
     }
     Algo const* checkRZ;
@@ -67,6 +69,35 @@ namespace {
   template <typename... Args>
   using Kernels = std::tuple<Kernel<Args>...>;
 
+  // Adds the inner hits in [b,e) compatible in rz with the outer hit io, a block at a time:
+  // the mask of a block is filled by the kernel, then the count is checked against maxElement once.
+  // Returns false, and adds nothing more, if maxElement would be exceeded.
+  template <typename K>
+  bool addCompatible(K const& kernel,
+                     int b,
+                     int e,
+                     int io,
+                     const RecHitsSortedInPhi& innerHitsMap,
+                     unsigned int maxElement,
+                     HitDoublets& result) {
+    constexpr int blockSize = 64;
+    bool ok[blockSize];
+    for (int bb = b; bb < e; bb += blockSize) {
+      int n = std::min(e - bb, blockSize);
+      kernel(bb, bb + n, innerHitsMap, ok);
+      unsigned int nok = 0;
+      for (int i = 0; i != n; ++i)
+        nok += ok[i];
+      if (maxElement != 0 && result.size() + nok > maxElement)
+        return false;
+      for (int i = 0; i != n; ++i) {
+        if (ok[i])
+          result.add(bb + i, io);
+      }
+    }
+    return true;
+  }
+
 }  // namespace
 
 void HitPairGeneratorFromLayerPair::hitPairs(const TrackingRegion& region,
@@ -154,31 +185,26 @@ void HitPairGeneratorFromLayerPair::doublets(const TrackingRegion& region,
       auto e = innerRange[j + 1];
       if (e == b)
         continue;
-      bool ok[e - b];
+      bool added = true;
       switch (checkRZ->algo()) {
         case (HitRZCompatibility::zAlgo):
           std::get<0>(kernels).set(checkRZ);
-          std::get<0>(kernels)(b, e, innerHitsMap, ok);
+          added = addCompatible(std::get<0>(kernels), b, e, io, innerHitsMap, theMaxElement, result);
           break;
         case (HitRZCompatibility::rAlgo):
           std::get<1>(kernels).set(checkRZ);
-          std::get<1>(kernels)(b, e, innerHitsMap, ok);
+          added = addCompatible(std::get<1>(kernels), b, e, io, innerHitsMap, theMaxElement, result);
           break;
         case (HitRZCompatibility::etaAlgo):
           std::get<2>(kernels).set(checkRZ);
-          std::get<2>(kernels)(b, e, innerHitsMap, ok);
+          added = addCompatible(std::get<2>(kernels), b, e, io, innerHitsMap, theMaxElement, result);
           break;
       }
-      for (int i = 0; i != e - b; ++i) {
-        if (!ok[i])
-          continue;
-        if (theMaxElement != 0 && result.size() >= theMaxElement) {
-          result.clear();
-          edm::LogError("TooManyPairs") << "number of pairs exceed maximum, no pairs produced";
-          delete checkRZ;
-          return;
-        }
-        result.add(b + i, io);
+      if (!added) {
+        result.clear();
+        edm::LogError("TooManyPairs") << "number of pairs exceed maximum, no pairs produced";
+        delete checkRZ;
+        return;
       }
     }
     delete checkRZ;
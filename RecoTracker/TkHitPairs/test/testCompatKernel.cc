@@ -8,6 +8,7 @@
 typedef PixelRecoRange<float> Range;
 
 // devirtualizer
+#include <algorithm>
 #include <tuple>
 namespace {
 
@@ -24,9 +25,8 @@ namespace {
       for (int i = b; i != e; ++i) {
         Range allowed = checkRZ->range(innerHitsMap.u[i]);
         float vErr = nSigmaRZ * innerHitsMap.dv[i];
-        Range hitRZ(innerHitsMap.v[i] - vErr, innerHitsMap.v[i] + vErr);
-        Range crossRange = allowed.intersection(hitRZ);
-        ok[i - b] = !crossRange.empty();
+        ok[i - b] = !(std::min(allowed.max(), innerHitsMap.v[i] + vErr) <
+                      std::max(allowed.min(), innerHitsMap.v[i] - vErr));
       }
     }
     Algo const *checkRZ;
@@ -124,7 +124,7 @@ TrajectoryStateOnSurface MultiRefittedTS::trajectoryStateOnSurface(const Surface
   for (RTSvector::const_iterator it = theComponents.begin(); it != theComponents.end(); it++) {
     tsosComponents.push_back((**it).trajectoryStateOnSurface(surface));
   }
-  return TrajectoryStateOnSurface((BasicTrajectoryState*)new BasicMultiTrajectoryState(tsosComponents));
+  return TrajectoryStateOnSurface(BasicTrajectoryState::churn<BasicMultiTrajectoryState>(tsosComponents));
 }
 
 TrajectoryStateOnSurface MultiRefittedTS::trajectoryStateOnSurface(const Surface& surface, const Propagator& propagator)
@@ -134,7 +134,7 @@ TrajectoryStateOnSurface MultiRefittedTS::trajectoryStateOnSurface(const Surface
   for (RTSvector::const_iterator it = theComponents.begin(); it != theComponents.end(); it++) {
     tsosComponents.push_back((**it).trajectoryStateOnSurface(surface, propagator));
   }
-  return TrajectoryStateOnSurface((BasicTrajectoryState*)new BasicMultiTrajectoryState(tsosComponents));
+  return TrajectoryStateOnSurface(BasicTrajectoryState::churn<BasicMultiTrajectoryState>(tsosComponents));
 }
 
 reco::TransientTrack MultiRefittedTS::transientTrack() const {
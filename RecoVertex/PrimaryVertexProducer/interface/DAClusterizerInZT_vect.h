@@ -235,6 +235,7 @@ private:
   double dtCutOff_;
   double t0Max_;
   bool useTc_;
+  bool adaptiveCooling_;  // skip cooling steps at which no prototype can become critical
 
   double mintrkweight_;
   double uniquetrkweight_;
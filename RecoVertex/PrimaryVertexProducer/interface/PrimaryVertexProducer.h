@@ -30,6 +30,8 @@
 
 //#include "RecoVertex/PrimaryVertexProducer/interface/PrimaryVertexProducerAlgorithm.h"
 #include "TrackingTools/TransientTrack/interface/TransientTrack.h"
+#include "DataFormats/BeamSpot/interface/BeamSpot.h"
+#include "RecoVertex/VertexPrimitives/interface/TransientVertex.h"
 #include "RecoVertex/PrimaryVertexProducer/interface/TrackFilterForPVFindingBase.h"
 #include "RecoVertex/PrimaryVertexProducer/interface/TrackClusterizerInZ.h"
 #include "RecoVertex/PrimaryVertexProducer/interface/DAClusterizerInZ_vect.h"
@@ -77,6 +79,13 @@ private:
 
   std::vector<algo> algorithms;
 
+  // thread safe if fitter is not used concurrently elsewhere
+  TransientVertex fitCluster(algo const& algorithm,
+                             VertexFitter<5> const& fitter,
+                             std::vector<reco::TransientTrack> const& clus,
+                             reco::BeamSpot const& beamSpot,
+                             bool validBS) const;
+
   edm::ParameterSet theConfig;
   bool fVerbose;
 
@@ -18,6 +18,9 @@
 
 #include "RecoVertex/VertexTools/interface/GeometricAnnealing.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 PrimaryVertexProducer::PrimaryVertexProducer(const edm::ParameterSet& conf) : theConfig(conf) {
   fVerbose = conf.getUntrackedParameter<bool>("verbose", false);
 
@@ -187,59 +190,29 @@ void PrimaryVertexProducer::produce(edm::Event& iEvent, const edm::EventSetup& i
   }
 
   // vertex fits
-  for (std::vector<algo>::const_iterator algorithm = algorithms.begin(); algorithm != algorithms.end(); algorithm++) {
+  // every (algorithm, cluster) pair is fitted as an independent task, the results are then used in cluster order
+  size_t const nclus = clusters.size();
+  std::vector<std::vector<TransientVertex> > fitted(algorithms.size(), std::vector<TransientVertex>(nclus));
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, algorithms.size() * nclus), [&](tbb::blocked_range<size_t> const& r) {
+    // the fitters keep state during a fit (e.g. the annealing temperature): each task uses its own copies
+    std::vector<std::unique_ptr<VertexFitter<5> > > fitters(algorithms.size());
+    for (size_t k = r.begin(); k != r.end(); ++k) {
+      size_t const ialgo = k / nclus;
+      size_t const iclus = k % nclus;
+      if (!fitters[ialgo])
+        fitters[ialgo].reset(algorithms[ialgo].fitter->clone());
+      fitted[ialgo][iclus] = fitCluster(algorithms[ialgo], *fitters[ialgo], clusters[iclus], beamSpot, validBS);
+    }
+  });
+
+  for (size_t ialgo = 0; ialgo != algorithms.size(); ++ialgo) {
+    auto const algorithm = algorithms.begin() + ialgo;
     auto result = std::make_unique<reco::VertexCollection>();
     reco::VertexCollection& vColl = (*result);
 
     std::vector<TransientVertex> pvs;
-    for (std::vector<std::vector<reco::TransientTrack> >::const_iterator iclus = clusters.begin();
-         iclus != clusters.end();
-         iclus++) {
-      double sumwt = 0.;
-      double sumwt2 = 0.;
-      double sumw = 0.;
-      double meantime = 0.;
-      double vartime = 0.;
-      if (f4D) {
-        for (const auto& tk : *iclus) {
-          const double time = tk.timeExt();
-          const double err = tk.dtErrorExt();
-          const double inverr = err > 0. ? 1.0 / err : 0.;
-          const double w = inverr * inverr;
-          sumwt += w * time;
-          sumwt2 += w * time * time;
-          sumw += w;
-        }
-        meantime = sumwt / sumw;
-        double sumsq = sumwt2 - sumwt * sumwt / sumw;
-        double chisq = iclus->size() > 1 ? sumsq / double(iclus->size() - 1) : sumsq / double(iclus->size());
-        vartime = chisq / sumw;
-      }
-
-      TransientVertex v;
-      if (algorithm->useBeamConstraint && validBS && ((*iclus).size() > 1)) {
-        v = algorithm->fitter->vertex(*iclus, beamSpot);
-
-        if (f4D) {
-          if (v.isValid()) {
-            auto err = v.positionError().matrix4D();
-            err(3, 3) = vartime;
-            v = TransientVertex(v.position(), meantime, err, v.originalTracks(), v.totalChiSquared());
-          }
-        }
-
-      } else if (!(algorithm->useBeamConstraint) && ((*iclus).size() > 1)) {
-        v = algorithm->fitter->vertex(*iclus);
-
-        if (f4D) {
-          if (v.isValid()) {
-            auto err = v.positionError().matrix4D();
-            err(3, 3) = vartime;
-            v = TransientVertex(v.position(), meantime, err, v.originalTracks(), v.totalChiSquared());
-          }
-        }
-
-      }  // else: no fit ==> v.isValid()=False
+    for (size_t iclus = 0; iclus != nclus; ++iclus) {
+      TransientVertex const& v = fitted[ialgo][iclus];
 
       if (fVerbose) {
         if (v.isValid()) {
@@ -249,9 +222,9 @@ void PrimaryVertexProducer::produce(edm::Event& iEvent, const edm::EventSetup& i
           std::cout << "=" << v.position().x() << " " << v.position().y() << " " << v.position().z();
           if (f4D)
             std::cout << " " << v.time();
-          std::cout << " cluster size = " << (*iclus).size() << std::endl;
+          std::cout << " cluster size = " << clusters[iclus].size() << std::endl;
         } else {
-          std::cout << "Invalid fitted vertex,  cluster size=" << (*iclus).size() << std::endl;
+          std::cout << "Invalid fitted vertex,  cluster size=" << clusters[iclus].size() << std::endl;
         }
       }
 
@@ -324,5 +297,46 @@ void PrimaryVertexProducer::produce(edm::Event& iEvent, const edm::EventSetup& i
   }
 }
 
+TransientVertex PrimaryVertexProducer::fitCluster(algo const& algorithm,
+                                                  VertexFitter<5> const& fitter,
+                                                  std::vector<reco::TransientTrack> const& clus,
+                                                  reco::BeamSpot const& beamSpot,
+                                                  bool validBS) const {
+  double sumwt = 0.;
+  double sumwt2 = 0.;
+  double sumw = 0.;
+  double meantime = 0.;
+  double vartime = 0.;
+  if (f4D) {
+    for (const auto& tk : clus) {
+      const double time = tk.timeExt();
+      const double err = tk.dtErrorExt();
+      const double inverr = err > 0. ? 1.0 / err : 0.;
+      const double w = inverr * inverr;
+      sumwt += w * time;
+      sumwt2 += w * time * time;
+      sumw += w;
+    }
+    meantime = sumwt / sumw;
+    double sumsq = sumwt2 - sumwt * sumwt / sumw;
+    double chisq = clus.size() > 1 ? sumsq / double(clus.size() - 1) : sumsq / double(clus.size());
+    vartime = chisq / sumw;
+  }
+
+  TransientVertex v;
+  if (algorithm.useBeamConstraint && validBS && (clus.size() > 1)) {
+    v = fitter.vertex(clus, beamSpot);
+  } else if (!(algorithm.useBeamConstraint) && (clus.size() > 1)) {
+    v = fitter.vertex(clus);
+  }  // else: no fit ==> v.isValid()=False
+
+  if (f4D && v.isValid()) {
+    auto err = v.positionError().matrix4D();
+    err(3, 3) = vartime;
+    v = TransientVertex(v.position(), meantime, err, v.originalTracks(), v.totalChiSquared());
+  }
+  return v;
+}
+
 //define this as a plug-in
 DEFINE_FWK_MODULE(PrimaryVertexProducer);
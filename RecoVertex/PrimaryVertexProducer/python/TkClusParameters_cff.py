@@ -34,6 +34,7 @@ DA2D_vectParameters = cms.PSet(
     TkDAClusParameters = cms.PSet(
         verbose = cms.untracked.bool(False),
         coolingFactor = cms.double(0.6),  # moderate annealing speed
+        adaptiveCooling = cms.bool(False), # skip cooling steps while no cluster is close to splitting
         Tmin = cms.double(4.0),           # end of vertex splitting
         Tpurge = cms.double(4.0),         # cleaning 
         Tstop = cms.double(2.0),          # end of annealing 
@@ -3,6 +3,7 @@
 #include "DataFormats/GeometryCommonDetAlgo/interface/Measurement1D.h"
 #include "RecoVertex/VertexPrimitives/interface/VertexException.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cassert>
 #include <limits>
@@ -35,6 +36,7 @@ DAClusterizerInZT_vect::DAClusterizerInZT_vect(const edm::ParameterSet& conf) {
     coolingFactor_ = -coolingFactor_;
     useTc_ = false;
   }
+  adaptiveCooling_ = conf.getParameter<bool>("adaptiveCooling");
   d0CutOff_ = conf.getParameter<double>("d0CutOff");
   dzCutOff_ = conf.getParameter<double>("dzCutOff");
   dtCutOff_ = conf.getParameter<double>("dtCutOff");
@@ -55,6 +57,7 @@ DAClusterizerInZT_vect::DAClusterizerInZT_vect(const edm::ParameterSet& conf) {
     std::cout << "DAClusterizerinZT_vect: vertexSize = " << vertexSize_ << std::endl;
     std::cout << "DAClusterizerinZT_vect: vertexSizeTime = " << vertexSizeTime_ << std::endl;
     std::cout << "DAClusterizerinZT_vect: coolingFactor = " << coolingFactor_ << std::endl;
+    std::cout << "DAClusterizerinZT_vect: adaptiveCooling = " << adaptiveCooling_ << std::endl;
     std::cout << "DAClusterizerinZT_vect: d0CutOff = " << d0CutOff_ << std::endl;
     std::cout << "DAClusterizerinZT_vect: dzCutOff = " << dzCutOff_ << std::endl;
     std::cout << "DAClusterizerinZT_vect: dtCutoff = " << dtCutOff_ << std::endl;
@@ -86,7 +89,9 @@ DAClusterizerInZT_vect::DAClusterizerInZT_vect(const edm::ParameterSet& conf) {
 namespace {
   inline double local_exp(double const& inp) { return vdt::fast_exp(inp); }
 
-  inline void local_exp_list(double const* arg_inp, double* arg_out, const unsigned arg_arr_size) {
+  inline void local_exp_list(double const* __restrict__ arg_inp,
+                             double* __restrict__ arg_out,
+                             const unsigned arg_arr_size) {
     for (unsigned i = 0; i != arg_arr_size; ++i)
       arg_out[i] = vdt::fast_exp(arg_inp[i]);
   }
@@ -179,24 +184,31 @@ double DAClusterizerInZT_vect::update(
   }
 
   // define kernels
+  // the vertex arrays are accessed through local restrict pointers: they never overlap, and telling
+  // the compiler so spares the runtime alias checks of the auto-vectorized loops over vertices
   auto kernel_calc_exp_arg = [beta, nv](const unsigned int itrack, track_t const& tracks, vertex_t const& vertices) {
     const auto track_z = tracks.z_[itrack];
     const auto track_t = tracks.t_[itrack];
     const auto botrack_dz2 = -beta * tracks.dz2_[itrack];
     const auto botrack_dt2 = -beta * tracks.dt2_[itrack];
+    double const* __restrict__ vz = vertices.z_;
+    double const* __restrict__ vt = vertices.t_;
+    double* __restrict__ arg = vertices.ei_cache_;
 
     // auto-vectorized
     for (unsigned int ivertex = 0; ivertex < nv; ++ivertex) {
-      const auto mult_resz = track_z - vertices.z_[ivertex];
-      const auto mult_rest = track_t - vertices.t_[ivertex];
-      vertices.ei_cache_[ivertex] = botrack_dz2 * (mult_resz * mult_resz) + botrack_dt2 * (mult_rest * mult_rest);
+      const auto mult_resz = track_z - vz[ivertex];
+      const auto mult_rest = track_t - vt[ivertex];
+      arg[ivertex] = botrack_dz2 * (mult_resz * mult_resz) + botrack_dt2 * (mult_rest * mult_rest);
     }
   };
 
   auto kernel_add_Z = [nv, Z_init](vertex_t const& vertices) -> double {
+    double const* __restrict__ pk = vertices.pk_;
+    double const* __restrict__ ei = vertices.ei_;
     double ZTemp = Z_init;
     for (unsigned int ivertex = 0; ivertex < nv; ++ivertex) {
-      ZTemp += vertices.pk_[ivertex] * vertices.ei_[ivertex];
+      ZTemp += pk[ivertex] * ei[ivertex];
     }
     return ZTemp;
   };
@@ -209,23 +221,36 @@ double DAClusterizerInZT_vect::update(
     auto tmp_trk_z = tks_vec.z_[track_num];
     auto tmp_trk_t = tks_vec.t_[track_num];
 
+    double const* __restrict__ vz = y_vec.z_;
+    double const* __restrict__ vt = y_vec.t_;
+    double const* __restrict__ pk = y_vec.pk_;
+    double const* __restrict__ ei = y_vec.ei_;
+    double* __restrict__ se = y_vec.se_;
+    double* __restrict__ nuz = y_vec.nuz_;
+    double* __restrict__ nut = y_vec.nut_;
+    double* __restrict__ swz = y_vec.swz_;
+    double* __restrict__ swt = y_vec.swt_;
+    double* __restrict__ szz = y_vec.szz_;
+    double* __restrict__ stt = y_vec.stt_;
+    double* __restrict__ szt = y_vec.szt_;
+
     // auto-vectorized
     for (unsigned int k = 0; k < nv; ++k) {
       // parens are important for numerical stability
-      y_vec.se_[k] += tmp_trk_pi * (y_vec.ei_[k] * o_trk_Z_sum);
-      const auto w = tmp_trk_pi * (y_vec.pk_[k] * y_vec.ei_[k] * o_trk_Z_sum);  // p_{ik}
+      se[k] += tmp_trk_pi * (ei[k] * o_trk_Z_sum);
+      const auto w = tmp_trk_pi * (pk[k] * ei[k] * o_trk_Z_sum);  // p_{ik}
       const auto wz = w * o_trk_err_z;
       const auto wt = w * o_trk_err_t;
-      y_vec.nuz_[k] += wz;
-      y_vec.nut_[k] += wt;
-      y_vec.swz_[k] += wz * tmp_trk_z;
-      y_vec.swt_[k] += wt * tmp_trk_t;
+      nuz[k] += wz;
+      nut[k] += wt;
+      swz[k] += wz * tmp_trk_z;
+      swt[k] += wt * tmp_trk_t;
       /* this is really only needed when we want to get Tc too, mayb better to do it elsewhere? */
-      const auto dsz = (tmp_trk_z - y_vec.z[k]) * o_trk_err_z;
-      const auto dst = (tmp_trk_t - y_vec.t[k]) * o_trk_err_t;
-      y_vec.szz_[k] += w * dsz * dsz;
-      y_vec.stt_[k] += w * dst * dst;
-      y_vec.szt_[k] += w * dsz * dst;
+      const auto dsz = (tmp_trk_z - vz[k]) * o_trk_err_z;
+      const auto dst = (tmp_trk_t - vt[k]) * o_trk_err_t;
+      szz[k] += w * dsz * dsz;
+      stt[k] += w * dst * dst;
+      szt[k] += w * dsz * dst;
     }
   };
 
@@ -855,8 +880,20 @@ vector<TransientVertex> DAClusterizerInZT_vect::vertices(const vector<reco::Tran
       while (merge(y, beta)) {
         update(beta, tks, y, false, rho0);
       }
-      split(beta, tks, y);
+      bool const splitDone = split(beta, tks, y);
       beta = beta / coolingFactor_;
+      if (adaptiveCooling_ && !splitDone) {
+        // no prototype was critical: keep cooling without thermalizing at each step
+        // while all of them stay at least one step away from their critical temperature;
+        // this changes the clustering, so it is not used by default
+        double Tcmax = 0;
+        for (unsigned int k = 0; k < y.getSize(); k++) {
+          Tcmax = std::max(Tcmax, get_Tc(y, k));
+        }
+        while ((beta / coolingFactor_ < betafreeze) && (beta / coolingFactor_ * Tcmax < coolingFactor_)) {
+          beta = beta / coolingFactor_;
+        }
+      }
     } else {
       beta = beta / coolingFactor_;
       splitAll(y);
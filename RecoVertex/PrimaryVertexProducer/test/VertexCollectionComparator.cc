@@ -0,0 +1,118 @@
+// -*- C++ -*-
+//
+// Package:     RecoVertex/PrimaryVertexProducer
+// Class  :     VertexCollectionComparator
+//
+// Implementation:
+//     Matches each good vertex of a reference collection to the closest vertex in z
+//     of a test collection. At the end of the job, prints the fraction of matched
+//     vertices and the difference in the number of good vertices, and throws if
+//     they are outside the configured limits.
+//
+
+#include "DataFormats/VertexReco/interface/Vertex.h"
+#include "DataFormats/VertexReco/interface/VertexFwd.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/global/EDAnalyzer.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+class VertexCollectionComparator : public edm::global::EDAnalyzer<> {
+public:
+  explicit VertexCollectionComparator(edm::ParameterSet const& iConfig)
+      : referenceToken_{consumes<reco::VertexCollection>(iConfig.getParameter<edm::InputTag>("reference"))},
+        testToken_{consumes<reco::VertexCollection>(iConfig.getParameter<edm::InputTag>("test"))},
+        minNdof_{iConfig.getParameter<double>("minNdof")},
+        maxDeltaZ_{iConfig.getParameter<double>("maxDeltaZ")},
+        minMatchedFraction_{iConfig.getParameter<double>("minMatchedFraction")},
+        maxCountDifference_{iConfig.getParameter<double>("maxCountDifference")} {}
+
+  void analyze(edm::StreamID, edm::Event const& iEvent, edm::EventSetup const&) const override;
+  void endJob() override;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+    edm::ParameterSetDescription desc;
+    desc.add<edm::InputTag>("reference");
+    desc.add<edm::InputTag>("test");
+    desc.add<double>("minNdof", 4.)->setComment("only vertices with more degrees of freedom are compared");
+    desc.add<double>("maxDeltaZ", 0.01)->setComment("in cm");
+    desc.add<double>("minMatchedFraction", 0.95)->setComment("of the good reference vertices");
+    desc.add<double>("maxCountDifference", 0.05)
+        ->setComment("relative difference between the total numbers of good reference and test vertices");
+    descriptions.addDefault(desc);
+  }
+
+private:
+  bool isGood(reco::Vertex const& v) const { return v.isValid() and not v.isFake() and v.ndof() > minNdof_; }
+
+  edm::EDGetTokenT<reco::VertexCollection> const referenceToken_;
+  edm::EDGetTokenT<reco::VertexCollection> const testToken_;
+  double const minNdof_;
+  double const maxDeltaZ_;
+  double const minMatchedFraction_;
+  double const maxCountDifference_;
+
+  mutable std::atomic<unsigned int> nReference_{0};
+  mutable std::atomic<unsigned int> nTest_{0};
+  mutable std::atomic<unsigned int> nMatched_{0};
+};
+
+void VertexCollectionComparator::analyze(edm::StreamID, edm::Event const& iEvent, edm::EventSetup const&) const {
+  auto const& reference = iEvent.get(referenceToken_);
+  auto const& test = iEvent.get(testToken_);
+
+  unsigned int nReference = 0;
+  unsigned int nMatched = 0;
+  for (auto const& ref : reference) {
+    if (not isGood(ref))
+      continue;
+    ++nReference;
+    double dzMin = std::numeric_limits<double>::max();
+    for (auto const& tst : test) {
+      if (isGood(tst))
+        dzMin = std::min(dzMin, std::abs(tst.z() - ref.z()));
+    }
+    if (dzMin < maxDeltaZ_)
+      ++nMatched;
+  }
+  unsigned int nTest = 0;
+  for (auto const& tst : test) {
+    if (isGood(tst))
+      ++nTest;
+  }
+  LogDebug("VertexCollectionComparator") << "event " << iEvent.id() << ": " << nReference << " reference and "
+                                         << nTest << " test vertices, " << nMatched << " matched";
+
+  nReference_ += nReference;
+  nTest_ += nTest;
+  nMatched_ += nMatched;
+}
+
+void VertexCollectionComparator::endJob() {
+  if (nReference_ == 0) {
+    throw cms::Exception("VertexMismatch") << "no good reference vertex to compare";
+  }
+  double const matchedFraction = double(nMatched_) / nReference_;
+  double const countDifference = std::abs(double(nTest_) - double(nReference_)) / nReference_;
+  edm::LogPrint("VertexCollectionComparator")
+      << nReference_ << " reference vertices, " << nTest_ << " test vertices, " << nMatched_
+      << " reference vertices matched within " << maxDeltaZ_ << " cm (" << matchedFraction << ")";
+  if (matchedFraction < minMatchedFraction_ or countDifference > maxCountDifference_) {
+    throw cms::Exception("VertexMismatch")
+        << "matched fraction " << matchedFraction << " (minimum " << minMatchedFraction_
+        << "), relative difference in the number of vertices " << countDifference << " (maximum "
+        << maxCountDifference_ << ")";
+  }
+}
+
+DEFINE_FWK_MODULE(VertexCollectionComparator);
@@ -0,0 +1,45 @@
+import FWCore.ParameterSet.Config as cms
+from Configuration.Eras.Era_Run2_2018_cff import Run2_2018
+
+# Reconstructs the 4D primary vertices of the events of pvTestTTbar.root with
+# and without the adaptive cooling of the DA2D_vect clusterizer, and checks
+# that the good vertices found without it are still found with it
+
+process = cms.Process("PVTEST", Run2_2018)
+
+process.load("Configuration.StandardSequences.Services_cff")
+process.load("Configuration.StandardSequences.GeometryRecoDB_cff")
+process.load("Configuration.StandardSequences.MagneticField_cff")
+process.load("Configuration.StandardSequences.Reconstruction_cff")
+process.load("Configuration.StandardSequences.FrontierConditions_GlobalTag_cff")
+from Configuration.AlCa.GlobalTag import GlobalTag
+process.GlobalTag = GlobalTag(process.GlobalTag, "auto:phase1_2018_realistic", "")
+
+process.source = cms.Source("PoolSource",
+    fileNames = cms.untracked.vstring("file:pvTestTTbar.root")
+)
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(-1))
+
+from RecoVertex.Configuration.RecoVertex_phase2_timing_cff import tpClusterProducer, quickTrackAssociatorByHits, trackTimeValueMapProducer, unsortedOfflinePrimaryVertices4D
+process.tpClusterProducer = tpClusterProducer
+process.quickTrackAssociatorByHits = quickTrackAssociatorByHits
+process.trackTimeValueMapProducer = trackTimeValueMapProducer
+
+process.verticesStandardCooling = unsortedOfflinePrimaryVertices4D.clone(
+    TkClusParameters = dict(TkDAClusParameters = dict(adaptiveCooling = False))
+)
+process.verticesAdaptiveCooling = unsortedOfflinePrimaryVertices4D.clone(
+    TkClusParameters = dict(TkDAClusParameters = dict(adaptiveCooling = True))
+)
+
+process.compareVertices = cms.EDAnalyzer("VertexCollectionComparator",
+    reference = cms.InputTag("verticesStandardCooling"),
+    test = cms.InputTag("verticesAdaptiveCooling")
+)
+
+process.p = cms.Path(process.tpClusterProducer +
+                     process.quickTrackAssociatorByHits +
+                     process.trackTimeValueMapProducer +
+                     process.verticesStandardCooling +
+                     process.verticesAdaptiveCooling +
+                     process.compareVertices)
@@ -43,6 +43,16 @@ public:
   using Propagator::propagate;
   using Propagator::propagateWithPath;
 
+  /** propagation of n states to the same plane, result[i] is the same as
+   *  propagateWithPath(fts[i], plane). For barrel planes the helix crossings
+   *  and the field at the crossing points are computed for all states at once.
+   *  Not used by the track building yet.
+   */
+  void propagateManyWithPath(const FreeTrajectoryState* fts,
+                             unsigned int n,
+                             const Plane& plane,
+                             std::pair<TrajectoryStateOnSurface, double>* result) const;
+
 private:
   /// propagation to plane with path length
   std::pair<TrajectoryStateOnSurface, double> propagateWithPath(const FreeTrajectoryState& fts,
@@ -70,6 +80,19 @@ public:
   void setMaxRelativeChangeInBz(const float maxDBz) { theMaxDBzRatio = maxDBz; }
 
 private:
+  /// check of the deltaPhi limit
+  bool dPhiTooLarge(const FreeTrajectoryState& fts, double s) const {
+    float dphi2 = float(s) * fts.transverseCurvature();
+    dphi2 = dphi2 * dphi2 * fts.momentum().perp2();
+    return dphi2 > theMaxDPhi2 * fts.momentum().mag2();
+  }
+
+  /// check of the change in curvature
+  bool bzChangeTooLarge(const FreeTrajectoryState& fts, const GlobalTrajectoryParameters& gtp) const {
+    float rho = fts.transverseCurvature();
+    return std::abs(gtp.transverseCurvature() - rho) > theMaxDBzRatio * std::abs(rho);
+  }
+
   /// propagation of errors (if needed) and generation of a new TSOS
   std::pair<TrajectoryStateOnSurface, double> propagatedStateWithPath(const FreeTrajectoryState& fts,
                                                                       const Surface& surface,
@@ -0,0 +1,64 @@
+#ifndef HelixBarrelPlaneCrossingByCircleBatch_H
+#define HelixBarrelPlaneCrossingByCircleBatch_H
+
+#include "TrackingTools/GeomPropagators/interface/HelixPlaneCrossing.h"
+#include "DataFormats/TrajectorySeed/interface/PropagationDirection.h"
+#include "DataFormats/GeometryVector/interface/GlobalPoint.h"
+#include "DataFormats/GeometryVector/interface/GlobalVector.h"
+
+#include <cmath>
+#include <vector>
+
+class Plane;
+
+/** Computes the crossings of many helices with the same barrel plane.
+ *  The arithmetic is the one of HelixBarrelPlaneCrossingByCircle, done on
+ *  structure-of-arrays input in loops without branches, so that the
+ *  compiler can vectorize them.
+ *  Helices for which HelixBarrelPlaneCrossingByCircle would use the straight
+ *  line approximation (see isStraightLine) must not be added.
+ */
+
+class HelixBarrelPlaneCrossingByCircleBatch {
+public:
+  typedef HelixPlaneCrossing::PositionType PositionType;
+  typedef HelixPlaneCrossing::DirectionType DirectionType;
+
+  static bool isStraightLine(const GlobalPoint& pos, double rho) {
+    constexpr double sraightLineCutoff = 1.e-7;
+    return std::abs(rho) < sraightLineCutoff && std::abs(rho) * pos.perp() < sraightLineCutoff;
+  }
+
+  void clear();
+  void reserve(unsigned int n);
+
+  /// Adds a helix starting at pos, distToPlane is -plane.localZ(pos)
+  void push_back(const GlobalPoint& pos, const GlobalVector& dir, double rho, double distToPlane);
+
+  unsigned int size() const { return theX.size(); }
+
+  /// Path lengths of all helices to the plane, which must be parallel to z
+  void pathLengths(const Plane& plane, PropagationDirection propDir);
+
+  /// Only after pathLengths()
+  bool hasSolution(unsigned int i) const { return theSolved[i]; }
+  double pathLength(unsigned int i) const { return theS[i]; }
+  /// Position and direction at the crossing, if hasSolution(i)
+  PositionType position(unsigned int i) const { return PositionType(theXOut[i], theYOut[i], theZOut[i]); }
+  DirectionType direction(unsigned int i) const { return DirectionType(thePxOut[i], thePyOut[i], thePz[i]); }
+
+private:
+  // input
+  std::vector<double> theX, theY, theZ;
+  std::vector<double> thePx, thePy, thePz;
+  std::vector<double> theRho;
+  std::vector<double> theDist;
+
+  // output
+  std::vector<double> theS;
+  std::vector<double> theXOut, theYOut, theZOut;
+  std::vector<double> thePxOut, thePyOut;
+  std::vector<char> theSolved;
+};
+
+#endif
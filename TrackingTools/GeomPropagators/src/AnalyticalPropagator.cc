@@ -11,6 +11,7 @@
 #include "TrackingTools/GeomPropagators/interface/StraightLineBarrelCylinderCrossing.h"
 #include "TrackingTools/GeomPropagators/interface/OptimalHelixPlaneCrossing.h"
 #include "TrackingTools/GeomPropagators/interface/HelixBarrelCylinderCrossing.h"
+#include "TrackingTools/GeomPropagators/interface/HelixBarrelPlaneCrossingByCircleBatch.h"
 #include "TrackingTools/AnalyticalJacobians/interface/AnalyticalCurvilinearJacobian.h"
 #include "TrackingTools/GeomPropagators/interface/PropagationDirectionFromPath.h"
 #include "TrackingTools/TrajectoryState/interface/SurfaceSideDefinition.h"
@@ -20,14 +21,12 @@
 #include "FWCore/Utilities/interface/Likely.h"
 
 #include <cmath>
+#include <vector>
 
 using namespace SurfaceSideDefinition;
 
 std::pair<TrajectoryStateOnSurface, double> AnalyticalPropagator::propagateWithPath(const FreeTrajectoryState& fts,
                                                                                     const Plane& plane) const {
-  // check curvature
-  float rho = fts.transverseCurvature();
-
   // propagate parameters
   GlobalPoint x;
   GlobalVector p;
@@ -39,10 +38,8 @@ std::pair<TrajectoryStateOnSurface, double> AnalyticalPropagator::propagateWithP
       // propagate
       bool parametersOK = this->propagateParametersOnPlane(fts, plane, x, p, s);
       // check status and deltaPhi limit
-      float dphi2 = float(s) * rho;
-      dphi2 = dphi2 * dphi2 * fts.momentum().perp2();
       if
-        UNLIKELY(!parametersOK || dphi2 > theMaxDPhi2 * fts.momentum().mag2())
+        UNLIKELY(!parametersOK || dPhiTooLarge(fts, s))
       return TsosWP(TrajectoryStateOnSurface(), 0.);
     }
   else {
@@ -59,7 +56,7 @@ std::pair<TrajectoryStateOnSurface, double> AnalyticalPropagator::propagateWithP
   //
   GlobalTrajectoryParameters gtp(x, p, fts.charge(), theField);
   if
-    UNLIKELY(std::abs(gtp.transverseCurvature() - rho) > theMaxDBzRatio * std::abs(rho))
+    UNLIKELY(bzChangeTooLarge(fts, gtp))
   return TsosWP(TrajectoryStateOnSurface(), 0.);
   //
   // construct TrajectoryStateOnSurface
@@ -69,9 +66,6 @@ std::pair<TrajectoryStateOnSurface, double> AnalyticalPropagator::propagateWithP
 
 std::pair<TrajectoryStateOnSurface, double> AnalyticalPropagator::propagateWithPath(const FreeTrajectoryState& fts,
                                                                                     const Cylinder& cylinder) const {
-  // check curvature
-  auto rho = fts.transverseCurvature();
-
   // propagate parameters
   GlobalPoint x;
   GlobalVector p;
@@ -79,17 +73,15 @@ std::pair<TrajectoryStateOnSurface, double> AnalyticalPropagator::propagateWithP
 
   bool parametersOK = this->propagateParametersOnCylinder(fts, cylinder, x, p, s);
   // check status and deltaPhi limit
-  float dphi2 = s * rho;
-  dphi2 = dphi2 * dphi2 * fts.momentum().perp2();
   if
-    UNLIKELY(!parametersOK || dphi2 > theMaxDPhi2 * fts.momentum().mag2())
+    UNLIKELY(!parametersOK || dPhiTooLarge(fts, s))
   return TsosWP(TrajectoryStateOnSurface(), 0.);
   //
   // Compute propagated state and check change in curvature
   //
   GlobalTrajectoryParameters gtp(x, p, fts.charge(), theField);
   if
-    UNLIKELY(std::abs(gtp.transverseCurvature() - rho) > theMaxDBzRatio * std::abs(rho))
+    UNLIKELY(bzChangeTooLarge(fts, gtp))
   return TsosWP(TrajectoryStateOnSurface(), 0.);
   //
   // create result TSOS on TangentPlane (local parameters & errors are better defined)
@@ -109,6 +101,70 @@ std::pair<TrajectoryStateOnSurface, double> AnalyticalPropagator::propagateWithP
   */
 }
 
+void AnalyticalPropagator::propagateManyWithPath(const FreeTrajectoryState* fts,
+                                                 unsigned int n,
+                                                 const Plane& plane,
+                                                 std::pair<TrajectoryStateOnSurface, double>* result) const {
+  // only barrel planes (as chosen by OptimalHelixPlaneCrossing) are done in one go
+  constexpr float small = 1.e-6;
+  if (!isOldPropagationType || std::abs(plane.normalVector().z()) >= small) {
+    for (unsigned int i = 0; i < n; ++i)
+      result[i] = propagateWithPath(fts[i], plane);
+    return;
+  }
+
+  HelixBarrelPlaneCrossingByCircleBatch crossing;
+  crossing.reserve(n);
+  std::vector<unsigned int> index;
+  index.reserve(n);
+  for (unsigned int i = 0; i < n; ++i) {
+    // states already on the plane or on a straight line take the single state path
+    auto const& pos = fts[i].position();
+    auto rho = fts[i].transverseCurvature();
+    if (plane.localZclamped(pos) == 0 || std::abs(rho) < 1.e-10f ||
+        HelixBarrelPlaneCrossingByCircleBatch::isStraightLine(pos, rho)) {
+      result[i] = propagateWithPath(fts[i], plane);
+      continue;
+    }
+    index.push_back(i);
+    crossing.push_back(pos, fts[i].momentum(), rho, -plane.localZ(pos));
+  }
+  crossing.pathLengths(plane, propagationDirection());
+
+  const unsigned int nHelix = index.size();
+  std::vector<GlobalPoint> x(nHelix);
+  std::vector<GlobalVector> p(nHelix);
+  for (unsigned int j = 0; j < nHelix; ++j) {
+    auto const& state = fts[index[j]];
+    if (!crossing.hasSolution(j)) {
+      x[j] = state.position();
+      continue;
+    }
+    x[j] = GlobalPoint(crossing.position(j));
+    // direction (reconverted to GlobalVector, renormalised)
+    GlobalVector pGen = GlobalVector(crossing.direction(j));
+    pGen *= state.momentum().mag() / pGen.mag();
+    p[j] = pGen;
+  }
+  std::vector<GlobalVector> field(nHelix);
+  theField->inTeslaBatch(x.data(), field.data(), nHelix);
+
+  for (unsigned int j = 0; j < nHelix; ++j) {
+    auto const& state = fts[index[j]];
+    double s = crossing.pathLength(j);
+    if (!crossing.hasSolution(j) || dPhiTooLarge(state, s)) {
+      result[index[j]] = TsosWP(TrajectoryStateOnSurface(), 0.);
+      continue;
+    }
+    GlobalTrajectoryParameters gtp(x[j], p[j], state.charge(), theField, field[j]);
+    if (bzChangeTooLarge(state, gtp)) {
+      result[index[j]] = TsosWP(TrajectoryStateOnSurface(), 0.);
+      continue;
+    }
+    result[index[j]] = propagatedStateWithPath(state, plane, gtp, s);
+  }
+}
+
 std::pair<TrajectoryStateOnSurface, double> AnalyticalPropagator::propagatedStateWithPath(
     const FreeTrajectoryState& fts,
     const Surface& surface,
@@ -0,0 +1,134 @@
+#include "TrackingTools/GeomPropagators/interface/HelixBarrelPlaneCrossingByCircleBatch.h"
+#include "DataFormats/GeometrySurface/interface/Plane.h"
+
+#include <algorithm>
+#include <cmath>
+
+void HelixBarrelPlaneCrossingByCircleBatch::clear() {
+  for (auto* v : {&theX, &theY, &theZ, &thePx, &thePy, &thePz, &theRho, &theDist})
+    v->clear();
+}
+
+void HelixBarrelPlaneCrossingByCircleBatch::reserve(unsigned int n) {
+  for (auto* v : {&theX, &theY, &theZ, &thePx, &thePy, &thePz, &theRho, &theDist})
+    v->reserve(n);
+}
+
+void HelixBarrelPlaneCrossingByCircleBatch::push_back(const GlobalPoint& pos,
+                                                      const GlobalVector& dir,
+                                                      double rho,
+                                                      double distToPlane) {
+  theX.push_back(pos.x());
+  theY.push_back(pos.y());
+  theZ.push_back(pos.z());
+  thePx.push_back(dir.x());
+  thePy.push_back(dir.y());
+  thePz.push_back(dir.z());
+  theRho.push_back(rho);
+  theDist.push_back(distToPlane);
+}
+
+void HelixBarrelPlaneCrossingByCircleBatch::pathLengths(const Plane& plane, PropagationDirection propDir) {
+  const unsigned int n = size();
+  theS.resize(n);
+  theXOut.resize(n);
+  theYOut.resize(n);
+  theZOut.resize(n);
+  thePxOut.resize(n);
+  thePyOut.resize(n);
+  theSolved.resize(n);
+
+  // the plane orientation is common to all helices, so is the choice of the coordinate to solve for
+  GlobalVector normal = plane.normalVector();
+  const double nx = normal.x();
+  const double ny = normal.y();
+  const bool solveForX = !(std::abs(nx) > std::abs(ny));
+  const double nfac = solveForX ? nx / ny : ny / nx;
+  const double nInv = solveForX ? 1. / ny : 1. / nx;
+  const double A = 1. + nfac * nfac;
+  const bool anyDir = propDir == anyDirection;
+  const double propSign = propDir == alongMomentum ? 1. : -1.;
+
+  const double* __restrict__ x = theX.data();
+  const double* __restrict__ y = theY.data();
+  const double* __restrict__ z = theZ.data();
+  const double* __restrict__ px = thePx.data();
+  const double* __restrict__ py = thePy.data();
+  const double* __restrict__ pz = thePz.data();
+  const double* __restrict__ rho = theRho.data();
+  const double* __restrict__ dist = theDist.data();
+  double* __restrict__ sOut = theS.data();
+  double* __restrict__ xOut = theXOut.data();
+  double* __restrict__ yOut = theYOut.data();
+  double* __restrict__ zOut = theZOut.data();
+  double* __restrict__ pxOut = thePxOut.data();
+  double* __restrict__ pyOut = thePyOut.data();
+  char* __restrict__ solvedOut = theSolved.data();
+
+  for (unsigned int i = 0; i < n; ++i) {
+    // in single precision, as Basic3DVector<float>::perp() and mag()
+    const float pxf = px[i], pyf = py[i], pzf = pz[i];
+    const double pt = std::sqrt(pxf * pxf + pyf * pyf);
+    const double pabsI = 1. / std::sqrt(pxf * pxf + pyf * pyf + pzf * pzf);
+    const double cosTheta = pz[i] * pabsI;
+    const double sinTheta = pt * pabsI;
+
+    // centre of curvature, see HelixBarrelPlaneCrossingByCircle::init()
+    const double o = 1. / (pt * rho[i]);
+    const double distCx = x[i] - (x[i] - py[i] * o);
+    const double distCy = y[i] - (y[i] + px[i] * o);
+
+    const double distU = solveForX ? distCy : distCx;  // coordinate derived from the solution
+    const double distV = solveForX ? distCx : distCy;  // coordinate solved for
+    const double dfac = dist[i] * nInv;
+    double B = distV - nfac * distU;
+    const double C = (2. * distU + dfac) * dfac;
+    B -= nfac * dfac;
+    B *= 2;
+
+    // RealQuadEquation
+    const double D = B * B - 4 * A * C;
+    const bool hasSolution = D >= 0;
+    const double q = -0.5 * (B + std::copysign(std::sqrt(std::max(D, 0.)), B));
+    const double v1 = q / A;
+    const double v2 = C / q;
+    const double u1 = dfac - nfac * v1;
+    const double u2 = dfac - nfac * v2;
+    const double dx1 = solveForX ? v1 : u1;
+    const double dy1 = solveForX ? u1 : v1;
+    const double dx2 = solveForX ? v2 : u2;
+    const double dy2 = solveForX ? u2 : v2;
+
+    // HelixBarrelPlaneCrossingByCircle::chooseSolution
+    const double momProj1 = px[i] * dx1 + py[i] * dy1;
+    const double momProj2 = px[i] * dx2 + py[i] * dy2;
+    const bool firstShorter = dx1 * dx1 + dy1 * dy1 < dx2 * dx2 + dy2 * dy2;
+    const bool sign1 = std::signbit(momProj1);
+    const bool sign2 = std::signbit(momProj2);
+    const bool signProp = std::signbit(propSign);
+    const bool differentSigns = sign1 != sign2;
+    const bool takeFirst = anyDir ? firstShorter : (differentSigns ? sign1 == signProp : firstShorter);
+    const bool solved = hasSolution && (anyDir || differentSigns || sign1 == signProp);
+    const double dx = takeFirst ? dx1 : dx2;
+    const double dy = takeFirst ? dy1 : dy2;
+    const double actualDir = anyDir ? ((takeFirst ? momProj1 : momProj2) > 0 ? 1. : -1.) : propSign;
+
+    const double dmag = std::sqrt(dx * dx + dy * dy);
+    const double sinAlpha = std::clamp(0.5 * dmag * rho[i], -1., 1.);
+    const double s = actualDir * 2. / (rho[i] * sinTheta) * std::asin(sinAlpha);
+
+    // HelixBarrelPlaneCrossingByCircle::direction(theS)
+    double tmp = 0.5 * dmag * rho[i];
+    tmp = s < 0 ? -tmp : tmp;
+    const double sinPhi = 2. * tmp * std::sqrt(std::max(1. - tmp * tmp, 0.));
+    const double cosPhi = 1. - 2. * (tmp * tmp);
+
+    solvedOut[i] = solved;
+    sOut[i] = solved ? s : 0.;
+    xOut[i] = x[i] + dx;
+    yOut[i] = y[i] + dy;
+    zOut[i] = z[i] + s * cosTheta;
+    pxOut[i] = px[i] * cosPhi - py[i] * sinPhi;
+    pyOut[i] = px[i] * sinPhi + py[i] * cosPhi;
+  }
+}
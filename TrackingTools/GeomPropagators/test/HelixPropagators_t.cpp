@@ -2,11 +2,13 @@
 #include "DataFormats/GeometrySurface/interface/Plane.h"
 #include "TrackingTools/GeomPropagators/interface/HelixBarrelPlaneCrossing2OrderLocal.h"
 #include "TrackingTools/GeomPropagators/interface/HelixBarrelPlaneCrossingByCircle.h"
+#include "TrackingTools/GeomPropagators/interface/HelixBarrelPlaneCrossingByCircleBatch.h"
 #include "TrackingTools/GeomPropagators/interface/OptimalHelixPlaneCrossing.h"
 
 #include <algorithm>
 #include <cmath>
 #include <tuple>
+#include <vector>
 
 #include <iostream>
 
@@ -188,8 +190,61 @@ void testHelixBarrelPlaneCrossing2OrderLocal() {
   crossing3();
 }
 
+// the batch must give the same crossings as HelixBarrelPlaneCrossingByCircle
+bool crossingBatch() {
+  constexpr double phi = 1.2;
+  GlobalPoint pos(82. * std::cos(phi), 82. * std::sin(phi), 10.);
+  Surface::RotationType rot(-std::sin(phi), std::cos(phi), 0, 0, 0, 1, std::cos(phi), std::sin(phi), 0);
+  Plane plane(pos, rot);
+
+  std::vector<std::tuple<GlobalPoint, GlobalVector, double>> helices;
+  for (double dphi : {-0.2, 0., 0.15})
+    for (double pt : {0.5, 1., 10.})
+      for (double rho : {-0.003, 0.0005, 0.00223254}) {
+        GlobalPoint start(30. * std::cos(phi + dphi), 30. * std::sin(phi + dphi), -5.);
+        GlobalVector dir(pt * std::cos(phi + 2 * dphi), pt * std::sin(phi + 2 * dphi), 0.7 * pt);
+        helices.emplace_back(start, dir, rho / pt);
+      }
+  // one going away from the plane
+  helices.emplace_back(GlobalPoint(30. * std::cos(phi), 30. * std::sin(phi), 0.),
+                       GlobalVector(-std::cos(phi), -std::sin(phi), 0.),
+                       0.0001);
+
+  bool ok = true;
+  for (auto propDir : {alongMomentum, oppositeToMomentum, anyDirection}) {
+    HelixBarrelPlaneCrossingByCircleBatch batch;
+    for (auto const& h : helices)
+      batch.push_back(std::get<0>(h), std::get<1>(h), std::get<2>(h), -plane.localZ(std::get<0>(h)));
+    batch.pathLengths(plane, propDir);
+
+    for (unsigned int i = 0; i < helices.size(); ++i) {
+      auto const& h = helices[i];
+      HelixBarrelPlaneCrossingByCircle precise(std::get<0>(h), std::get<1>(h), std::get<2>(h), propDir);
+      bool cross;
+      double s;
+      std::tie(cross, s) = precise.pathLength(plane);
+      if (cross != batch.hasSolution(i)) {
+        std::cout << "batch crossing " << i << " solution mismatch " << cross << std::endl;
+        ok = false;
+        continue;
+      }
+      if (!cross)
+        continue;
+      auto dpos = (precise.position(s) - batch.position(i)).mag();
+      auto ddir = (precise.direction(s) - batch.direction(i)).mag() / precise.direction(s).mag();
+      if (std::abs(s - batch.pathLength(i)) > 1.e-6 * std::max(1., std::abs(s)) || dpos > 1.e-6 || ddir > 1.e-9) {
+        std::cout << "batch crossing " << i << " differs: s " << s << ' ' << batch.pathLength(i) << " position "
+                  << dpos << " direction " << ddir << std::endl;
+        ok = false;
+      }
+    }
+  }
+  std::cout << "batch crossing " << (ok ? "OK" : "FAILED") << std::endl;
+  return ok;
+}
+
 int main() {
   testHelixBarrelPlaneCrossing2OrderLocal();
 
-  return 0;
+  return crossingBatch() ? 0 : 1;
 }
@@ -30,7 +30,7 @@ public:
 
   void rescaleError(double factor);
 
-  pointer clone() const override { return build<BasicMultiTrajectoryState>(*this); }
+  pointer clone() const override { return churn<BasicMultiTrajectoryState>(*this); }
 
   using Components = BasicTrajectoryState::Components;
   Components const& components() const override { return theStates; }
@@ -0,0 +1,67 @@
+#ifndef FixedCapacityMixture_H_
+#define FixedCapacityMixture_H_
+
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <array>
+
+/** \class FixedCapacityMixture
+ *  Container for the components of a Gaussian mixture (or for per-component
+ *  quantities) with a maximum number of components fixed at compile time.
+ *  The components are stored in place, so a mixture living on the stack
+ *  does not allocate. Growing beyond the capacity throws.
+ */
+
+template <typename T, unsigned int MaxComponents>
+class FixedCapacityMixture {
+public:
+  typedef T value_type;
+  typedef T* iterator;
+  typedef const T* const_iterator;
+
+  FixedCapacityMixture() : theSize(0) {}
+  /// Mixture of n default-constructed components
+  explicit FixedCapacityMixture(unsigned int n) : theSize(0) { resize(n); }
+
+  static constexpr unsigned int capacity() { return MaxComponents; }
+  unsigned int size() const { return theSize; }
+  bool empty() const { return theSize == 0; }
+
+  T& operator[](unsigned int i) { return theComponents[i]; }
+  const T& operator[](unsigned int i) const { return theComponents[i]; }
+
+  T* data() { return theComponents.data(); }
+  const T* data() const { return theComponents.data(); }
+
+  iterator begin() { return theComponents.data(); }
+  iterator end() { return theComponents.data() + theSize; }
+  const_iterator begin() const { return theComponents.data(); }
+  const_iterator end() const { return theComponents.data() + theSize; }
+
+  void push_back(const T& component) {
+    checkCapacity(theSize + 1);
+    theComponents[theSize++] = component;
+  }
+
+  /// Resizes to n components; the added ones are reset to default-constructed ones
+  void resize(unsigned int n) {
+    checkCapacity(n);
+    for (unsigned int i = theSize; i < n; ++i)
+      theComponents[i] = T();
+    theSize = n;
+  }
+
+  void clear() { theSize = 0; }
+
+private:
+  static void checkCapacity(unsigned int n) {
+    if (n > MaxComponents)
+      throw cms::Exception("LogicError") << "FixedCapacityMixture: " << n << " components requested, the capacity is "
+                                         << MaxComponents;
+  }
+
+  std::array<T, MaxComponents> theComponents;
+  unsigned int theSize;
+};
+
+#endif
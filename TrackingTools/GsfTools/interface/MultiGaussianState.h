@@ -128,6 +128,8 @@ public:
 
   SingleStatePtr combine(const MultiState& theState) const;
   SingleStatePtr combine(const VSC& theComponents) const;
+  /// same as above for a mixture of two components, without building a container
+  SingleStatePtr combine(const SingleState& first, const SingleState& second) const;
 };
 
 #include "TrackingTools/GsfTools/interface/MultiGaussianStateCombiner.icc"
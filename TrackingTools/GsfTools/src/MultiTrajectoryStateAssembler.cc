@@ -30,8 +30,7 @@ void MultiTrajectoryStateAssembler::addState(const TrajectoryStateOnSurface tsos
   // Add components (i.e. state to be added can be single or multi state)
   //
   GetComponents comps(tsos);
-  MultiTSOS components(comps());
-  addStateVector(components);
+  addStateVector(comps());
 }
 
 void MultiTrajectoryStateAssembler::addStateVector(const MultiTSOS &states) {
@@ -83,7 +82,7 @@ TrajectoryStateOnSurface MultiTrajectoryStateAssembler::combinedState() {
   //
   // Return new multi state without reweighting
   //
-  return TSOS((BasicTrajectoryState *)(new BasicMultiTrajectoryState(theStates)));
+  return TSOS(BasicTrajectoryState::churn<BasicMultiTrajectoryState>(theStates));
 }
 
 TrajectoryStateOnSurface MultiTrajectoryStateAssembler::combinedState(const float newWeight) {
@@ -160,7 +159,7 @@ TrajectoryStateOnSurface MultiTrajectoryStateAssembler::reweightedCombinedState(
                                   &(is.globalParameters().magneticField()),
                                   is.surfaceSide());
   }
-  return TSOS((BasicTrajectoryState *)(new BasicMultiTrajectoryState(reweightedStates)));
+  return TSOS(BasicTrajectoryState::churn<BasicMultiTrajectoryState>(reweightedStates));
 }
 
 void MultiTrajectoryStateAssembler::removeSmallWeights() {
@@ -90,7 +90,7 @@ TrajectoryStateOnSurface MultiTrajectoryStateTransform::stateOnSurface(const std
     // create component
     components.push_back(TrajectoryStateOnSurface(weights[i], lp, le, surface, field));
   }
-  return TrajectoryStateOnSurface((BasicTrajectoryState*)(new BasicMultiTrajectoryState(components)));
+  return TrajectoryStateOnSurface(BasicTrajectoryState::churn<BasicMultiTrajectoryState>(components));
 }
 
 bool MultiTrajectoryStateTransform::checkGeometry() const {
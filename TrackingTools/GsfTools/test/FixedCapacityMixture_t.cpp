@@ -0,0 +1,44 @@
+#include "TrackingTools/GsfTools/interface/FixedCapacityMixture.h"
+
+#include <cassert>
+#include <iostream>
+
+namespace {
+  struct Component {
+    float weight = 1.f;
+    float mean = 0.f;
+  };
+}  // namespace
+
+int main() {
+  FixedCapacityMixture<Component, 4> mixture(3);
+  assert(mixture.size() == 3);
+  assert(mixture.capacity() == 4);
+  for (auto const& c : mixture)
+    assert(c.weight == 1.f && c.mean == 0.f);
+
+  mixture[1].weight = 0.5f;
+  mixture.push_back(Component{0.25f, 2.f});
+  assert(mixture.size() == 4);
+  assert(mixture[3].mean == 2.f);
+
+  bool thrown = false;
+  try {
+    mixture.push_back(Component());
+  } catch (cms::Exception const&) {
+    thrown = true;
+  }
+  assert(thrown);
+  assert(mixture.size() == 4);
+
+  // components added back by resize are default ones again
+  mixture.resize(1);
+  mixture.resize(2);
+  assert(mixture[1].weight == 1.f);
+
+  mixture.clear();
+  assert(mixture.empty() && mixture.begin() == mixture.end());
+
+  std::cout << "FixedCapacityMixture_t passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,55 @@
+#include "TrackingTools/GsfTools/interface/MultiGaussianState.h"
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <memory>
+
+typedef SingleGaussianState<5> GS;
+typedef GS::Vector Vector;
+typedef GS::Matrix Matrix;
+typedef MultiGaussianStateCombiner<5> Combiner;
+typedef MultiGaussianState<5>::SingleStateContainer VSC;
+
+namespace {
+  bool close(double a, double b) { return std::abs(a - b) <= 1.e-12 * std::max(1., std::abs(a) + std::abs(b)); }
+
+  bool sameState(const GS& a, const GS& b) {
+    if (!close(a.weight(), b.weight()))
+      return false;
+    for (unsigned int i = 0; i < 5; ++i) {
+      if (!close(a.mean()(i), b.mean()(i)))
+        return false;
+      for (unsigned int j = 0; j <= i; ++j)
+        if (!close(a.covariance()(i, j), b.covariance()(i, j)))
+          return false;
+    }
+    return true;
+  }
+}  // namespace
+
+int main() {
+  Matrix cov1(ROOT::Math::SMatrixIdentity());
+  Matrix cov2(ROOT::Math::SMatrixIdentity());
+  cov2 *= 2.;
+  cov2(0, 3) = 0.3;
+  cov2(1, 4) = -0.2;
+
+  auto gs1 = std::make_shared<GS>(Vector(1., 0.5, -0.2, 0.01, 0.3), cov1, 0.7);
+  auto gs2 = std::make_shared<GS>(Vector(0.8, 0.4, -0.1, 0.02, 0.1), cov2, 0.2);
+
+  VSC comps{gs1, gs2};
+  auto general = Combiner().combine(comps);
+  auto pair = Combiner().combine(*gs1, *gs2);
+
+  std::cout << "weights " << general->weight() << " " << pair->weight() << std::endl;
+  std::cout << "means " << general->mean() << " " << pair->mean() << std::endl;
+  assert(sameState(*general, *pair));
+
+  // zero total weight
+  auto gs0 = std::make_shared<GS>(Vector(1., 1., 1., 1., 1.), cov1, 0.);
+  VSC zero{gs0, gs0};
+  assert(sameState(*Combiner().combine(zero), *Combiner().combine(*gs0, *gs0)));
+
+  return 0;
+}
@@ -22,30 +22,32 @@ private:
   static constexpr int MaxSize = 6;
   static constexpr int MaxOrder = 6;
 
-  /** Helper class for construction & evaluation of a polynomial
+  /** Helper class for construction & evaluation of the polynomials
+   *  of one mixture parameter for all components.
+   *  The coefficients are stored by power (zero-padded to MaxOrder) so that
+   *  all components are evaluated together in a loop of fixed length.
    */
-  class Polynomial {
+  class Polynomials {
   public:
-    /// Default constructor (needed for construction of a vector)
-    Polynomial() {}
-    /** Constructor from a vector of coefficients
+    /** Sets the coefficients of one component
      *  (in decreasing order of powers of x)
      */
-    Polynomial(float coefficients[], int is) : m_size(is) {
-      for (int i = 0; i != m_size; ++i)
-        theCoeffs[i] = coefficients[i];
+    void set(int component, const float coefficients[], int is) {
+      for (int i = 0; i != is; ++i)
+        theCoeffs[MaxOrder - is + i][component] = coefficients[i];
     }
-    /// Evaluation of the polynomial
-    float operator()(float x) const {
-      float sum = theCoeffs[0];
-      for (int i = 1; i != m_size; ++i)
-        sum = x * sum + theCoeffs[i];
-      return sum;
+    /// Evaluation of the polynomials of all components
+    void operator()(float x, float result[MaxSize]) const {
+      float sum[MaxSize] = {0};
+      for (int k = 0; k != MaxOrder; ++k)
+        for (int i = 0; i != MaxSize; ++i)
+          sum[i] = x * sum[i] + theCoeffs[k][i];
+      for (int i = 0; i != MaxSize; ++i)
+        result[i] = sum[i];
     }
 
   private:
-    float theCoeffs[MaxOrder] = {0};
-    int m_size = 0;
+    float theCoeffs[MaxOrder][MaxSize] = {{0}};
   };
 
 public:
@@ -69,8 +71,8 @@ private:
 private:
   /// Read parametrization from file
   void readParameters(const std::string);
-  /// Read coefficients of one polynomial from file
-  Polynomial readPolynomial(std::ifstream &, const unsigned int);
+  /// Read coefficients of the polynomial of one component from file
+  void readPolynomial(std::ifstream &, const unsigned int, Polynomials &, const int);
 
   /// Filling of mixture (in terms of z=E/E0)
   void getMixtureParameters(const float, GSContainer &) const;
@@ -86,9 +88,9 @@ private:
   int theTransformationCode;  /// values to be transformed by logistic / exp. function?
   int theCorrectionFlag;      /// correction of 1st or 1st&2nd moments
 
-  Polynomial thePolyWeights[MaxSize];  /// parametrisation of weight for each component
-  Polynomial thePolyMeans[MaxSize];    /// parametrisation of mean for each componentP
-  Polynomial thePolyVars[MaxSize];     /// parametrisation of variance for each component
+  Polynomials thePolyWeights;  /// parametrisation of weight for each component
+  Polynomials thePolyMeans;    /// parametrisation of mean for each component
+  Polynomials thePolyVars;     /// parametrisation of variance for each component
 };
 
 #endif
@@ -5,6 +5,8 @@
 #include "TrackingTools/TrajectoryState/interface/TrajectoryStateOnSurface.h"
 #include "DataFormats/TrajectorySeed/interface/PropagationDirection.h"
 #include "DataFormats/GeometrySurface/interface/Surface.h"
+#include "TrackingTools/GsfTools/interface/FixedCapacityMixture.h"
+#include "FWCore/Utilities/interface/Exception.h"
 #include <cstdint>
 
 #include "FWCore/Utilities/interface/GCC11Compatibility.h"
@@ -20,9 +22,13 @@ public:
   typedef materialEffect::Effect Effect;
   typedef materialEffect::CovIndex CovIndex;
 
+  /// Maximum number of components (6 for energy loss times 2 for multiple scattering)
+  static constexpr uint32_t MaxSize = 12;
+  typedef FixedCapacityMixture<Effect, MaxSize> Effects;
+
   /** Constructor with explicit mass hypothesis
    */
-  GsfMaterialEffectsUpdator(float mass, uint32_t is) : theMass(mass), m_size(is) {}
+  GsfMaterialEffectsUpdator(float mass, uint32_t is) : theMass(mass), m_size(is) { checkSize(is); }
 
   virtual ~GsfMaterialEffectsUpdator() {}
 
@@ -44,9 +50,18 @@ public:
   size_t size() const { return m_size; }
 
 protected:
-  void resize(size_t is) { m_size = is; }
+  void resize(size_t is) {
+    checkSize(is);
+    m_size = is;
+  }
 
 private:
+  static void checkSize(size_t is) {
+    if (is > MaxSize)
+      throw cms::Exception("LogicError") << "GsfMaterialEffectsUpdator: " << is << " components, at most " << MaxSize
+                                         << " are supported";
+  }
+
   float theMass;
   uint32_t m_size;
 };
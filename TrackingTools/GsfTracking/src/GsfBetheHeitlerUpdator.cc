@@ -58,7 +58,6 @@ GsfBetheHeitlerUpdator::GsfBetheHeitlerUpdator(const std::string fileName, const
     edm::LogInfo("GsfBetheHeitlerUpdator") << "1st and 2nd moments of mixture will be corrected";
 
   readParameters(fileName);
-  assert(theNrComponents <= 6);
   resize(theNrComponents);
 }
 
@@ -76,21 +75,24 @@ void GsfBetheHeitlerUpdator::readParameters(const std::string fileName) {
   ifs >> orderP;
   ifs >> theTransformationCode;
 
+  assert(theNrComponents <= MaxSize);
   assert(orderP < MaxOrder);
 
   for (int ic = 0; ic != theNrComponents; ++ic) {
-    thePolyWeights[ic] = readPolynomial(ifs, orderP);
-    thePolyMeans[ic] = readPolynomial(ifs, orderP);
-    thePolyVars[ic] = readPolynomial(ifs, orderP);
+    readPolynomial(ifs, orderP, thePolyWeights, ic);
+    readPolynomial(ifs, orderP, thePolyMeans, ic);
+    readPolynomial(ifs, orderP, thePolyVars, ic);
   }
 }
 
-GsfBetheHeitlerUpdator::Polynomial GsfBetheHeitlerUpdator::readPolynomial(std::ifstream& aStream,
-                                                                          const unsigned int order) {
-  float coeffs[order + 1];
+void GsfBetheHeitlerUpdator::readPolynomial(std::ifstream& aStream,
+                                            const unsigned int order,
+                                            Polynomials& polynomials,
+                                            const int component) {
+  float coeffs[MaxOrder];
   for (unsigned int i = 0; i < (order + 1); ++i)
     aStream >> coeffs[i];
-  return Polynomial(coeffs, order + 1);
+  polynomials.set(component, coeffs, order + 1);
 }
 
 void GsfBetheHeitlerUpdator::compute(const TrajectoryStateOnSurface& TSoS,
@@ -123,7 +125,7 @@ void GsfBetheHeitlerUpdator::compute(const TrajectoryStateOnSurface& TSoS,
     if (rl > 0.20f)
       rl = 0.20f;
 
-    float mixtureData[3][theNrComponents];
+    float mixtureData[3][MaxSize];
     GSContainer mixture{mixtureData[0], mixtureData[1], mixtureData[2]};
 
     getMixtureParameters(rl, mixture);
@@ -163,12 +165,10 @@ void GsfBetheHeitlerUpdator::compute(const TrajectoryStateOnSurface& TSoS,
 // Mixture parameters (in z)
 //
 void GsfBetheHeitlerUpdator::getMixtureParameters(const float rl, GSContainer& mixture) const {
-  float weight[theNrComponents], z[theNrComponents], vz[theNrComponents];
-  for (int i = 0; i < theNrComponents; i++) {
-    weight[i] = thePolyWeights[i](rl);
-    z[i] = thePolyMeans[i](rl);
-    vz[i] = thePolyVars[i](rl);
-  }
+  float weight[MaxSize], z[MaxSize], vz[MaxSize];
+  thePolyWeights(rl, weight);
+  thePolyMeans(rl, z);
+  thePolyVars(rl, vz);
   if (theTransformationCode)
     for (int i = 0; i < theNrComponents; i++) {
       mixture.first[i] = logisticFunction(weight[i]);
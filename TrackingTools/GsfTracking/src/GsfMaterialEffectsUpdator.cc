@@ -27,13 +27,8 @@ TrajectoryStateOnSurface GsfMaterialEffectsUpdator::updateState(const Trajectory
 //
 // Get components (will force recalculation, if necessary)
 //
-#if __clang__
-  std::vector<Effect> effects(size());
+  Effects effects(size());
   compute(TSoS, propDir, effects.data());
-#else
-  Effect effects[size()];
-  compute(TSoS, propDir, effects);
-#endif
 
   //
   // prepare output vector
@@ -47,6 +47,6 @@ namespace GaussianStateConversions {
                               field,
                               side);
     }
-    return TrajectoryStateOnSurface((BasicTrajectoryState*)new BasicMultiTrajectoryState(components));
+    return TrajectoryStateOnSurface(BasicTrajectoryState::churn<BasicMultiTrajectoryState>(components));
   }
 }  // namespace GaussianStateConversions
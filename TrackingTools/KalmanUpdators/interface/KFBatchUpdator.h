@@ -0,0 +1,263 @@
+#ifndef TrackingTools_KalmanUpdators_KFBatchUpdator_h
+#define TrackingTools_KalmanUpdators_KFBatchUpdator_h
+
+/** \class KFBatchUpdator
+ * Chi2 estimation and Kalman update of many (predicted state, hit) pairs at once.
+ *
+ * The pairs are stored as structure of arrays (kfbatch::SoA) and processed W
+ * at a time using compiler vector extensions; W = 1 gives the scalar version.
+ * The arithmetic is the one of Chi2MeasurementEstimator and of KFUpdator
+ * (Joseph form), so results agree with them up to rounding.
+ *
+ * Only hits measuring the local position (x for D=1, x and y for D=2) are
+ * supported, which covers strip and pixel hits. push_back returns false for
+ * any other hit; those must go through KFUpdator / Chi2MeasurementEstimator.
+ *
+ * Usage:
+ *   KFBatchUpdator<2> batch;
+ *   for (...) batch.push_back(tsos, hit);
+ *   batch.update();   // or estimate() for the chi2 only
+ *   for (unsigned int i = 0; i < batch.size(); ++i)
+ *     if (batch.valid(i) && batch.chi2(i) < cut) use(batch.updatedState(i));
+ */
+
+#include "TrackingTools/TrajectoryState/interface/TrajectoryStateOnSurface.h"
+#include "DataFormats/Math/interface/ExtVec.h"
+
+#include <cstring>
+#include <vector>
+
+class TrackingRecHit;
+
+namespace kfbatch {
+
+  // position of element (i,j) in the packed lower triangle used by ROOT::Math::MatRepSym
+  constexpr unsigned int symIndex(unsigned int i, unsigned int j) {
+    return i >= j ? i * (i + 1) / 2 + j : j * (j + 1) / 2 + i;
+  }
+
+#if defined(__AVX__)
+  constexpr int defaultWidth = 4;
+#else
+  constexpr int defaultWidth = 2;
+#endif
+
+  template <typename T, int W>
+  struct Lanes {
+    using type = ExtVec<T, W>;
+  };
+  template <typename T>
+  struct Lanes<T, 1> {
+    using type = T;
+  };
+
+  template <typename V, typename T>
+  inline V load(T const* p) {
+    V v;
+    std::memcpy(&v, p, sizeof(V));
+    return v;
+  }
+  template <typename V, typename T>
+  inline void store(T* p, V const& v) {
+    std::memcpy(p, &v, sizeof(V));
+  }
+
+  template <unsigned int D, typename T = double>
+  struct SoA {
+    static constexpr unsigned int nMeasErr = D * (D + 1) / 2;
+
+    void resize(unsigned int n) {
+      for (auto& a : x)
+        a.resize(n);
+      for (auto& a : c)
+        a.resize(n);
+      for (auto& a : m)
+        a.resize(n);
+      for (auto& a : v)
+        a.resize(n);
+      chi2.resize(n);
+      det.resize(n);
+    }
+    void reserve(unsigned int n) {
+      for (auto& a : x)
+        a.reserve(n);
+      for (auto& a : c)
+        a.reserve(n);
+      for (auto& a : m)
+        a.reserve(n);
+      for (auto& a : v)
+        a.reserve(n);
+      chi2.reserve(n);
+      det.reserve(n);
+    }
+    unsigned int size() const { return chi2.size(); }
+
+    std::vector<T> x[5];         // local parameters, predicted then filtered
+    std::vector<T> c[15];        // local covariance (packed lower triangle), predicted then filtered
+    std::vector<T> m[D];         // measured local position
+    std::vector<T> v[nMeasErr];  // and its covariance
+    std::vector<T> chi2;
+    std::vector<T> det;  // determinant of the residual covariance, not positive if it could not be inverted
+  };
+
+  // inverse of the residual covariance, returns its determinant
+  template <unsigned int D, typename T, typename V>
+  inline V invert(V const* R, V* Ri) {
+    static_assert(D == 1 or D == 2, "only 1D and 2D measurements are supported");
+    if constexpr (D == 1) {
+      Ri[0] = T(1) / R[0];
+      return R[0];
+    } else {
+      V det = R[0] * R[2] - R[1] * R[1];
+      V idet = T(1) / det;
+      Ri[0] = R[2] * idet;
+      Ri[1] = -R[1] * idet;
+      Ri[2] = R[0] * idet;
+      return det;
+    }
+  }
+
+  // chi2, and if Update the filtered state, for the W pairs starting at k
+  template <unsigned int D, bool Update, typename V, typename T>
+  inline void kernel(SoA<D, T>& s, unsigned int k) {
+    constexpr unsigned int nR = SoA<D, T>::nMeasErr;
+    V r[D], R[nR], Ri[nR], Vm[nR];
+    for (unsigned int a = 0; a < D; ++a)
+      r[a] = load<V>(&s.m[a][k]) - load<V>(&s.x[3 + a][k]);
+    for (unsigned int a = 0; a < D; ++a)
+      for (unsigned int b = 0; b <= a; ++b) {
+        Vm[symIndex(a, b)] = load<V>(&s.v[symIndex(a, b)][k]);
+        R[symIndex(a, b)] = load<V>(&s.c[symIndex(3 + a, 3 + b)][k]) + Vm[symIndex(a, b)];
+      }
+    store(&s.det[k], invert<D, T>(R, Ri));
+
+    // Ri * r
+    V Rir[D];
+    for (unsigned int a = 0; a < D; ++a) {
+      Rir[a] = Ri[symIndex(a, 0)] * r[0];
+      for (unsigned int b = 1; b < D; ++b)
+        Rir[a] += Ri[symIndex(a, b)] * r[b];
+    }
+    V chi2 = r[0] * Rir[0];
+    for (unsigned int a = 1; a < D; ++a)
+      chi2 += r[a] * Rir[a];
+    store(&s.chi2[k], chi2);
+
+    if constexpr (Update) {
+      V C[15];
+      for (unsigned int i = 0; i < 15; ++i)
+        C[i] = load<V>(&s.c[i][k]);
+
+      // gain K = C H^T Ri
+      V K[5][D];
+      for (unsigned int i = 0; i < 5; ++i)
+        for (unsigned int a = 0; a < D; ++a) {
+          K[i][a] = C[symIndex(i, 3)] * Ri[symIndex(0, a)];
+          for (unsigned int b = 1; b < D; ++b)
+            K[i][a] += C[symIndex(i, 3 + b)] * Ri[symIndex(b, a)];
+        }
+
+      // x + K r = x + C H^T Ri r
+      for (unsigned int i = 0; i < 5; ++i) {
+        V x = load<V>(&s.x[i][k]);
+        for (unsigned int a = 0; a < D; ++a)
+          x += C[symIndex(i, 3 + a)] * Rir[a];
+        store(&s.x[i][k], x);
+      }
+
+      // Joseph form: (I - K H) C (I - K H)^T + K Vm K^T
+      V MC[5][5];
+      for (unsigned int i = 0; i < 5; ++i)
+        for (unsigned int j = 0; j < 5; ++j) {
+          MC[i][j] = C[symIndex(i, j)];
+          for (unsigned int a = 0; a < D; ++a)
+            MC[i][j] -= K[i][a] * C[symIndex(3 + a, j)];
+        }
+      V KV[5][D];
+      for (unsigned int i = 0; i < 5; ++i)
+        for (unsigned int a = 0; a < D; ++a) {
+          KV[i][a] = K[i][0] * Vm[symIndex(0, a)];
+          for (unsigned int b = 1; b < D; ++b)
+            KV[i][a] += K[i][b] * Vm[symIndex(b, a)];
+        }
+      for (unsigned int i = 0; i < 5; ++i)
+        for (unsigned int j = 0; j <= i; ++j) {
+          V e = MC[i][j];
+          for (unsigned int a = 0; a < D; ++a)
+            e += (KV[i][a] - MC[i][3 + a]) * K[j][a];
+          store(&s.c[symIndex(i, j)][k], e);
+        }
+    }
+  }
+
+  template <unsigned int D, bool Update, int W = defaultWidth, typename T>
+  void run(SoA<D, T>& s) {
+    unsigned int const n = s.size();
+    unsigned int k = 0;
+    if constexpr (W > 1) {
+      for (; k + W <= n; k += W)
+        kernel<D, Update, typename Lanes<T, W>::type>(s, k);
+    }
+    for (; k < n; ++k)
+      kernel<D, Update, T>(s, k);
+  }
+
+  /// chi2 of all pairs
+  template <unsigned int D, int W = defaultWidth, typename T>
+  void estimate(SoA<D, T>& s) {
+    run<D, false, W>(s);
+  }
+
+  /// chi2 and filtered state of all pairs, replacing the predicted state
+  template <unsigned int D, int W = defaultWidth, typename T>
+  void update(SoA<D, T>& s) {
+    run<D, true, W>(s);
+  }
+}  // namespace kfbatch
+
+template <unsigned int D>
+class KFBatchUpdator {
+public:
+  void clear() {
+    states_.clear();
+    data_.resize(0);
+    updated_ = false;
+  }
+  void reserve(unsigned int n) {
+    states_.reserve(n);
+    data_.reserve(n);
+  }
+
+  /// Adds a pair, returns false and adds nothing if the hit does not measure the local position
+  bool push_back(const TrajectoryStateOnSurface& tsos, const TrackingRecHit& hit);
+
+  unsigned int size() const { return states_.size(); }
+
+  template <int W = kfbatch::defaultWidth>
+  void estimate() {
+    kfbatch::estimate<D, W>(data_);
+  }
+  template <int W = kfbatch::defaultWidth>
+  void update() {
+    kfbatch::update<D, W>(data_);
+    updated_ = true;
+  }
+
+  /// false if the covariance of the residual could not be inverted
+  bool valid(unsigned int i) const { return data_.det[i] > 0 and data_.chi2[i] >= 0; }
+  double chi2(unsigned int i) const { return data_.chi2[i]; }
+  /// Only after update(). Invalid if !valid(i).
+  TrajectoryStateOnSurface updatedState(unsigned int i) const;
+
+  kfbatch::SoA<D, double> const& data() const { return data_; }
+
+private:
+  std::vector<TrajectoryStateOnSurface> states_;
+  kfbatch::SoA<D, double> data_;
+  bool updated_ = false;
+};
+
+extern template class KFBatchUpdator<1>;
+extern template class KFBatchUpdator<2>;
+
+#endif
@@ -0,0 +1,71 @@
+#include "TrackingTools/KalmanUpdators/interface/KFBatchUpdator.h"
+#include "DataFormats/TrackingRecHit/interface/KfComponentsHolder.h"
+#include "DataFormats/TrackingRecHit/interface/TrackingRecHit.h"
+#include "DataFormats/GeometrySurface/interface/Plane.h"
+
+#include <cassert>
+
+template <unsigned int D>
+bool KFBatchUpdator<D>::push_back(const TrajectoryStateOnSurface& tsos, const TrackingRecHit& hit) {
+  if (hit.dimension() != int(D)) {
+    return false;
+  }
+  typedef typename AlgebraicROOTObject<D, D>::SymMatrix SMatDD;
+  typedef typename AlgebraicROOTObject<D>::Vector VecD;
+  using ROOT::Math::SMatrixNoInit;
+
+  auto&& x = tsos.localParameters().vector();
+  auto&& C = tsos.localError().matrix();
+
+  VecD r, rMeas;
+  SMatDD V(SMatrixNoInit{}), VMeas(SMatrixNoInit{});
+  ProjectMatrix<double, 5, D> pf;
+  KfComponentsHolder holder;
+  holder.template setup<D>(&r, &V, &pf, &rMeas, &VMeas, x, C);
+  hit.getKfComponents(holder);
+
+  // the kernels assume H projects on the local position
+  for (unsigned int a = 0; a < D; ++a) {
+    if (pf.index[a] != 3 + a) {
+      return false;
+    }
+  }
+
+  unsigned int const k = states_.size();
+  states_.push_back(tsos);
+  data_.resize(k + 1);
+  for (unsigned int i = 0; i < 5; ++i)
+    data_.x[i][k] = x[i];
+  auto c = C.Array();
+  for (unsigned int i = 0; i < 15; ++i)
+    data_.c[i][k] = c[i];
+  for (unsigned int a = 0; a < D; ++a)
+    data_.m[a][k] = r[a];
+  auto v = V.Array();
+  for (unsigned int i = 0; i < kfbatch::SoA<D>::nMeasErr; ++i)
+    data_.v[i][k] = v[i];
+  return true;
+}
+
+template <unsigned int D>
+TrajectoryStateOnSurface KFBatchUpdator<D>::updatedState(unsigned int i) const {
+  assert(updated_);
+  if (not valid(i)) {
+    return TrajectoryStateOnSurface();
+  }
+  auto const& tsos = states_[i];
+  AlgebraicVector5 x;
+  for (unsigned int j = 0; j < 5; ++j)
+    x[j] = data_.x[j][i];
+  AlgebraicSymMatrix55 C(ROOT::Math::SMatrixNoInit{});
+  for (unsigned int j = 0; j < 15; ++j)
+    C.Array()[j] = data_.c[j][i];
+  return TrajectoryStateOnSurface(LocalTrajectoryParameters(x, tsos.localParameters().pzSign()),
+                                  LocalTrajectoryError(C),
+                                  tsos.surface(),
+                                  &(tsos.globalParameters().magneticField()),
+                                  tsos.surfaceSide());
+}
+
+template class KFBatchUpdator<1>;
+template class KFBatchUpdator<2>;
@@ -1,5 +1,6 @@
 #include "TrackingTools/KalmanUpdators/interface/KFUpdator.h"
 #include "TrackingTools/KalmanUpdators/interface/Chi2MeasurementEstimator.h"
+#include "TrackingTools/KalmanUpdators/interface/KFBatchUpdator.h"
 
 #include "TrackingTools/TrajectoryState/interface/TrajectoryStateOnSurface.h"
 #include "DataFormats/GeometrySurface/interface/Surface.h"
@@ -84,6 +85,9 @@ void print(TrajectoryStateOnSurface const& ts) {
 #include "FWCore/Utilities/interface/HRRealTime.h"
 #include <iostream>
 #include <vector>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
 
 bool isAligned(const void* data, long alignment) {
   // check that the alignment is a power of two
@@ -213,5 +217,39 @@ int main() {
   chi2.time(ts, *thit);
   chi2.time(ts2, *thit);
 
+  std::cout << "\n** Batch ** \n" << std::endl;
+
+  // the batched update must agree with KFUpdator and Chi2MeasurementEstimator
+  KFUpdator kfu;
+  Chi2MeasurementEstimator est(10.);
+  auto close = [](double a, double b) { return std::abs(a - b) <= 1.e-9 * std::max(1., std::abs(a)); };
+  auto check = [&](auto& batch,
+                   std::vector<std::pair<TrajectoryStateOnSurface const*, TrackingRecHit const*>> const& pairs) {
+    batch.clear();
+    for (auto const& p : pairs) {
+      bool added = batch.push_back(*p.first, *p.second);
+      assert(added);
+    }
+    batch.template update<>();
+    for (unsigned int i = 0; i < pairs.size(); ++i) {
+      auto expectedChi2 = est.estimate(*pairs[i].first, *pairs[i].second).second;
+      auto expected = kfu.update(*pairs[i].first, *pairs[i].second);
+      auto updated = batch.updatedState(i);
+      std::cout << "chi2 " << batch.chi2(i) << " " << expectedChi2 << std::endl;
+      assert(batch.valid(i));
+      assert(close(batch.chi2(i), expectedChi2));
+      for (unsigned int j = 0; j < 5; ++j)
+        assert(close(updated.localParameters().vector()[j], expected.localParameters().vector()[j]));
+      for (unsigned int j = 0; j < 15; ++j)
+        assert(close(updated.localError().matrix().Array()[j], expected.localError().matrix().Array()[j]));
+    }
+  };
+  KFBatchUpdator<2> batch2;
+  check(batch2, {{&ts, &hitpx}, {&ts2, &hitpx}, {&ts, &hit2d}, {&ts2, &hit2d}, {&ts, &hitpj}, {&ts2, thit}});
+  KFBatchUpdator<1> batch1;
+  check(batch1, {{&ts, &hit1d}, {&ts2, &hit1d}, {&ts, &hit1d}});
+  // hits of another dimension are refused
+  assert(!batch1.push_back(ts, hitpx));
+
   return 0;
 }
@@ -15,7 +15,7 @@ public:
       : BasicTrajectoryState(std::forward<Args>(args)...) { /* assert(weight()>0);*/
   }
 
-  pointer clone() const override { return build<BasicSingleTrajectoryState>(*this); }
+  pointer clone() const override { return churn<BasicSingleTrajectoryState>(*this); }
 
   using Components = BasicTrajectoryState::Components;
 
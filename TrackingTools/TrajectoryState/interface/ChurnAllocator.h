@@ -1,7 +1,42 @@
 #ifndef Tracker_ChurnAllocator_H
 #define Tracker_ChurnAllocator_H
+#include <atomic>
 #include <memory>
 
+/** Allocator for objects that are created and destroyed at a high rate,
+ *  such as the trajectory states.
+ *  Single objects released by a thread are kept in a free list of that thread
+ *  (one per allocated type) and handed out again by the next allocations on
+ *  the same thread, so that in steady state no call to the heap is done.
+ *  An object can be released by another thread than the one that allocated it:
+ *  it then just moves to the free list of the releasing thread.
+ *  At most maxPooled objects per type are kept by each thread.
+ */
+
+namespace tsosChurn {
+  // totals of the whole process, not of a stream or of an event
+  struct ProcessCounters {
+    unsigned long long allocated = 0;  // objects handed out
+    unsigned long long recycled = 0;   // of which taken from a free list
+  };
+
+  namespace detail {
+    // only written by the owning thread, read by processCounters()
+    struct ThreadCounters {
+      std::atomic<unsigned long long> allocated{0};
+      std::atomic<unsigned long long> recycled{0};
+    };
+    ThreadCounters &threadCounters();
+
+    inline void increment(std::atomic<unsigned long long> &c) {
+      c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+  }  // namespace detail
+
+  /// sum over all the threads of the process since the start of the job
+  ProcessCounters processCounters();
+}  // namespace tsosChurn
+
 template <typename T>
 class churn_allocator : public std::allocator<T> {
 public:
@@ -9,13 +44,22 @@ public:
   using pointer = typename Base::pointer;
   using size_type = typename Base::size_type;
 
-  struct Cache {
-    pointer cache = nullptr;
-    bool gard = false;
+  static constexpr unsigned int maxPooled = 4096;
+
+  struct Node {
+    Node *next;
+  };
+  static_assert(sizeof(T) >= sizeof(Node), "churn_allocator cannot pool objects smaller than a pointer");
+
+  // trivially destructible so that it can still be used while other thread_local objects are destroyed
+  struct Pool {
+    Node *head = nullptr;
+    unsigned int size = 0;
+    bool closed = false;
   };
 
-  static Cache &cache() {
-    static thread_local Cache local;
+  static Pool &pool() {
+    static thread_local Pool local;
     return local;
   }
 
@@ -25,19 +69,29 @@ public:
   };
 
   pointer allocate(size_type n, const void *hint = nullptr) {
-    Cache &c = cache();
-    if (!c.gard)
-      c.cache = std::allocator<T>::allocate(n, hint);
-    c.gard = false;
-    return c.cache;
+    static thread_local tsosChurn::detail::ThreadCounters &counters = tsosChurn::detail::threadCounters();
+    tsosChurn::detail::increment(counters.allocated);
+    Pool &p = pool();
+    if (n == 1 && p.head) {
+      tsosChurn::detail::increment(counters.recycled);
+      Node *node = p.head;
+      p.head = node->next;
+      --p.size;
+      return reinterpret_cast<pointer>(node);
+    }
+    return Base::allocate(n, hint);
   }
 
-  void deallocate(pointer p, size_type n) {
-    Cache &c = cache();
-    if (p == c.cache)
-      c.gard = true;
-    else
-      std::allocator<T>::deallocate(p, n);
+  void deallocate(pointer ptr, size_type n) {
+    Pool &p = pool();
+    if (n == 1 && !p.closed && p.size < maxPooled) {
+      static thread_local Drain drain;
+      Node *node = reinterpret_cast<Node *>(ptr);
+      node->next = p.head;
+      p.head = node;
+      ++p.size;
+    } else
+      Base::deallocate(ptr, n);
   }
 
   churn_allocator() = default;
@@ -46,6 +100,21 @@ public:
 
   template <class U>
   churn_allocator(const churn_allocator<U> &a) noexcept : std::allocator<T>(a) {}
+
+private:
+  // gives the free list back to the heap when the thread ends
+  struct Drain {
+    ~Drain() {
+      Pool &p = pool();
+      p.closed = true;
+      while (p.head) {
+        Node *node = p.head;
+        p.head = node->next;
+        Base().deallocate(reinterpret_cast<pointer>(node), 1);
+      }
+      p.size = 0;
+    }
+  };
 };
 
 #endif
@@ -0,0 +1,101 @@
+// -*- C++ -*-
+//
+// Package: TrackingTools/TrajectoryState
+// Class  : TrajectoryStateAllocationMonitor
+//
+// Implementation:
+//     Reports the number of trajectory states allocated through
+//     churn_allocator by the whole process while each event was processed,
+//     and how many of them reused the memory of a state released earlier on
+//     the same thread.
+//     The counters are process totals, not per stream: with more than one
+//     stream, the count of an event includes the states allocated by the
+//     events processed concurrently on the other streams.
+//
+
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+#include "FWCore/ServiceRegistry/interface/ServiceMaker.h"
+#include "FWCore/ServiceRegistry/interface/StreamContext.h"
+#include "FWCore/ServiceRegistry/interface/SystemBounds.h"
+#include "TrackingTools/TrajectoryState/interface/ChurnAllocator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+class TrajectoryStateAllocationMonitor {
+public:
+  TrajectoryStateAllocationMonitor(edm::ParameterSet const&, edm::ActivityRegistry&);
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  void preallocate(edm::service::SystemBounds const& bounds) { streamStart_.resize(bounds.maxNumberOfStreams()); }
+  void preEvent(edm::StreamContext const& sc) { streamStart_[sc.streamID().value()] = tsosChurn::processCounters(); }
+  void postEvent(edm::StreamContext const&);
+  void postEndJob();
+
+  bool const printEachEvent_;
+  // only accessed by the stream itself
+  std::vector<tsosChurn::ProcessCounters> streamStart_;
+  std::atomic<unsigned long long> events_{0};
+  std::atomic<unsigned long long> maxDuringEvent_{0};
+  tsosChurn::ProcessCounters jobStart_;
+};
+
+TrajectoryStateAllocationMonitor::TrajectoryStateAllocationMonitor(edm::ParameterSet const& iPS,
+                                                                   edm::ActivityRegistry& iRegistry)
+    : printEachEvent_(iPS.getUntrackedParameter<bool>("printEachEvent")) {
+  iRegistry.watchPreallocate(this, &TrajectoryStateAllocationMonitor::preallocate);
+  iRegistry.watchPreBeginJob([this](auto const&, auto const&) { jobStart_ = tsosChurn::processCounters(); });
+  iRegistry.watchPreEvent(this, &TrajectoryStateAllocationMonitor::preEvent);
+  iRegistry.watchPostEvent(this, &TrajectoryStateAllocationMonitor::postEvent);
+  iRegistry.watchPostEndJob(this, &TrajectoryStateAllocationMonitor::postEndJob);
+}
+
+void TrajectoryStateAllocationMonitor::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.addUntracked<bool>("printEachEvent", false)
+      ->setComment(
+          "Print the number of trajectory states allocated by the process during each event, otherwise only at end "
+          "of job.");
+  descriptions.add("TrajectoryStateAllocationMonitor", desc);
+  descriptions.setComment(
+      "This service counts the trajectory states allocated by the tracking in each event, and how many of them "
+      "were served from the per-thread pools of recycled states instead of the heap.\n"
+      "The counters are process totals: with more than one stream the numbers given for an event include the "
+      "events processed concurrently.");
+}
+
+void TrajectoryStateAllocationMonitor::postEvent(edm::StreamContext const& sc) {
+  auto const now = tsosChurn::processCounters();
+  auto const& start = streamStart_[sc.streamID().value()];
+  auto const allocated = now.allocated - start.allocated;
+  ++events_;
+  auto max = maxDuringEvent_.load();
+  while (allocated > max and not maxDuringEvent_.compare_exchange_weak(max, allocated)) {
+  }
+  if (printEachEvent_) {
+    edm::LogVerbatim("TrajectoryStateAllocationMonitor")
+        << "TrajectoryStateAllocationMonitor> " << sc.eventID() << ": " << allocated
+        << " states allocated by the process during the event, " << (now.recycled - start.recycled) << " recycled";
+  }
+}
+
+void TrajectoryStateAllocationMonitor::postEndJob() {
+  auto const now = tsosChurn::processCounters();
+  auto const allocated = now.allocated - jobStart_.allocated;
+  auto const recycled = now.recycled - jobStart_.recycled;
+  auto const events = std::max(events_.load(), 1ULL);
+  edm::LogVerbatim("TrajectoryStateAllocationMonitor")
+      << "TrajectoryStateAllocationMonitor> " << allocated << " trajectory states allocated in " << events_.load()
+      << " events, " << allocated / events << " per event on average, at most " << maxDuringEvent_.load()
+      << " by the process during one event; " << (allocated > 0 ? 100. * recycled / allocated : 0.)
+      << "% reused recycled memory";
+}
+
+DEFINE_FWK_SERVICE(TrajectoryStateAllocationMonitor);
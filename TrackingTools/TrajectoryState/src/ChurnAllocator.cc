@@ -0,0 +1,42 @@
+#include "TrackingTools/TrajectoryState/interface/ChurnAllocator.h"
+
+#include <deque>
+#include <mutex>
+
+namespace {
+  // the counters of every thread that ever allocated, kept after the thread ends
+  struct Registry {
+    std::mutex mutex;
+    std::deque<tsosChurn::detail::ThreadCounters> counters;
+  };
+
+  Registry& registry() {
+    static Registry r;
+    return r;
+  }
+}  // namespace
+
+namespace tsosChurn {
+  namespace detail {
+    ThreadCounters& threadCounters() {
+      thread_local ThreadCounters* local = nullptr;
+      if (local == nullptr) {
+        auto& r = registry();
+        std::lock_guard<std::mutex> guard(r.mutex);
+        local = &r.counters.emplace_back();
+      }
+      return *local;
+    }
+  }  // namespace detail
+
+  ProcessCounters processCounters() {
+    ProcessCounters total;
+    auto& r = registry();
+    std::lock_guard<std::mutex> guard(r.mutex);
+    for (auto const& c : r.counters) {
+      total.allocated += c.allocated.load(std::memory_order_relaxed);
+      total.recycled += c.recycled.load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+}  // namespace tsosChurn
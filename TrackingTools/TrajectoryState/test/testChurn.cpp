@@ -1,5 +1,6 @@
 #include "TrackingTools/TrajectoryState/interface/ChurnAllocator.h"
 
+#include <cassert>
 #include <iostream>
 
 struct A {
@@ -34,6 +35,12 @@ int main(int k, const char **) {
     c.reset();
   }
 
+  // the states released above have been reused
+  auto counters = tsosChurn::processCounters();
+  std::cout << "allocated " << counters.allocated << " recycled " << counters.recycled << std::endl;
+  assert(counters.allocated == (k < 3 ? 6 : 4));
+  assert(counters.recycled == (k < 3 ? 2 : 0));
+
   std::cout << "end " << std::endl;
 
   return 0;